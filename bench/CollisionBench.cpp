@@ -0,0 +1,218 @@
+// ----------------------------------------------------------------
+// Tile collision benchmark: packed collision bitset vs. the old layer scan
+// ----------------------------------------------------------------
+
+#include "Map/TileMap.hpp"
+#include "Map/CollisionGrid.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// A layer as TileMap used to keep it: every gid of the map
+struct DenseLayer
+{
+    std::string name;
+    int width;
+    int height;
+    std::vector<uint32_t> data;
+};
+
+// What TileMap::CheckCollision did before the collision bitset
+static bool CheckCollisionLegacy(const std::vector<DenseLayer>& layers, int mapWidth, int mapHeight,
+                                 int tileSize, const Vector2& position, float radius)
+{
+    Vector2 corners[4] = {
+        Vector2(position.x - radius, position.y - radius),
+        Vector2(position.x + radius, position.y - radius),
+        Vector2(position.x - radius, position.y + radius),
+        Vector2(position.x + radius, position.y + radius)
+    };
+
+    for (const auto& corner : corners)
+    {
+        int tileX = static_cast<int>(corner.x) / tileSize;
+        int tileY = static_cast<int>(corner.y) / tileSize;
+
+        if (tileX < 0 || tileX >= mapWidth || tileY < 0 || tileY >= mapHeight)
+            return true;
+
+        for (const auto& layer : layers)
+        {
+            if (layer.data.empty()) continue;
+
+            int index = tileY * layer.width + tileX;
+            if (index < 0 || index >= static_cast<int>(layer.data.size())) continue;
+
+            uint32_t gid = layer.data[index];
+            if (gid == 0) continue;
+
+            if (layer.name == "collision")
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Same layer mix as the island map: ground, decoration, collision on top
+static std::vector<DenseLayer> CreateLayers(int width, int height, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    std::vector<DenseLayer> layers;
+    const char* names[] = {"ground", "decoration", "collision"};
+    const int fill[] = {100, 30, 15};
+    for (int l = 0; l < 3; l++)
+    {
+        DenseLayer layer;
+        layer.name = names[l];
+        layer.width = width;
+        layer.height = height;
+        layer.data.resize(static_cast<size_t>(width) * height);
+        for (uint32_t& gid : layer.data)
+        {
+            gid = percent(rng) < fill[l] ? 1 + percent(rng) : 0;
+        }
+        layers.push_back(std::move(layer));
+    }
+    return layers;
+}
+
+// The map as TileMap loads it (only the gameplay layers are kept)
+static MapData CreateMapData(const std::vector<DenseLayer>& layers, int width, int height)
+{
+    MapData mapData{};
+    mapData.mapWidth = width;
+    mapData.mapHeight = height;
+    mapData.tileWidth = 16;
+    mapData.tileHeight = 16;
+    for (const DenseLayer& dense : layers)
+    {
+        if (dense.name != "collision") continue;
+
+        Layer layer;
+        layer.name = dense.name;
+        layer.width = width;
+        layer.height = height;
+        layer.AddTiles(0, 0, dense.width, dense.height, dense.data);
+        mapData.layers.push_back(std::move(layer));
+    }
+    return mapData;
+}
+
+// Sweeps that report no hit must end clear of every solid tile; returns the
+// number of sweeps that passed through one
+static int CheckSweeps(const CollisionGrid& grid, float tileSize, int sweeps, unsigned int seed)
+{
+    int failures = 0;
+
+    // A diagonal move that crosses a row and a column at the same instant
+    // reaches the tile between them only through the box's corner
+    CollisionGrid corner;
+    corner.Reset(10, 10);
+    corner.SetSolid(5, 5, true);
+    SweepHit hit;
+    if (!corner.SweepBox(Vector2(3.0f, 3.0f), Vector2(4.0f, 4.0f), Vector2(2.0f, 2.0f), 1.0f, hit))
+    {
+        std::printf("[collision] sweep passed through the corner of tile (5, 5)\n");
+        failures++;
+    }
+
+    // Random sweeps on grid-aligned boxes and motions, where ties are common
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> tile(1, grid.GetWidth() - 2);
+    std::uniform_int_distribution<int> step(-8, 8);
+    const float skin = 0.001f;  // OverlapsBox includes the max edge, the sweep does not
+    for (int i = 0; i < sweeps; i++)
+    {
+        Vector2 min(tile(rng) * tileSize, tile(rng) * tileSize);
+        Vector2 max = min + Vector2(tileSize * 0.5f, tileSize * 0.5f) * static_cast<float>(1 + i % 4);
+        Vector2 delta(step(rng) * tileSize * 0.25f, step(rng) * tileSize * 0.25f);
+        Vector2 skinSize(skin, skin);
+        if (grid.OverlapsBox(min, max - skinSize, tileSize)) continue;
+
+        if (!grid.SweepBox(min, max, delta, tileSize, hit) &&
+            grid.OverlapsBox(min + delta, max + delta - skinSize, tileSize))
+        {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+template <typename Check>
+static double Run(const std::vector<Vector2>& queries, int passes, Check check, int& hits)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        for (const Vector2& position : queries)
+        {
+            hits += check(position) ? 1 : 0;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double checks = static_cast<double>(queries.size()) * passes;
+    return std::chrono::duration<double, std::nano>(end - start).count() / checks;
+}
+
+int main(int argc, char** argv)
+{
+    int mapSize = argc > 1 ? std::atoi(argv[1]) : 256;
+    int passes = argc > 2 ? std::atoi(argv[2]) : 50;
+    const int tileSize = 40;
+    const float radius = 16.0f;  // Movement collider
+
+    std::vector<DenseLayer> layers = CreateLayers(mapSize, mapSize, 1234);
+    MapData mapData = CreateMapData(layers, mapSize, mapSize);
+    CollisionGrid grid;
+    grid.Build(mapData);
+
+    // Positions inside the map (two tests per moving actor per step)
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> coord(radius, mapSize * tileSize - radius);
+    std::vector<Vector2> queries(100000);
+    for (Vector2& q : queries)
+    {
+        q = Vector2(coord(rng), coord(rng));
+    }
+
+    auto legacy = [&](const Vector2& p) { return CheckCollisionLegacy(layers, mapSize, mapSize, tileSize, p, radius); };
+    auto packed = [&](const Vector2& p) {
+        return grid.OverlapsBox(Vector2(p.x - radius, p.y - radius), Vector2(p.x + radius, p.y + radius),
+                                static_cast<float>(tileSize));
+    };
+
+    // The collider is smaller than a tile, so both must agree on every query
+    int mismatches = 0;
+    for (const Vector2& q : queries)
+    {
+        mismatches += legacy(q) != packed(q) ? 1 : 0;
+    }
+
+    int sweepFailures = CheckSweeps(grid, static_cast<float>(tileSize), 100000, 7);
+
+    int legacyHits = 0;
+    int packedHits = 0;
+    Run(queries, 1, legacy, legacyHits);
+    Run(queries, 1, packed, packedHits);
+    legacyHits = packedHits = 0;
+
+    double legacyNs = Run(queries, passes, legacy, legacyHits);
+    double packedNs = Run(queries, passes, packed, packedHits);
+
+    std::printf("[collision] map=%dx%d queries=%zu passes=%d mismatches=%d\n",
+                mapSize, mapSize, queries.size(), passes, mismatches);
+    std::printf("[collision] sweeps through solid tiles: %d\n", sweepFailures);
+    std::printf("[collision] layer scan:       %.2f ns/check\n", legacyNs);
+    std::printf("[collision] packed bitset:    %.2f ns/check\n", packedNs);
+    std::printf("[collision] speedup=%.1fx (hits %d / %d)\n", legacyNs / packedNs, legacyHits, packedHits);
+    return mismatches == 0 && sweepFailures == 0 ? 0 : 1;
+}
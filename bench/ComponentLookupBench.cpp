@@ -0,0 +1,110 @@
+// ----------------------------------------------------------------
+// Component lookup benchmark: type-ID table vs. the old dynamic_cast scan
+// ----------------------------------------------------------------
+
+#include "Game/Game.hpp"
+#include "Actor/Actor.hpp"
+#include "Component/AnimationComponent.hpp"
+#include "Component/AttackComponent.hpp"
+#include "Component/HealthComponent.hpp"
+#include "Component/MovementComponent.hpp"
+#include "Component/SpriteComponent.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// What Actor::GetComponent did before component type IDs
+template <typename T>
+static T* GetComponentLegacy(const Actor* actor)
+{
+    for (auto& comp : actor->GetComponents())
+    {
+        T* t = dynamic_cast<T*>(comp.get());
+        if (t)
+        {
+            return t;
+        }
+    }
+    return nullptr;
+}
+
+// Same mix as the game: items have no components, NPCs have four or five
+static std::vector<std::unique_ptr<Actor>> CreateActors(Game* game, int count)
+{
+    std::vector<std::unique_ptr<Actor>> actors;
+    actors.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        auto actor = std::make_unique<Actor>(game);
+        if (i % 4 != 0)
+        {
+            actor->AddComponent<AnimationComponent>();
+            actor->AddComponent<SpriteComponent>(200);
+            actor->AddComponent<MovementComponent>();
+            actor->AddComponent<HealthComponent>();
+            if (i % 3 == 0)
+            {
+                actor->AddComponent<AttackComponent>();
+            }
+        }
+        actors.emplace_back(std::move(actor));
+    }
+    return actors;
+}
+
+// Mirrors AttackComponent: filter by health, then fetch health and movement
+template <typename Lookup>
+static double Run(const std::vector<std::unique_ptr<Actor>>& actors, int passes, Lookup lookup, float& sink)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        for (const auto& actor : actors)
+        {
+            sink += lookup(actor.get());
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double lookups = static_cast<double>(actors.size()) * passes;
+    return std::chrono::duration<double, std::nano>(end - start).count() / lookups;
+}
+
+int main(int argc, char** argv)
+{
+    int actorCount = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int passes = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    // Uninitialized headless game: only provides the component pools
+    Game game(nullptr, nullptr);
+    auto actors = CreateActors(&game, actorCount);
+    float sink = 0.0f;
+
+    auto legacy = [](const Actor* actor) {
+        HealthComponent* health = GetComponentLegacy<HealthComponent>(actor);
+        if (!health) return 0.0f;
+        MovementComponent* movement = GetComponentLegacy<MovementComponent>(actor);
+        return health->GetCurrentHealth() + (movement ? 1.0f : 0.0f);
+    };
+    auto typed = [](const Actor* actor) {
+        if (!actor->HasComponent<HealthComponent>()) return 0.0f;
+        HealthComponent* health = actor->GetComponent<HealthComponent>();
+        MovementComponent* movement = actor->GetComponent<MovementComponent>();
+        return health->GetCurrentHealth() + (movement ? 1.0f : 0.0f);
+    };
+
+    // Warm up caches and branch predictors once
+    Run(actors, 1, legacy, sink);
+    Run(actors, 1, typed, sink);
+
+    double legacyNs = Run(actors, passes, legacy, sink);
+    double typedNs = Run(actors, passes, typed, sink);
+
+    std::printf("[component-lookup] actors=%d passes=%d\n", actorCount, passes);
+    std::printf("[component-lookup] dynamic_cast scan: %.2f ns/actor\n", legacyNs);
+    std::printf("[component-lookup] type-id table:     %.2f ns/actor\n", typedNs);
+    std::printf("[component-lookup] speedup=%.1fx (checksum %.0f)\n", legacyNs / typedNs, sink);
+    return 0;
+}
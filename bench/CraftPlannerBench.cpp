@@ -0,0 +1,131 @@
+// ----------------------------------------------------------------
+// Craft planner benchmark: combination plans toward deep items
+// of a large layered recipe graph, cold and resumed, per worker count
+// ----------------------------------------------------------------
+
+#include "Crafting/CraftPlanner.hpp"
+#include "Core/Jobs/JobSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+static const int BASE_ITEMS = 4;
+
+// Layers of items, each made from one item of the layer below and (mostly)
+// a base item, as discovery trees tend to be; the rest of the recipes are
+// random shortcuts and dead ends between any two items
+static void BuildGraph(Crafting& crafting, int itemCount, int layerCount, int recipeCount, std::mt19937& rng)
+{
+    for (int i = 0; i < itemCount; i++)
+    {
+        crafting.AddItem(Item(i, "Item " + std::to_string(i)));
+    }
+
+    int width = itemCount / layerCount;
+    for (int i = BASE_ITEMS; i < itemCount; i++)
+    {
+        int layer = i / width;
+        int first = layer == 0 ? static_cast<int>(rng() % i)
+                               : std::max((layer - 1) * width + static_cast<int>(rng() % width), BASE_ITEMS);
+        int second = (layer < 2 || rng() % 10 < 7) ? static_cast<int>(rng() % BASE_ITEMS)
+                                                    : static_cast<int>(rng() % (layer - 1)) * width + static_cast<int>(rng() % width);
+        // A taken pair would replace another item's only recipe
+        if (crafting.FindRecipe(first, second) != RecipeTable::NO_RESULT)
+        {
+            i--;
+            continue;
+        }
+        crafting.RegisterRecipe(first, second, i);
+    }
+
+    while (static_cast<int>(crafting.GetRecipeCount()) < recipeCount)
+    {
+        int first = static_cast<int>(rng() % itemCount), second = static_cast<int>(rng() % itemCount);
+        if (crafting.FindRecipe(first, second) != RecipeTable::NO_RESULT) continue;
+        crafting.RegisterRecipe(first, second, static_cast<int>(rng() % itemCount));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // "craft_planner_bench [items] [recipes] [layers]"
+    int itemCount = argc > 1 ? std::atoi(argv[1]) : 60000;
+    int recipeCount = argc > 2 ? std::atoi(argv[2]) : 100000;
+    int layerCount = argc > 3 ? std::atoi(argv[3]) : 12;
+
+    std::mt19937 rng(42);
+    Crafting crafting;
+    BuildGraph(crafting, itemCount, layerCount, recipeCount, rng);
+
+    std::vector<int> held;
+    for (int i = 0; i < BASE_ITEMS; i++)
+    {
+        held.push_back(i);
+    }
+    // Targets spread over every layer, deepest first
+    std::vector<int> targets;
+    for (int target = itemCount - 1; target >= BASE_ITEMS; target -= itemCount / 40)
+    {
+        targets.push_back(target);
+    }
+
+    std::printf("[planner] items=%d recipes=%zu layers=%d targets=%zu\n", itemCount, crafting.GetRecipeCount(),
+                layerCount, targets.size());
+
+    size_t firstSignature = 0;
+    bool deterministic = true;
+    for (int workers : {0, 1, 3, -1})
+    {
+        JobSystem jobs(workers);
+
+        // Cold: a fresh search per target
+        double coldTotal = 0.0, coldWorst = 0.0;
+        int found = 0, maxDepth = 0;
+        size_t signature = 0;
+        for (int target : targets)
+        {
+            CraftPlanner planner;
+            planner.SetJobSystem(&jobs);
+            planner.Sync(crafting);
+
+            CraftPlanner::Plan plan;
+            auto start = std::chrono::steady_clock::now();
+            bool ok = planner.FindPlan(held, target, plan, 256);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            coldTotal += ms;
+            coldWorst = std::max(coldWorst, ms);
+            if (!ok) continue;
+
+            found++;
+            maxDepth = std::max(maxDepth, plan.depth);
+            for (const CraftPlanner::Step& step : plan.steps)
+            {
+                signature = signature * 31 + static_cast<size_t>(step.resultId) * 7 + static_cast<size_t>(step.item1Id);
+            }
+        }
+
+        // Resumed: every target against one search with the same inventory
+        CraftPlanner planner;
+        planner.SetJobSystem(&jobs);
+        planner.Sync(crafting);
+        CraftPlanner::Plan plan;
+        auto start = std::chrono::steady_clock::now();
+        for (int target : targets)
+        {
+            planner.FindPlan(held, target, plan, 256);
+        }
+        double resumedTotal = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (firstSignature == 0) firstSignature = signature;
+        deterministic = deterministic && signature == firstSignature;
+        std::printf("[planner]   workers=%-2d found %d/%zu max depth %d: cold %.2f ms avg (worst %.2f), all targets resumed %.2f ms\n",
+                    jobs.GetWorkerCount(), found, targets.size(), maxDepth, coldTotal / targets.size(), coldWorst,
+                    resumedTotal);
+    }
+    std::printf("[planner] plans %s across worker counts\n", deterministic ? "identical" : "DIFFER");
+    return deterministic ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+// ----------------------------------------------------------------
+// Craft suggestion benchmark: craftable pairs and one-step-away items
+// among a held inventory, against a large random recipe graph
+// ----------------------------------------------------------------
+
+#include "Crafting/CraftSuggestions.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Pairs among held items by asking the recipe table about every pair
+static size_t CountPairsNaive(const Crafting& crafting, const std::vector<CraftSuggestions::HeldItem>& held)
+{
+    size_t found = 0;
+    for (size_t i = 0; i < held.size(); i++)
+    {
+        for (size_t j = i; j < held.size(); j++)
+        {
+            if (i == j && held[i].quantity < 2) continue;
+            found += crafting.FindRecipe(held[i].id, held[j].id) != RecipeTable::NO_RESULT ? 1 : 0;
+        }
+    }
+    return found;
+}
+
+template <typename Query>
+static double MicrosecondsPerQuery(int repetitions, Query query)
+{
+    query();  // Warm the row cache
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++)
+    {
+        query();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / repetitions;
+}
+
+int main(int argc, char** argv)
+{
+    // "craft_suggestions_bench [items] [recipes per item] [held items]"
+    int itemCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int recipesPerItem = argc > 2 ? std::atoi(argv[2]) : 4;
+    int heldCount = argc > 3 ? std::atoi(argv[3]) : 20;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> id(0, itemCount - 1);
+
+    Crafting crafting;
+    for (int i = 0; i < itemCount; i++)
+    {
+        crafting.AddItem(Item(i, "Item " + std::to_string(i)));
+    }
+    for (long long r = 0; r < static_cast<long long>(itemCount) * recipesPerItem; r++)
+    {
+        crafting.RegisterRecipe(id(rng), id(rng), id(rng));
+    }
+
+    CraftSuggestions suggestions;
+    auto syncStart = std::chrono::steady_clock::now();
+    suggestions.Sync(crafting);
+    auto syncEnd = std::chrono::steady_clock::now();
+
+    // A held set that is guaranteed some pairs: half random, half partners of the first
+    std::vector<CraftSuggestions::HeldItem> held;
+    std::vector<CraftSuggestions::Pair> scratch;
+    held.push_back(CraftSuggestions::HeldItem{id(rng), 1});
+    suggestions.FindOneStepAway(held, scratch, heldCount / 2);
+    for (const auto& pair : scratch)
+    {
+        held.push_back(CraftSuggestions::HeldItem{pair.item2Id, 1});
+    }
+    while (static_cast<int>(held.size()) < heldCount)
+    {
+        held.push_back(CraftSuggestions::HeldItem{id(rng), 1});
+    }
+
+    const int repetitions = 2000;
+    size_t pairCount = 0, oneStepCount = 0, naiveCount = 0;
+    std::vector<CraftSuggestions::Pair> pairs;
+    double pairsUs = MicrosecondsPerQuery(repetitions, [&]() {
+        pairs.clear();
+        pairCount = suggestions.FindCraftablePairs(held, pairs);
+    });
+    double oneStepUs = MicrosecondsPerQuery(repetitions, [&]() {
+        pairs.clear();
+        oneStepCount = suggestions.FindOneStepAway(held, pairs, 64);
+    });
+    double naiveUs = MicrosecondsPerQuery(repetitions, [&]() {
+        naiveCount = CountPairsNaive(crafting, held);
+    });
+
+    std::printf("[suggestions] items=%d recipes=%zu held=%zu build=%.1f ms\n", itemCount, crafting.GetRecipeCount(),
+                held.size(), std::chrono::duration<double, std::milli>(syncEnd - syncStart).count());
+    std::printf("[suggestions]   craftable pairs:  %8.2f us (%zu pairs)\n", pairsUs, pairCount);
+    std::printf("[suggestions]   one step away:    %8.2f us (%zu items)\n", oneStepUs, oneStepCount);
+    std::printf("[suggestions]   pairwise lookups: %8.2f us (%zu pairs)\n", naiveUs, naiveCount);
+    return pairCount == naiveCount ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+// ----------------------------------------------------------------
+// Recipe lookup benchmark: packed-key flat table vs. the old string-keyed map
+// ----------------------------------------------------------------
+
+#include "Crafting/RecipeTable.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// What Item looked like before it became an interned handle
+struct LegacyItem
+{
+    int id;
+    std::string name;
+    std::string emoji;
+
+    LegacyItem(int id, const std::string& name, const std::string& emoji) : id(id), name(name), emoji(emoji) {}
+};
+
+// What Crafting::CreateRecipeKey built for every lookup before RecipeTable
+static std::string CreateRecipeKeyLegacy(int id1, int id2)
+{
+    int minId = std::min(id1, id2);
+    int maxId = std::max(id1, id2);
+    return std::to_string(minId) + "," + std::to_string(maxId);
+}
+
+template <typename Lookup>
+static double Run(const std::vector<std::pair<int, int>>& queries, int passes, Lookup lookup, long long& found)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        for (const auto& query : queries)
+        {
+            found += lookup(query.first, query.second);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double lookups = static_cast<double>(queries.size()) * passes;
+    return std::chrono::duration<double, std::nano>(end - start).count() / lookups;
+}
+
+// Returns false if the two tables disagree on any query
+static bool RunSize(size_t recipeCount, size_t legacyLimit)
+{
+    // Distinct unordered pairs over enough item ids to hold them
+    int idRange = 2;
+    while (static_cast<size_t>(idRange) * (idRange - 1) / 2 < recipeCount * 2)
+    {
+        idRange *= 2;
+    }
+
+    std::mt19937 rng(static_cast<unsigned int>(recipeCount));
+    std::uniform_int_distribution<int> id(1, idRange);
+
+    RecipeTable table;
+    table.Reserve(recipeCount);
+    std::vector<std::pair<int, int>> recipes;
+    recipes.reserve(recipeCount);
+    while (table.Size() < recipeCount)
+    {
+        int a = id(rng), b = id(rng);
+        if (table.Find(a, b) != RecipeTable::NO_RESULT) continue;
+
+        table.Insert(a, b, static_cast<int>(table.Size()));
+        recipes.emplace_back(a, b);
+    }
+
+    // Half hits (either ingredient order), half misses
+    std::vector<std::pair<int, int>> queries(1000000);
+    std::uniform_int_distribution<size_t> pick(0, recipeCount - 1);
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        const auto& recipe = recipes[pick(rng)];
+        queries[i] = (i & 1) ? std::make_pair(id(rng), id(rng))
+                             : (i & 2) ? std::make_pair(recipe.second, recipe.first) : recipe;
+    }
+    const int passes = 5;
+
+    long long tableFound = 0;
+    auto packed = [&](int a, int b) { return table.Find(a, b) != RecipeTable::NO_RESULT ? 1 : 0; };
+    Run(queries, 1, packed, tableFound);
+    tableFound = 0;
+    double tableNs = Run(queries, passes, packed, tableFound);
+
+    std::printf("[crafting] recipes=%zu ids=%d table capacity=%zu (%.1f MB)\n", recipeCount, idRange,
+                table.Capacity(), table.Capacity() * (sizeof(uint64_t) + sizeof(int32_t)) / (1024.0 * 1024.0));
+    std::printf("[crafting]   flat table:        %7.2f ns/lookup\n", tableNs);
+
+    if (recipeCount > legacyLimit)
+    {
+        std::printf("[crafting]   string map:        skipped (over %zu recipes)\n", legacyLimit);
+        return true;
+    }
+
+    // The old layout: string keys, a heap Item per recipe, a heap copy per hit
+    std::unordered_map<std::string, std::unique_ptr<LegacyItem>> legacy;
+    for (size_t i = 0; i < recipes.size(); i++)
+    {
+        legacy[CreateRecipeKeyLegacy(recipes[i].first, recipes[i].second)] =
+            std::make_unique<LegacyItem>(static_cast<int>(i), "Result", "🔹");
+    }
+
+    long long legacyFound = 0;
+    auto strings = [&](int a, int b) {
+        auto it = legacy.find(CreateRecipeKeyLegacy(a, b));
+        if (it == legacy.end()) return 0;
+
+        auto result = std::make_unique<LegacyItem>(it->second->id, it->second->name, it->second->emoji);
+        return result->id >= 0 ? 1 : 0;
+    };
+    Run(queries, 1, strings, legacyFound);
+    legacyFound = 0;
+    double legacyNs = Run(queries, passes, strings, legacyFound);
+
+    std::printf("[crafting]   string map:        %7.2f ns/lookup\n", legacyNs);
+    std::printf("[crafting]   speedup=%.1fx (found %lld / %lld)\n", legacyNs / tableNs, legacyFound, tableFound);
+    return legacyFound == tableFound;
+}
+
+int main(int argc, char** argv)
+{
+    // Recipe counts to run, e.g. "crafting_bench 1000 100000 10000000"
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; i++)
+    {
+        sizes.push_back(static_cast<size_t>(std::atoll(argv[i])));
+    }
+    if (sizes.empty())
+    {
+        sizes = {1000, 100000, 10000000};
+    }
+
+    // The string map needs ~150 bytes a recipe; keep it off the biggest runs
+    const size_t legacyLimit = 1000000;
+
+    bool ok = true;
+    for (size_t size : sizes)
+    {
+        if (size == 0) continue;
+        ok = RunSize(size, legacyLimit) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,376 @@
+// ----------------------------------------------------------------
+// Crafting throughput benchmark: synthetic item/recipe sets from 1k to 10M
+// recipes, uniform and skewed ingredient ids. Measures build and load
+// times, combine_items hits and misses, FindItemById and memory per recipe,
+// plus cache misses where perf_event is available; writes JSON for
+// regression tracking.
+// ----------------------------------------------------------------
+
+#include "Crafting/Crafting.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware cache misses of the calling thread, if the kernel lets us count them
+class CacheMissCounter
+{
+public:
+    CacheMissCounter()
+    {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        mFd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+        if (mFd >= 0) close(mFd);
+#endif
+    }
+
+    bool IsAvailable() const { return mFd >= 0; }
+
+    void Start()
+    {
+#ifdef __linux__
+        if (mFd < 0) return;
+        ioctl(mFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(mFd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // Misses since Start, or -1 if unavailable
+    long long Stop()
+    {
+#ifdef __linux__
+        if (mFd < 0) return -1;
+        ioctl(mFd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(mFd, &count, sizeof(count)) != sizeof(count)) return -1;
+        return count;
+#else
+        return -1;
+#endif
+    }
+
+private:
+    int mFd = -1;
+};
+
+static double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Ingredient ids: uniform, or skewed toward low ids the way base elements
+// (water, fire, ...) appear in far more recipes than late discoveries
+struct IdSampler
+{
+    bool skewed;
+    int itemCount;
+
+    int operator()(std::mt19937_64& rng) const
+    {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        if (skewed) u = u * u * u;
+        return std::min(static_cast<int>(u * itemCount), itemCount - 1);
+    }
+};
+
+struct Query
+{
+    Item first;
+    Item second;
+};
+
+// Nanoseconds per combine_items call over the queries; counts the hits
+static double TimeCombine(const Crafting& crafting, const std::vector<Query>& queries, int passes,
+                          CacheMissCounter& counter, long long& misses, size_t& hits)
+{
+    hits = 0;
+    for (const Query& query : queries)  // Warm up
+    {
+        hits += crafting.combine_items(query.first, query.second) ? 1 : 0;
+    }
+
+    hits = 0;
+    counter.Start();
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        for (const Query& query : queries)
+        {
+            hits += crafting.combine_items(query.first, query.second) ? 1 : 0;
+        }
+    }
+    double ms = MillisecondsSince(start);
+    misses = counter.Stop();
+    hits /= passes;
+    return ms * 1e6 / (static_cast<double>(queries.size()) * passes);
+}
+
+// Writes the sources streaming, without building a JSON document of them
+static bool WriteJsonSources(const Crafting& crafting, const std::vector<std::pair<std::pair<int, int>, int>>& recipes,
+                             const std::string& itemsPath, const std::string& recipesPath)
+{
+    std::FILE* items = std::fopen(itemsPath.c_str(), "w");
+    std::FILE* recipesFile = std::fopen(recipesPath.c_str(), "w");
+    if (!items || !recipesFile)
+    {
+        if (items) std::fclose(items);
+        if (recipesFile) std::fclose(recipesFile);
+        return false;
+    }
+
+    // Names are "Item N" and emoji the default, so nothing needs escaping
+    std::fputs("{\"items\":[", items);
+    const std::vector<Item>& all = crafting.GetAllItems();
+    for (size_t i = 0; i < all.size(); i++)
+    {
+        std::fprintf(items, "%s{\"id\":%d,\"name\":\"%s\",\"emoji\":\"%s\"}", i ? "," : "", all[i].id,
+                     std::string(all[i].name).c_str(), std::string(all[i].emoji).c_str());
+    }
+    std::fputs("]}", items);
+
+    std::fputs("{\"recipes\":[", recipesFile);
+    for (size_t i = 0; i < recipes.size(); i++)
+    {
+        std::fprintf(recipesFile, "%s{\"item1_id\":%d,\"item2_id\":%d,\"result_id\":%d}", i ? "," : "",
+                     recipes[i].first.first, recipes[i].first.second, recipes[i].second);
+    }
+    std::fputs("]}", recipesFile);
+
+    bool ok = !std::ferror(items) && !std::ferror(recipesFile);
+    std::fclose(items);
+    std::fclose(recipesFile);
+    return ok;
+}
+
+static nlohmann::json RunSize(size_t recipeCount, bool skewed, size_t jsonLimit, const std::string& scratchPrefix)
+{
+    const int itemCount = static_cast<int>(std::max<size_t>(64, recipeCount / 4));
+    const size_t queryCount = std::min<size_t>(1000000, std::max<size_t>(recipeCount, 100000));
+    const int passes = 3;
+    IdSampler sample{skewed, itemCount};
+    std::mt19937_64 rng(recipeCount * 2 + (skewed ? 1 : 0));
+    CacheMissCounter counter;
+
+    nlohmann::json run;
+    run["recipes"] = recipeCount;
+    run["items"] = itemCount;
+    run["distribution"] = skewed ? "skewed" : "uniform";
+
+    // Build in memory, as the generator and the tests do
+    auto buildStart = std::chrono::steady_clock::now();
+    Crafting crafting;
+    for (int i = 0; i < itemCount; i++)
+    {
+        crafting.AddItem(Item(i, "Item " + std::to_string(i)));
+    }
+    std::vector<std::pair<std::pair<int, int>, int>> recipes;
+    recipes.reserve(recipeCount);
+    while (crafting.GetRecipeCount() < recipeCount)
+    {
+        int a = sample(rng), b = sample(rng);
+        if (crafting.FindRecipe(a, b) != RecipeTable::NO_RESULT) continue;
+
+        int result = static_cast<int>(rng() % itemCount);
+        crafting.RegisterRecipe(a, b, result);
+        recipes.push_back({{a, b}, result});
+    }
+    run["build_ms"] = MillisecondsSince(buildStart);
+
+    // Counted from the containers rather than read off the RSS, which moves
+    // by whole pages and allocator arenas and says little at these sizes
+    const RecipeTable& table = crafting.GetRecipes();
+    const MultiRecipeTable& multiTable = crafting.GetMultiRecipes();
+    size_t tableBytes = table.Capacity() * (sizeof(uint64_t) + sizeof(int32_t));
+    size_t multiTableBytes = multiTable.Capacity() * (sizeof(MultiRecipeTable::Key) + sizeof(int32_t));
+    // Items and the id -> index table (ids here are 0..itemCount-1)
+    size_t itemBytes = crafting.GetAllItems().capacity() * sizeof(Item) + itemCount * sizeof(int32_t);
+    // Interned strings: the names are distinct, the emoji is the one default
+    size_t arenaBytes = crafting.GetAllItems().empty() ? 0 : crafting.GetAllItems()[0].emoji.size() + 1;
+    for (const Item& item : crafting.GetAllItems())
+    {
+        arenaBytes += item.name.size() + 1;
+    }
+    run["table_bytes_per_recipe"] = static_cast<double>(tableBytes) / recipeCount;
+    // Everything the built Crafting holds (tables, items, their index and strings), per recipe
+    run["resident_bytes_per_recipe"] =
+        static_cast<double>(tableBytes + multiTableBytes + itemBytes + arenaBytes) / recipeCount;
+
+    // Loading: JSON (the source of truth) and the compiled database
+    std::string itemsPath = scratchPrefix + "_items.json";
+    std::string recipesPath = scratchPrefix + "_recipes.json";
+    std::string dbPath = scratchPrefix + ".db";
+    // Over the limit the sources are small stand-ins: the database only needs them for its stamps
+    bool withJson = recipeCount <= jsonLimit;
+    if (withJson)
+    {
+        withJson = WriteJsonSources(crafting, recipes, itemsPath, recipesPath);
+    }
+    else
+    {
+        std::ofstream(itemsPath) << "{\"items\":[]}";
+        std::ofstream(recipesPath) << "{\"recipes\":[]}";
+    }
+    run["json_load_ms"] = nullptr;
+    if (withJson)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Crafting loaded;
+        bool ok = loaded.LoadItemsFromJson(itemsPath) && loaded.LoadRecipesFromJson(recipesPath);
+        if (ok) run["json_load_ms"] = MillisecondsSince(start);
+    }
+    run["compiled_load_ms"] = nullptr;
+    if (crafting.WriteCompiled(dbPath, itemsPath, recipesPath))
+    {
+        auto start = std::chrono::steady_clock::now();
+        Crafting loaded;
+        if (loaded.LoadCompiled(dbPath, itemsPath, recipesPath)) run["compiled_load_ms"] = MillisecondsSince(start);
+    }
+    std::remove(itemsPath.c_str());
+    std::remove(recipesPath.c_str());
+    std::remove(dbPath.c_str());
+
+    // combine_items: hits in random order (either ingredient order), misses on unknown pairs
+    std::vector<Query> hitQueries, missQueries;
+    hitQueries.reserve(queryCount);
+    missQueries.reserve(queryCount);
+    while (hitQueries.size() < queryCount)
+    {
+        const auto& recipe = recipes[rng() % recipes.size()];
+        const Item* first = crafting.FindItemById(recipe.first.first);
+        const Item* second = crafting.FindItemById(recipe.first.second);
+        if (rng() & 1) std::swap(first, second);
+        hitQueries.push_back(Query{*first, *second});
+    }
+    while (missQueries.size() < queryCount)
+    {
+        int a = sample(rng), b = sample(rng);
+        if (crafting.FindRecipe(a, b) != RecipeTable::NO_RESULT) continue;
+        missQueries.push_back(Query{*crafting.FindItemById(a), *crafting.FindItemById(b)});
+    }
+
+    long long hitMisses = -1, missMisses = -1;
+    size_t hits = 0, missHits = 0;
+    run["combine_hit_ns"] = TimeCombine(crafting, hitQueries, passes, counter, hitMisses, hits);
+    run["combine_miss_ns"] = TimeCombine(crafting, missQueries, passes, counter, missMisses, missHits);
+    double perCall = static_cast<double>(queryCount) * passes;
+    run["combine_hit_cache_misses"] = hitMisses >= 0 ? nlohmann::json(hitMisses / perCall) : nlohmann::json(nullptr);
+    run["combine_miss_cache_misses"] = missMisses >= 0 ? nlohmann::json(missMisses / perCall) : nlohmann::json(nullptr);
+    run["valid"] = hits == queryCount && missHits == 0;
+
+    // FindItemById on random ids
+    std::vector<int> ids(queryCount);
+    for (int& id : ids)
+    {
+        id = sample(rng);
+    }
+    size_t found = 0;
+    counter.Start();
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        for (int id : ids)
+        {
+            found += crafting.FindItemById(id) ? 1 : 0;
+        }
+    }
+    run["find_item_ns"] = MillisecondsSince(start) * 1e6 / perCall;
+    long long findMisses = counter.Stop();
+    run["find_item_cache_misses"] = findMisses >= 0 ? nlohmann::json(findMisses / perCall) : nlohmann::json(nullptr);
+    run["valid"] = run["valid"].get<bool>() && found == ids.size() * passes;
+
+    std::printf("[throughput] %9zu recipes %-7s build %8.1f ms  combine hit %6.1f ns  miss %6.1f ns  item %5.1f ns  "
+                "%5.1f B/recipe\n",
+                recipeCount, skewed ? "skewed" : "uniform", run["build_ms"].get<double>(),
+                run["combine_hit_ns"].get<double>(), run["combine_miss_ns"].get<double>(),
+                run["find_item_ns"].get<double>(), run["table_bytes_per_recipe"].get<double>());
+    return run;
+}
+
+int main(int argc, char** argv)
+{
+    // "crafting_throughput_bench [--json PATH] [--uniform | --skewed] [recipe counts...]"
+    std::vector<size_t> sizes;
+    const char* jsonPath = nullptr;
+    bool uniform = true, skewed = true;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--uniform") == 0)
+            skewed = false;
+        else if (std::strcmp(argv[i], "--skewed") == 0)
+            uniform = false;
+        else
+            sizes.push_back(static_cast<size_t>(std::atoll(argv[i])));
+    }
+    if (sizes.empty())
+    {
+        sizes = {1000, 10000, 100000, 1000000, 10000000};
+    }
+
+    // Parsing recipes.json takes ~1 KB of DOM per recipe; keep it off the biggest runs
+    const size_t jsonLimit = 1000000;
+
+    CacheMissCounter probe;
+    if (!probe.IsAvailable())
+    {
+        std::printf("[throughput] perf_event unavailable, cache misses not counted\n");
+    }
+
+    nlohmann::json report;
+    report["benchmark"] = "crafting_throughput";
+    report["cache_misses_counted"] = probe.IsAvailable();
+    report["runs"] = nlohmann::json::array();
+    bool ok = true;
+    for (size_t size : sizes)
+    {
+        if (size == 0) continue;
+        for (bool skew : {false, true})
+        {
+            if ((skew && !skewed) || (!skew && !uniform)) continue;
+            nlohmann::json run = RunSize(size, skew, jsonLimit, "crafting_throughput_scratch");
+            ok = ok && run["valid"].get<bool>();
+            report["runs"].push_back(std::move(run));
+        }
+    }
+
+    if (jsonPath)
+    {
+        std::ofstream(jsonPath) << report.dump(2) << '\n';
+        std::printf("[throughput] wrote %s\n", jsonPath);
+    }
+    else
+    {
+        std::printf("%s\n", report.dump(2).c_str());
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// ----------------------------------------------------------------
+// Pathfinding benchmark: flat grid A* vs. hierarchical (HPA*) long paths
+// ----------------------------------------------------------------
+
+#include "AI/PathfindingService.hpp"
+#include "Map/TileMap.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Runs every query to completion; returns microseconds per query and the
+// summed path length (in pixels, along the waypoints)
+static double Run(PathfindingService& service, const std::vector<std::pair<Vector2, Vector2>>& queries,
+                  double& length, int& failed)
+{
+    std::vector<Vector2> waypoints;
+    length = 0.0;
+    failed = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& query : queries)
+    {
+        uint32_t ticket = service.RequestPath(query.first, query.second);
+        PathStatus status;
+        while ((status = service.TakePath(ticket, waypoints)) == PathStatus::Pending)
+        {
+            service.Update();
+        }
+
+        if (status != PathStatus::Ready)
+        {
+            failed++;
+            continue;
+        }
+        Vector2 from = query.first;
+        for (const Vector2& point : waypoints)
+        {
+            length += (point - from).Length();
+            from = point;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / queries.size();
+}
+
+int main(int argc, char** argv)
+{
+    int mapSize = argc > 1 ? std::atoi(argv[1]) : 256;
+    int count = argc > 2 ? std::atoi(argv[2]) : 200;
+    const int tileSize = 40;
+
+    // GenerateMap's scattered water, plus walls with gaps so routes have to detour
+    TileMap tileMap(mapSize, mapSize, tileSize);
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (int y = 8; y < mapSize; y += 24)
+    {
+        for (int x = 0; x < mapSize; x++)
+        {
+            if (percent(rng) >= 6) tileMap.SetCollision(x, y, true);
+        }
+    }
+
+    // Far apart start/goal pairs on open tiles
+    const CollisionGrid& grid = tileMap.GetCollisionGrid();
+    std::uniform_int_distribution<int> coord(1, mapSize - 2);
+    std::vector<std::pair<Vector2, Vector2>> queries;
+    while (static_cast<int>(queries.size()) < count)
+    {
+        int sx = coord(rng), sy = coord(rng), gx = coord(rng), gy = coord(rng);
+        if (grid.IsSolid(sx, sy) || grid.IsSolid(gx, gy) || std::abs(sx - gx) + std::abs(sy - gy) < mapSize / 2)
+            continue;
+
+        queries.emplace_back(Vector2((sx + 0.5f) * tileSize, (sy + 0.5f) * tileSize),
+                             Vector2((gx + 0.5f) * tileSize, (gy + 0.5f) * tileSize));
+    }
+
+    // No cache and no step budget, so every query is one full search
+    PathfindingService flat(&tileMap);
+    flat.SetCacheCapacity(0);
+    flat.SetBudget(1 << 30);
+    flat.SetLongPathTiles(1 << 30);
+
+    PathfindingService hierarchical(&tileMap);
+    hierarchical.SetCacheCapacity(0);
+    hierarchical.SetBudget(1 << 30);
+    hierarchical.SetLongPathSegments(1 << 30);  // Refine the whole route, to compare lengths
+
+    auto buildStart = std::chrono::steady_clock::now();
+    hierarchical.Update();
+    double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+
+    double flatLength, hierarchicalLength;
+    int flatFailed, hierarchicalFailed;
+    double flatUs = Run(flat, queries, flatLength, flatFailed);
+    double hierarchicalUs = Run(hierarchical, queries, hierarchicalLength, hierarchicalFailed);
+
+    // Default segment count: only the first stretch of each route is refined
+    hierarchical.SetLongPathSegments(PathfindingService::DEFAULT_LONG_PATH_SEGMENTS);
+    double firstLength;
+    int firstFailed;
+    double firstUs = Run(hierarchical, queries, firstLength, firstFailed);
+
+    // Rebuild cost of one changed tile
+    auto patchStart = std::chrono::steady_clock::now();
+    tileMap.SetCollision(mapSize / 2, mapSize / 2, !grid.IsSolid(mapSize / 2, mapSize / 2));
+    hierarchical.Update();
+    double patchUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - patchStart).count();
+
+    const HierarchicalPathfinder& graph = hierarchical.GetHierarchy();
+    std::printf("[pathfinding] map=%dx%d queries=%d clusters=%d nodes=%zu build=%.2f ms\n",
+                mapSize, mapSize, count, graph.GetClusterCount(), graph.GetNodeCount(), buildMs);
+    std::printf("[pathfinding] flat A*:              %9.1f us/query (failed %d)\n", flatUs, flatFailed);
+    std::printf("[pathfinding] HPA* full refine:     %9.1f us/query (failed %d)\n", hierarchicalUs, hierarchicalFailed);
+    std::printf("[pathfinding] HPA* first stretch:   %9.1f us/query (failed %d)\n", firstUs, firstFailed);
+    std::printf("[pathfinding] HPA* / flat length:   %.3f\n", hierarchicalLength / flatLength);
+    std::printf("[pathfinding] one-tile rebuild:     %9.1f us\n", patchUs);
+    return flatFailed == hierarchicalFailed ? 0 : 1;
+}
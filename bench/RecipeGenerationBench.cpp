@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------
+// Recipe generation round trip, headless: request unknown pairs, poll
+// the results, then replay the log into a fresh session
+// ----------------------------------------------------------------
+
+#include "Crafting/RecipeGenerationService.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Second session: anything it is asked to generate means the log was not replayed
+class CountingGenerator : public IRecipeGenerator
+{
+public:
+    explicit CountingGenerator(int& calls) : calls(calls) {}
+
+    bool Generate(const Item&, const Item&, GeneratedItem&) override
+    {
+        calls++;
+        return false;
+    }
+
+private:
+    int& calls;
+};
+
+static void AddBaseItems(Crafting& crafting, int itemCount)
+{
+    for (int i = 0; i < itemCount; i++)
+    {
+        crafting.AddItem(Item(i, "Item " + std::to_string(i)));
+    }
+    // A few hand-written recipes the generator must leave alone
+    for (int i = 0; i + 1 < itemCount; i += 4)
+    {
+        crafting.RegisterRecipe(i, i + 1, i + 2);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // "recipe_generation_bench [items] [log path]"
+    int itemCount = argc > 1 ? std::atoi(argv[1]) : 40;
+    std::string logPath = argc > 2 ? argv[2] : "recipe_generation_bench.jsonl";
+    std::remove(logPath.c_str());
+
+    std::vector<std::pair<int, int>> unknown;
+    size_t failures = 0;
+    size_t generated = 0;
+    std::vector<int> results;
+    double pollMs = 0.0;
+
+    // First session: every pair without a recipe is requested, then polled until answered
+    Crafting first;
+    AddBaseItems(first, itemCount);
+    {
+        RecipeGenerationService service(first, std::make_unique<HashRecipeGenerator>(), logPath);
+        auto start = std::chrono::steady_clock::now();
+        for (int a = 0; a < itemCount; a++)
+        {
+            for (int b = a; b < itemCount; b++)
+            {
+                if (service.Request(*first.FindItemById(a), *first.FindItemById(b)))
+                {
+                    unknown.emplace_back(a, b);
+                }
+            }
+        }
+
+        std::vector<RecipeGenerationService::Result> finished;
+        while (service.GetPendingCount() > 0)
+        {
+            service.Poll(finished);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        pollMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        generated = finished.size();
+        for (const auto& pair : unknown)
+        {
+            int result = first.FindRecipe(pair.first, pair.second);
+            failures += result == RecipeTable::NO_RESULT ? 1 : 0;
+            results.push_back(result);
+        }
+    }  // Flushes the log
+
+    size_t logLines = 0;
+    {
+        std::ifstream log(logPath);
+        std::string line;
+        while (std::getline(log, line))
+        {
+            logLines += line.empty() ? 0 : 1;
+        }
+    }
+
+    // Second session: the log alone must bring every recipe back, with the same result ids
+    int generatorCalls = 0;
+    size_t mismatched = 0;
+    size_t requeued = 0;
+    Crafting second;
+    AddBaseItems(second, itemCount);
+    auto replayStart = std::chrono::steady_clock::now();
+    {
+        RecipeGenerationService service(second, std::make_unique<CountingGenerator>(generatorCalls), logPath);
+        double replayMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - replayStart).count();
+
+        for (size_t i = 0; i < unknown.size(); i++)
+        {
+            const auto& pair = unknown[i];
+            mismatched += second.FindRecipe(pair.first, pair.second) != results[i] ? 1 : 0;
+            requeued += service.Request(*second.FindItemById(pair.first), *second.FindItemById(pair.second)) ? 1 : 0;
+        }
+
+        std::printf("[generation] items=%d unknown pairs=%zu\n", itemCount, unknown.size());
+        std::printf("[generation]   request -> poll:  %8.2f ms (%zu results, %zu without recipe)\n", pollMs,
+                    generated, failures);
+        std::printf("[generation]   log lines:        %8zu\n", logLines);
+        std::printf("[generation]   replay:           %8.2f ms (%zu replayed, %zu mismatched, %zu re-requested)\n",
+                    replayMs, service.GetGeneratedCount(), mismatched, requeued);
+    }
+    std::remove(logPath.c_str());
+
+    bool ok = generated == unknown.size() && failures == 0 && logLines == unknown.size() && mismatched == 0 &&
+              requeued == 0 && generatorCalls == 0;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+#include "FlowField.hpp"
+#include "../Map/TileMap.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const float SQRT2 = 1.41421356f;
+
+    // Same neighbour order as PathfindingService: 4 straight, then 4 diagonal
+    const int NEIGHBOUR_X[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    const int NEIGHBOUR_Y[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+    const uint8_t OPPOSITE[8] = {1, 0, 3, 2, 7, 6, 5, 4};
+}
+
+FlowField::FlowField(int maxDistance)
+    : mMaxDistance(maxDistance)
+    , mGrid(nullptr)
+    , mWidth(0)
+    , mHeight(0)
+    , mTileSize(1.0f)
+    , mTargetCell(-1)
+    , mTarget(Vector2::Zero)
+    , mVersion(0)
+    , mRebuilds(0)
+{
+}
+
+void FlowField::Clear()
+{
+    mTargetCell = -1;
+}
+
+bool FlowField::Update(const TileMap& tileMap, const Vector2& target)
+{
+    const CollisionGrid& grid = tileMap.GetCollisionGrid();
+    float tileSize = static_cast<float>(tileMap.GetTileSize());
+    int x = static_cast<int>(std::floor(target.x / tileSize));
+    int y = static_cast<int>(std::floor(target.y / tileSize));
+    if (x < 0 || x >= grid.GetWidth() || y < 0 || y >= grid.GetHeight())
+    {
+        Clear();
+        return false;
+    }
+
+    // The exact target is only used for the last stretch, so it can move freely inside its tile
+    mTarget = target;
+
+    int32_t cell = y * grid.GetWidth() + x;
+    if (cell == mTargetCell && tileMap.GetCollisionVersion() == mVersion &&
+        grid.GetWidth() == mWidth && grid.GetHeight() == mHeight && tileSize == mTileSize)
+    {
+        return false;
+    }
+
+    mGrid = &grid;
+    mWidth = grid.GetWidth();
+    mHeight = grid.GetHeight();
+    mTileSize = tileSize;
+    mTargetCell = cell;
+    mVersion = tileMap.GetCollisionVersion();
+    Build(tileMap);
+    mRebuilds++;
+    return true;
+}
+
+void FlowField::Build(const TileMap& tileMap)
+{
+    const CollisionGrid& grid = tileMap.GetCollisionGrid();
+    size_t cells = static_cast<size_t>(mWidth) * mHeight;
+    mDirections.assign(cells, NO_DIRECTION);
+    mDistances.assign(cells, -1.0f);
+
+    auto heapOrder = [](const OpenNode& a, const OpenNode& b) { return a.distance > b.distance; };  // Min-heap
+    auto isFree = [&grid](int x, int y) { return !grid.IsSolid(x, y); };
+
+    // Moves are symmetric, so searching outward from the target gives every
+    // tile its shortest way back
+    mOpen.clear();
+    mDistances[mTargetCell] = 0.0f;
+    mOpen.push_back({0.0f, mTargetCell});
+
+    while (!mOpen.empty())
+    {
+        std::pop_heap(mOpen.begin(), mOpen.end(), heapOrder);
+        OpenNode node = mOpen.back();
+        mOpen.pop_back();
+
+        // Stale entry
+        if (node.distance > mDistances[node.cell]) continue;
+
+        int x = node.cell % mWidth;
+        int y = node.cell / mWidth;
+        for (int n = 0; n < 8; n++)
+        {
+            int nx = x + NEIGHBOUR_X[n];
+            int ny = y + NEIGHBOUR_Y[n];
+            if (!isFree(nx, ny)) continue;
+
+            bool diagonal = n >= 4;
+            if (diagonal && (!isFree(nx, y) || !isFree(x, ny))) continue;
+
+            float distance = node.distance + (diagonal ? SQRT2 : 1.0f);
+            if (distance > static_cast<float>(mMaxDistance)) continue;
+
+            int32_t next = ny * mWidth + nx;
+            if (mDistances[next] >= 0.0f && mDistances[next] <= distance) continue;
+
+            mDistances[next] = distance;
+            mDirections[next] = OPPOSITE[n];
+            mOpen.push_back({distance, next});
+            std::push_heap(mOpen.begin(), mOpen.end(), heapOrder);
+        }
+    }
+}
+
+int32_t FlowField::CellAt(const Vector2& position) const
+{
+    int x = static_cast<int>(std::floor(position.x / mTileSize));
+    int y = static_cast<int>(std::floor(position.y / mTileSize));
+    if (x < 0 || x >= mWidth || y < 0 || y >= mHeight) return -1;
+
+    return y * mWidth + x;
+}
+
+Vector2 FlowField::CellCenter(int32_t cell) const
+{
+    return Vector2((cell % mWidth + 0.5f) * mTileSize, (cell / mWidth + 0.5f) * mTileSize);
+}
+
+bool FlowField::GetSteeringTarget(const Vector2& position, const Vector2& halfSize, Vector2& out) const
+{
+    if (mTargetCell < 0) return false;
+
+    int32_t cell = CellAt(position);
+    if (cell < 0 || mDistances[cell] < 0.0f) return false;
+
+    if (cell == mTargetCell)
+    {
+        out = mTarget;
+        return true;
+    }
+
+    // Furthest tile down the flow the box can move to straight without
+    // touching a wall (string pulling); if not even the next one, re-center
+    // in the current tile first, which is always clear
+    out = CellCenter(cell);
+    for (int step = 0; step < MAX_LOOKAHEAD && cell != mTargetCell; step++)
+    {
+        cell += NEIGHBOUR_Y[mDirections[cell]] * mWidth + NEIGHBOUR_X[mDirections[cell]];
+        Vector2 point = cell == mTargetCell ? mTarget : CellCenter(cell);
+        if (!CanReach(position, halfSize, point)) break;
+
+        out = point;
+    }
+    return true;
+}
+
+bool FlowField::CanReach(const Vector2& position, const Vector2& halfSize, const Vector2& point) const
+{
+    SweepHit hit;
+    return !mGrid->SweepBox(position - halfSize, position + halfSize, point - position, mTileSize, hit);
+}
+
+float FlowField::GetDistance(const Vector2& position) const
+{
+    if (mTargetCell < 0) return -1.0f;
+
+    int32_t cell = CellAt(position);
+    return cell < 0 ? -1.0f : mDistances[cell];
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "../MathUtils.h"
+
+class TileMap;
+class CollisionGrid;
+
+// Shortest-path directions toward one target over the collision grid.
+// A Dijkstra from the target's tile (same 8-way, no-corner-cutting moves as
+// PathfindingService) stores, for every reached tile, the neighbour to step
+// to next. It is rebuilt only when the target enters another tile or the
+// collision changes, and any number of agents sample it in O(1), so chasing
+// costs the same for one NPC or fifty. Read-only between rebuilds, so it is
+// safe to sample from parallel actor updates.
+class FlowField
+{
+public:
+    static const int DEFAULT_MAX_DISTANCE = 64;  // Tiles of path length covered
+    static const int MAX_LOOKAHEAD = 6;          // Flow tiles checked for a shortcut
+
+    explicit FlowField(int maxDistance = DEFAULT_MAX_DISTANCE);
+
+    // Rebuilds if the target changed tile or the grid changed; true if it did
+    bool Update(const TileMap& tileMap, const Vector2& target);
+    void Clear();
+
+    // Point for a box of halfSize at position to steer at: the center of the
+    // furthest tile down the flow (up to MAX_LOOKAHEAD) it can reach in a
+    // straight line without touching a wall, the target itself once that is
+    // in reach, or the current tile's center if nothing is. False if position
+    // is not covered by the field.
+    bool GetSteeringTarget(const Vector2& position, const Vector2& halfSize, Vector2& out) const;
+    // Path length to the target in tiles, or -1 if not covered
+    float GetDistance(const Vector2& position) const;
+
+    bool IsValid() const { return mTargetCell >= 0; }
+    size_t GetRebuildCount() const { return mRebuilds; }
+
+private:
+    static constexpr uint8_t NO_DIRECTION = 0xFF;
+
+    struct OpenNode
+    {
+        float distance;
+        int32_t cell;
+    };
+
+    void Build(const TileMap& tileMap);
+    int32_t CellAt(const Vector2& position) const;
+    Vector2 CellCenter(int32_t cell) const;
+
+    bool CanReach(const Vector2& position, const Vector2& halfSize, const Vector2& point) const;
+
+    int mMaxDistance;
+    const CollisionGrid* mGrid;  // Of the map the field was built on
+    int mWidth;
+    int mHeight;
+    float mTileSize;
+    int32_t mTargetCell;     // -1 while empty
+    Vector2 mTarget;
+    uint32_t mVersion;       // Collision version the field was built on
+    size_t mRebuilds;
+
+    std::vector<uint8_t> mDirections;  // Neighbour index toward the target per cell
+    std::vector<float> mDistances;
+    std::vector<OpenNode> mOpen;       // Reused heap
+};
@@ -0,0 +1,524 @@
+#include "HierarchicalPathfinder.hpp"
+#include "../Map/TileMap.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <set>
+
+namespace
+{
+    const float SQRT2 = 1.41421356f;
+    const float INFINITE_COST = std::numeric_limits<float>::infinity();
+
+    // Same neighbour order as PathfindingService: 4 straight, then 4 diagonal
+    const int NEIGHBOUR_X[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    const int NEIGHBOUR_Y[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+    const int SIDE_EAST = 0;
+    const int SIDE_SOUTH = 1;
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder()
+    : mWidth(0)
+    , mHeight(0)
+    , mClustersX(0)
+    , mClustersY(0)
+    , mVersion(0)
+    , mRebuiltClusters(0)
+{
+}
+
+void HierarchicalPathfinder::Sync(const TileMap& tileMap)
+{
+    const CollisionGrid& grid = tileMap.GetCollisionGrid();
+
+    // New or resized map: build from scratch
+    if (grid.GetWidth() != mWidth || grid.GetHeight() != mHeight)
+    {
+        mWidth = grid.GetWidth();
+        mHeight = grid.GetHeight();
+        mSolid.resize(static_cast<size_t>(mWidth) * mHeight);
+        for (int y = 0; y < mHeight; y++)
+        {
+            for (int x = 0; x < mWidth; x++)
+            {
+                mSolid[static_cast<size_t>(y) * mWidth + x] = grid.IsSolid(x, y) ? 1 : 0;
+            }
+        }
+        mVersion = tileMap.GetCollisionVersion();
+        Build();
+        return;
+    }
+
+    if (tileMap.GetCollisionVersion() == mVersion) return;
+    mVersion = tileMap.GetCollisionVersion();
+
+    // Find the clusters whose tiles changed
+    std::vector<int32_t> dirty;
+    std::vector<uint8_t> isDirty(static_cast<size_t>(mClustersX) * mClustersY, 0);
+    for (int y = 0; y < mHeight; y++)
+    {
+        for (int x = 0; x < mWidth; x++)
+        {
+            uint8_t solid = grid.IsSolid(x, y) ? 1 : 0;
+            uint8_t& known = mSolid[static_cast<size_t>(y) * mWidth + x];
+            if (known == solid) continue;
+
+            known = solid;
+            int cluster = (y / CLUSTER_SIZE) * mClustersX + x / CLUSTER_SIZE;
+            if (!isDirty[cluster])
+            {
+                isDirty[cluster] = 1;
+                dirty.push_back(cluster);
+            }
+        }
+    }
+
+    if (!dirty.empty())
+    {
+        RebuildClusters(dirty);
+    }
+}
+
+void HierarchicalPathfinder::Build()
+{
+    mClustersX = (mWidth + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+    mClustersY = (mHeight + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+    int clusters = mClustersX * mClustersY;
+
+    mNodes.clear();
+    mFreeNodes.clear();
+    mNodeAtCell.clear();
+    mClusterNodes.assign(clusters, {});
+    mBorders.assign(static_cast<size_t>(clusters) * 2, {});
+
+    for (int cluster = 0; cluster < clusters; cluster++)
+    {
+        BuildBorder(cluster, SIDE_EAST);
+        BuildBorder(cluster, SIDE_SOUTH);
+    }
+    for (int cluster = 0; cluster < clusters; cluster++)
+    {
+        BuildClusterEdges(cluster);
+    }
+    mRebuiltClusters += clusters;
+}
+
+void HierarchicalPathfinder::RebuildClusters(const std::vector<int32_t>& dirtyClusters)
+{
+    // Every border a dirty cluster touches, and every cluster on either side of one
+    std::set<int> borders;
+    std::set<int> clusters;
+    for (int cluster : dirtyClusters)
+    {
+        int cx = cluster % mClustersX;
+        int cy = cluster / mClustersX;
+        clusters.insert(cluster);
+
+        borders.insert(cluster * 2 + SIDE_EAST);
+        borders.insert(cluster * 2 + SIDE_SOUTH);
+        if (cx + 1 < mClustersX) clusters.insert(cluster + 1);
+        if (cy + 1 < mClustersY) clusters.insert(cluster + mClustersX);
+        if (cx > 0)
+        {
+            borders.insert((cluster - 1) * 2 + SIDE_EAST);
+            clusters.insert(cluster - 1);
+        }
+        if (cy > 0)
+        {
+            borders.insert((cluster - mClustersX) * 2 + SIDE_SOUTH);
+            clusters.insert(cluster - mClustersX);
+        }
+    }
+
+    for (int border : borders)
+    {
+        ClearBorder(border / 2, border % 2);
+    }
+    for (int border : borders)
+    {
+        BuildBorder(border / 2, border % 2);
+    }
+    for (int cluster : clusters)
+    {
+        BuildClusterEdges(cluster);
+    }
+    mRebuiltClusters += clusters.size();
+}
+
+void HierarchicalPathfinder::BuildBorder(int cluster, int side)
+{
+    Rect rect = ClusterRect(cluster);
+    int cx = cluster % mClustersX;
+    int cy = cluster / mClustersX;
+    if (side == SIDE_EAST && cx + 1 >= mClustersX) return;
+    if (side == SIDE_SOUTH && cy + 1 >= mClustersY) return;
+
+    // Walk along the border; a run is a stretch where both sides are open
+    int length = side == SIDE_EAST ? rect.y1 - rect.y0 : rect.x1 - rect.x0;
+    auto cellsAt = [&](int i, int32_t& inside, int32_t& outside) {
+        int x = side == SIDE_EAST ? rect.x1 - 1 : rect.x0 + i;
+        int y = side == SIDE_EAST ? rect.y0 + i : rect.y1 - 1;
+        int ox = side == SIDE_EAST ? x + 1 : x;
+        int oy = side == SIDE_EAST ? y : y + 1;
+        inside = y * mWidth + x;
+        outside = oy * mWidth + ox;
+        return IsFree(x, y) && IsFree(ox, oy);
+    };
+
+    int border = cluster * 2 + side;
+    int runStart = -1;
+    for (int i = 0; i <= length; i++)
+    {
+        int32_t inside, outside;
+        bool open = i < length && cellsAt(i, inside, outside);
+        if (open && runStart < 0)
+        {
+            runStart = i;
+        }
+        else if (!open && runStart >= 0)
+        {
+            // Short runs get one entrance in the middle, long ones one per end
+            int runEnd = i - 1;
+            if (runEnd - runStart + 1 >= LONG_ENTRANCE)
+            {
+                cellsAt(runStart, inside, outside);
+                AddEntrance(border, inside, outside);
+                cellsAt(runEnd, inside, outside);
+                AddEntrance(border, inside, outside);
+            }
+            else
+            {
+                cellsAt((runStart + runEnd) / 2, inside, outside);
+                AddEntrance(border, inside, outside);
+            }
+            runStart = -1;
+        }
+    }
+}
+
+void HierarchicalPathfinder::ClearBorder(int cluster, int side)
+{
+    std::vector<Entrance>& entrances = mBorders[cluster * 2 + side];
+    for (const Entrance& entrance : entrances)
+    {
+        // Drop the link across the border, then the nodes if nothing else uses them
+        auto unlink = [this](int32_t from, int32_t to) {
+            std::vector<Edge>& edges = mNodes[from].edges;
+            auto it = std::find_if(edges.begin(), edges.end(), [to](const Edge& e) { return e.to == to; });
+            if (it != edges.end()) edges.erase(it);
+        };
+        unlink(entrance.nodeA, entrance.nodeB);
+        unlink(entrance.nodeB, entrance.nodeA);
+        ReleaseNode(entrance.nodeA);
+        ReleaseNode(entrance.nodeB);
+    }
+    entrances.clear();
+}
+
+void HierarchicalPathfinder::AddEntrance(int border, int32_t cellA, int32_t cellB)
+{
+    int32_t nodeA = AcquireNode(cellA);
+    int32_t nodeB = AcquireNode(cellB);
+    mNodes[nodeA].edges.push_back({nodeB, 1.0f});
+    mNodes[nodeB].edges.push_back({nodeA, 1.0f});
+    mBorders[border].push_back({nodeA, nodeB});
+}
+
+int32_t HierarchicalPathfinder::AcquireNode(int32_t cell)
+{
+    // A corner tile can sit on two borders of its cluster
+    auto existing = mNodeAtCell.find(cell);
+    if (existing != mNodeAtCell.end())
+    {
+        mNodes[existing->second].refs++;
+        return existing->second;
+    }
+
+    int32_t node;
+    if (!mFreeNodes.empty())
+    {
+        node = mFreeNodes.back();
+        mFreeNodes.pop_back();
+    }
+    else
+    {
+        node = static_cast<int32_t>(mNodes.size());
+        mNodes.emplace_back();
+    }
+
+    Node& created = mNodes[node];
+    created.cell = cell;
+    created.cluster = ClusterOf(cell);
+    created.refs = 1;
+    created.edges.clear();
+    mClusterNodes[created.cluster].push_back(node);
+    mNodeAtCell[cell] = node;
+    return node;
+}
+
+void HierarchicalPathfinder::ReleaseNode(int32_t node)
+{
+    Node& released = mNodes[node];
+    if (--released.refs > 0) return;
+
+    // Edges are symmetric: unlink it from everything it links to, so a
+    // recycled slot is never reached through a stale edge
+    for (const Edge& edge : released.edges)
+    {
+        std::vector<Edge>& back = mNodes[edge.to].edges;
+        back.erase(std::remove_if(back.begin(), back.end(), [node](const Edge& e) { return e.to == node; }),
+                   back.end());
+    }
+    released.edges.clear();
+
+    std::vector<int32_t>& siblings = mClusterNodes[released.cluster];
+    siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+    mNodeAtCell.erase(released.cell);
+    mFreeNodes.push_back(node);
+}
+
+void HierarchicalPathfinder::BuildClusterEdges(int cluster)
+{
+    const std::vector<int32_t>& nodes = mClusterNodes[cluster];
+
+    // Keep only the links across borders
+    for (int32_t node : nodes)
+    {
+        std::vector<Edge>& edges = mNodes[node].edges;
+        edges.erase(std::remove_if(edges.begin(), edges.end(),
+                                   [this, cluster](const Edge& e) { return mNodes[e.to].cluster == cluster; }),
+                    edges.end());
+    }
+
+    Rect rect = ClusterRect(cluster);
+    for (int32_t node : nodes)
+    {
+        SearchRect(rect, mNodes[node].cell, -1);
+        for (int32_t other : nodes)
+        {
+            if (other == node) continue;
+
+            float cost = RectCost(rect, mNodes[other].cell);
+            if (cost >= 0.0f)
+            {
+                mNodes[node].edges.push_back({other, cost});
+            }
+        }
+    }
+}
+
+bool HierarchicalPathfinder::FindAbstractPath(int32_t start, int32_t goal, std::vector<int32_t>& waypoints)
+{
+    waypoints.clear();
+    int32_t cells = mWidth * mHeight;
+    if (!IsBuilt() || start < 0 || goal < 0 || start >= cells || goal >= cells) return false;
+    if (!IsFree(goal % mWidth, goal / mWidth)) return false;
+
+    const int startCluster = ClusterOf(start);
+    const int goalCluster = ClusterOf(goal);
+    const Rect startRect = ClusterRect(startCluster);
+    const Rect goalRect = ClusterRect(goalCluster);
+
+    size_t count = mNodes.size();
+    mNodeCost.assign(count, INFINITE_COST);
+    mNodeParent.assign(count, -1);
+    mNodeClosed.assign(count, 0);
+    mNodeOpen.clear();
+    auto heapOrder = [](const OpenNode& a, const OpenNode& b) { return a.f > b.f; };  // Min-heap
+
+    // Start: reach the nodes of its own cluster on the grid (and the goal, if it is in there too)
+    SearchRect(startRect, start, -1);
+    float best = startCluster == goalCluster ? RectCost(startRect, goal) : -1.0f;
+    if (best < 0.0f) best = INFINITE_COST;
+    int32_t bestNode = -1;  // -1: straight from the start
+    for (int32_t node : mClusterNodes[startCluster])
+    {
+        float cost = RectCost(startRect, mNodes[node].cell);
+        if (cost < 0.0f) continue;
+
+        mNodeCost[node] = cost;
+        mNodeOpen.push_back({cost + Heuristic(mNodes[node].cell, goal), node});
+        std::push_heap(mNodeOpen.begin(), mNodeOpen.end(), heapOrder);
+    }
+
+    // Goal: what it costs to get there from each node of its cluster
+    SearchRect(goalRect, goal, -1);
+    std::vector<std::pair<int32_t, float>> goalLinks;
+    for (int32_t node : mClusterNodes[goalCluster])
+    {
+        float cost = RectCost(goalRect, mNodes[node].cell);
+        if (cost >= 0.0f) goalLinks.emplace_back(node, cost);
+    }
+
+    // A* over the abstract graph
+    while (!mNodeOpen.empty())
+    {
+        std::pop_heap(mNodeOpen.begin(), mNodeOpen.end(), heapOrder);
+        OpenNode open = mNodeOpen.back();
+        mNodeOpen.pop_back();
+
+        if (open.f >= best) break;
+        if (mNodeClosed[open.index]) continue;
+        mNodeClosed[open.index] = 1;
+
+        const Node& node = mNodes[open.index];
+        float cost = mNodeCost[open.index];
+        if (node.cluster == goalCluster)
+        {
+            for (const auto& link : goalLinks)
+            {
+                if (link.first == open.index && cost + link.second < best)
+                {
+                    best = cost + link.second;
+                    bestNode = open.index;
+                }
+            }
+        }
+
+        for (const Edge& edge : node.edges)
+        {
+            float next = cost + edge.cost;
+            if (mNodeClosed[edge.to] || next >= mNodeCost[edge.to]) continue;
+
+            mNodeCost[edge.to] = next;
+            mNodeParent[edge.to] = open.index;
+            mNodeOpen.push_back({next + Heuristic(mNodes[edge.to].cell, goal), edge.to});
+            std::push_heap(mNodeOpen.begin(), mNodeOpen.end(), heapOrder);
+        }
+    }
+
+    if (best == INFINITE_COST) return false;
+
+    for (int32_t node = bestNode; node != -1; node = mNodeParent[node])
+    {
+        waypoints.push_back(mNodes[node].cell);
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+    waypoints.push_back(goal);
+    return true;
+}
+
+bool HierarchicalPathfinder::RefineSegment(int32_t from, int32_t to, std::vector<int32_t>& cells)
+{
+    if (from == to) return true;
+
+    int dx = std::abs(from % mWidth - to % mWidth);
+    int dy = std::abs(from / mWidth - to / mWidth);
+    if (dx <= 1 && dy <= 1 && (dx == 0 || dy == 0))
+    {
+        cells.push_back(to);
+        return true;
+    }
+
+    // Both ends' clusters (the same one for all but the first/last segment)
+    Rect a = ClusterRect(ClusterOf(from));
+    Rect b = ClusterRect(ClusterOf(to));
+    Rect rect{std::min(a.x0, b.x0), std::min(a.y0, b.y0), std::max(a.x1, b.x1), std::max(a.y1, b.y1)};
+
+    SearchRect(rect, from, to);
+    if (RectCost(rect, to) < 0.0f) return false;
+
+    size_t first = cells.size();
+    int rectWidth = rect.x1 - rect.x0;
+    int32_t local = (to / mWidth - rect.y0) * rectWidth + (to % mWidth - rect.x0);
+    while (mRectParent[local] != -1)
+    {
+        cells.push_back((rect.y0 + local / rectWidth) * mWidth + rect.x0 + local % rectWidth);
+        local = mRectParent[local];
+    }
+    std::reverse(cells.begin() + first, cells.end());
+    return true;
+}
+
+void HierarchicalPathfinder::SearchRect(const Rect& rect, int32_t source, int32_t target)
+{
+    int rectWidth = rect.x1 - rect.x0;
+    int rectHeight = rect.y1 - rect.y0;
+    mRectCost.assign(static_cast<size_t>(rectWidth) * rectHeight, -1.0f);
+    mRectParent.assign(mRectCost.size(), -1);
+    mRectOpen.clear();
+
+    auto heapOrder = [](const OpenNode& a, const OpenNode& b) { return a.f > b.f; };  // Min-heap
+    auto inside = [&rect](int x, int y) { return x >= rect.x0 && x < rect.x1 && y >= rect.y0 && y < rect.y1; };
+
+    int sx = source % mWidth;
+    int sy = source / mWidth;
+    if (!inside(sx, sy)) return;
+
+    int32_t sourceLocal = (sy - rect.y0) * rectWidth + (sx - rect.x0);
+    int32_t targetLocal = -1;
+    if (target >= 0 && inside(target % mWidth, target / mWidth))
+    {
+        targetLocal = (target / mWidth - rect.y0) * rectWidth + (target % mWidth - rect.x0);
+    }
+
+    mRectCost[sourceLocal] = 0.0f;
+    mRectOpen.push_back({0.0f, sourceLocal});
+    while (!mRectOpen.empty())
+    {
+        std::pop_heap(mRectOpen.begin(), mRectOpen.end(), heapOrder);
+        OpenNode open = mRectOpen.back();
+        mRectOpen.pop_back();
+
+        if (open.f > mRectCost[open.index]) continue;  // Stale
+        if (open.index == targetLocal) return;
+
+        int x = rect.x0 + open.index % rectWidth;
+        int y = rect.y0 + open.index / rectWidth;
+        for (int n = 0; n < 8; n++)
+        {
+            int nx = x + NEIGHBOUR_X[n];
+            int ny = y + NEIGHBOUR_Y[n];
+            if (!inside(nx, ny) || !IsFree(nx, ny)) continue;
+
+            bool diagonal = n >= 4;
+            if (diagonal && (!IsFree(nx, y) || !IsFree(x, ny))) continue;
+
+            int32_t next = (ny - rect.y0) * rectWidth + (nx - rect.x0);
+            float cost = open.f + (diagonal ? SQRT2 : 1.0f);
+            if (mRectCost[next] >= 0.0f && mRectCost[next] <= cost) continue;
+
+            mRectCost[next] = cost;
+            mRectParent[next] = open.index;
+            mRectOpen.push_back({cost, next});
+            std::push_heap(mRectOpen.begin(), mRectOpen.end(), heapOrder);
+        }
+    }
+}
+
+float HierarchicalPathfinder::RectCost(const Rect& rect, int32_t cell) const
+{
+    int x = cell % mWidth;
+    int y = cell / mWidth;
+    if (x < rect.x0 || x >= rect.x1 || y < rect.y0 || y >= rect.y1) return -1.0f;
+
+    return mRectCost[static_cast<size_t>(y - rect.y0) * (rect.x1 - rect.x0) + (x - rect.x0)];
+}
+
+HierarchicalPathfinder::Rect HierarchicalPathfinder::ClusterRect(int cluster) const
+{
+    int x0 = (cluster % mClustersX) * CLUSTER_SIZE;
+    int y0 = (cluster / mClustersX) * CLUSTER_SIZE;
+    return Rect{x0, y0, std::min(x0 + CLUSTER_SIZE, mWidth), std::min(y0 + CLUSTER_SIZE, mHeight)};
+}
+
+int HierarchicalPathfinder::ClusterOf(int32_t cell) const
+{
+    return ((cell / mWidth) / CLUSTER_SIZE) * mClustersX + (cell % mWidth) / CLUSTER_SIZE;
+}
+
+bool HierarchicalPathfinder::IsFree(int x, int y) const
+{
+    if (x < 0 || x >= mWidth || y < 0 || y >= mHeight) return false;
+
+    return mSolid[static_cast<size_t>(y) * mWidth + x] == 0;
+}
+
+float HierarchicalPathfinder::Heuristic(int32_t from, int32_t to) const
+{
+    // Octile distance, as in PathfindingService
+    int dx = std::abs(from % mWidth - to % mWidth);
+    int dy = std::abs(from / mWidth - to / mWidth);
+    return static_cast<float>(dx + dy) + (SQRT2 - 2.0f) * static_cast<float>(std::min(dx, dy));
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class TileMap;
+
+// HPA*: an abstract graph over the collision grid for long-distance paths.
+// The map is cut into CLUSTER_SIZE^2 clusters. Every run of open tiles along
+// a cluster border becomes one or two entrances, each a pair of nodes (one
+// tile on either side, linked at cost 1), and the nodes of a cluster are
+// linked by their shortest in-cluster path cost. A query only searches the
+// start and goal clusters on the grid and the small abstract graph in
+// between; turning the abstract path into tiles is left to RefineSegment,
+// one cluster at a time, when the agent gets there.
+// When collision changes, only the clusters whose tiles changed (and the
+// borders they share) are rebuilt.
+class HierarchicalPathfinder
+{
+public:
+    static const int CLUSTER_SIZE = 16;       // Tiles per cluster side
+    static const int LONG_ENTRANCE = 6;       // Runs this long get an entrance at each end
+
+    HierarchicalPathfinder();
+
+    // Main thread: builds the graph for the map, or patches it if the
+    // collision changed since the last call
+    void Sync(const TileMap& tileMap);
+
+    // Cells (row-major tile indices) of the entrance nodes the shortest
+    // abstract path goes through, ending with goal. False if unreachable.
+    bool FindAbstractPath(int32_t start, int32_t goal, std::vector<int32_t>& waypoints);
+    // Appends the tiles from 'from' (exclusive) to 'to', which must lie in
+    // one cluster or be neighbours (consecutive abstract waypoints are)
+    bool RefineSegment(int32_t from, int32_t to, std::vector<int32_t>& cells);
+
+    bool IsBuilt() const { return mWidth > 0; }
+    int GetClusterCount() const { return mClustersX * mClustersY; }
+    size_t GetNodeCount() const { return mNodes.size() - mFreeNodes.size(); }
+    size_t GetRebuiltClusters() const { return mRebuiltClusters; }  // Total, for profiling
+
+private:
+    struct Edge
+    {
+        int32_t to;
+        float cost;
+    };
+
+    struct Node
+    {
+        int32_t cell;
+        int32_t cluster;
+        int refs;                 // Entrances using this node; 0 = free slot
+        std::vector<Edge> edges;  // Inter-cluster link(s) and in-cluster paths
+    };
+
+    struct Entrance
+    {
+        int32_t nodeA;
+        int32_t nodeB;
+    };
+
+    struct Rect
+    {
+        int x0;
+        int y0;
+        int x1;  // Exclusive
+        int y1;
+    };
+
+    struct OpenNode
+    {
+        float f;
+        int32_t index;
+    };
+
+    // Graph building
+    void Build();
+    void RebuildClusters(const std::vector<int32_t>& dirtyClusters);
+    void BuildBorder(int cluster, int side);
+    void ClearBorder(int cluster, int side);
+    void AddEntrance(int border, int32_t cellA, int32_t cellB);
+    int32_t AcquireNode(int32_t cell);
+    void ReleaseNode(int32_t node);
+    void BuildClusterEdges(int cluster);
+
+    // Dijkstra inside one rectangle from source; early exit at target (-1 = none)
+    void SearchRect(const Rect& rect, int32_t source, int32_t target);
+    float RectCost(const Rect& rect, int32_t cell) const;  // After SearchRect, -1 if unreached
+    Rect ClusterRect(int cluster) const;
+    int ClusterOf(int32_t cell) const;
+    bool IsFree(int x, int y) const;
+    float Heuristic(int32_t from, int32_t to) const;
+
+    int mWidth;
+    int mHeight;
+    int mClustersX;
+    int mClustersY;
+    uint32_t mVersion;
+    std::vector<uint8_t> mSolid;  // Collision as of the last Sync, to find changed clusters
+
+    std::vector<Node> mNodes;
+    std::vector<int32_t> mFreeNodes;
+    std::vector<std::vector<int32_t>> mClusterNodes;
+    std::unordered_map<int32_t, int32_t> mNodeAtCell;
+    std::vector<std::vector<Entrance>> mBorders;  // Per cluster: [cluster * 2] east, [cluster * 2 + 1] south
+    size_t mRebuiltClusters;
+
+    // Scratch for SearchRect (one cluster's tiles)
+    std::vector<float> mRectCost;
+    std::vector<int32_t> mRectParent;
+    std::vector<OpenNode> mRectOpen;
+
+    // Scratch for the abstract search
+    std::vector<float> mNodeCost;
+    std::vector<int32_t> mNodeParent;
+    std::vector<uint8_t> mNodeClosed;
+    std::vector<OpenNode> mNodeOpen;
+};
@@ -0,0 +1,95 @@
+#include "LineOfSight.hpp"
+#include "../Map/TileMap.hpp"
+#include <cmath>
+
+namespace
+{
+    uint64_t PairKey(int32_t viewer, int32_t target)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(viewer)) << 32) | static_cast<uint32_t>(target);
+    }
+}
+
+LineOfSight::LineOfSight(float maxRange)
+    : mMaxRange(maxRange)
+    , mGrid(nullptr)
+    , mWidth(0)
+    , mHeight(0)
+    , mTileSize(1.0f)
+    , mTargetCell(-1)
+    , mVersion(0)
+    , mRaycasts(0)
+    , mCacheHits(0)
+{
+}
+
+void LineOfSight::SetTarget(const TileMap& tileMap, const Vector2& target)
+{
+    const CollisionGrid& grid = tileMap.GetCollisionGrid();
+    float tileSize = static_cast<float>(tileMap.GetTileSize());
+    if (&grid != mGrid || grid.GetWidth() != mWidth || grid.GetHeight() != mHeight || tileSize != mTileSize ||
+        tileMap.GetCollisionVersion() != mVersion)
+    {
+        mCache.clear();
+        mGrid = &grid;
+        mWidth = grid.GetWidth();
+        mHeight = grid.GetHeight();
+        mTileSize = tileSize;
+        mVersion = tileMap.GetCollisionVersion();
+    }
+
+    // Every cached pair has the old target cell in it
+    int32_t cell = CellAt(target);
+    if (cell != mTargetCell)
+    {
+        mCache.clear();
+        mTargetCell = cell;
+    }
+}
+
+void LineOfSight::Clear()
+{
+    mCache.clear();
+    mTargetCell = -1;
+}
+
+void LineOfSight::Resolve(const Vector2& viewer)
+{
+    int32_t cell = CellAt(viewer);
+    if (mTargetCell < 0 || cell < 0) return;
+
+    auto inserted = mCache.emplace(PairKey(cell, mTargetCell), false);
+    if (!inserted.second)
+    {
+        mCacheHits++;
+        return;
+    }
+
+    inserted.first->second = Cast(cell);
+    mRaycasts++;
+}
+
+bool LineOfSight::CanSeeTarget(const Vector2& viewer) const
+{
+    int32_t cell = CellAt(viewer);
+    if (mTargetCell < 0 || cell < 0) return false;
+
+    auto it = mCache.find(PairKey(cell, mTargetCell));
+    return it != mCache.end() ? it->second : Cast(cell);
+}
+
+int32_t LineOfSight::CellAt(const Vector2& position) const
+{
+    if (!mGrid) return -1;
+
+    int x = static_cast<int>(std::floor(position.x / mTileSize));
+    int y = static_cast<int>(std::floor(position.y / mTileSize));
+    if (x < 0 || x >= mWidth || y < 0 || y >= mHeight) return -1;
+
+    return y * mWidth + x;
+}
+
+bool LineOfSight::Cast(int32_t cell) const
+{
+    return mGrid->IsLineClear(cell % mWidth, cell / mWidth, mTargetCell % mWidth, mTargetCell / mWidth);
+}
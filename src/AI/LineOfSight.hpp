@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "../MathUtils.h"
+
+class TileMap;
+class CollisionGrid;
+
+// Whether a target (the player) can be seen from a viewer's tile, over the
+// collision grid. Answers are cached per (viewer cell, target cell) pair, so
+// a viewer standing still costs a lookup and a new ray is cast only when it
+// or the target changes tile; the target changing tile or the collision
+// changing drops the whole cache. Game resolves every viewer near the target
+// in one batch per step, after which lookups are read-only and safe from
+// parallel actor updates.
+class LineOfSight
+{
+public:
+    static constexpr float DEFAULT_MAX_RANGE = 480.0f;  // Pixels around the target resolved per step
+
+    explicit LineOfSight(float maxRange = DEFAULT_MAX_RANGE);
+
+    // Main thread, once per step, before any Resolve
+    void SetTarget(const TileMap& tileMap, const Vector2& target);
+    void Clear();
+    // Main thread: casts (or reuses) the ray from viewer to the target
+    void Resolve(const Vector2& viewer);
+
+    // True if nothing solid lies between viewer's tile and the target's.
+    // Viewers not resolved this step are cast on the spot, uncached.
+    bool CanSeeTarget(const Vector2& viewer) const;
+
+    float GetMaxRange() const { return mMaxRange; }
+    size_t GetRaycasts() const { return mRaycasts; }
+    size_t GetCacheHits() const { return mCacheHits; }
+
+private:
+    int32_t CellAt(const Vector2& position) const;
+    bool Cast(int32_t cell) const;
+
+    float mMaxRange;
+    const CollisionGrid* mGrid;  // Of the map the target is on
+    int mWidth;
+    int mHeight;
+    float mTileSize;
+    int32_t mTargetCell;  // -1 while there is no target
+    uint32_t mVersion;    // Collision version the cache was filled on
+
+    // (viewer cell << 32 | target cell) -> visible
+    std::unordered_map<uint64_t, bool> mCache;
+    size_t mRaycasts;
+    size_t mCacheHits;
+};
@@ -0,0 +1,473 @@
+#include "PathfindingService.hpp"
+#include "../Map/TileMap.hpp"
+#include "../Game/CommandBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    const float SQRT2 = 1.41421356f;
+
+    const int NEIGHBOUR_X[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    const int NEIGHBOUR_Y[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+    // Octile distance: diagonal steps cost sqrt(2), straight ones 1
+    float OctileDistance(int32_t a, int32_t b, int width)
+    {
+        int dx = std::abs(a % width - b % width);
+        int dy = std::abs(a / width - b / width);
+        return static_cast<float>(dx + dy) + (SQRT2 - 2.0f) * static_cast<float>(std::min(dx, dy));
+    }
+}
+
+PathfindingService::PathfindingService(const TileMap* tileMap)
+    : mTileMap(tileMap)
+    , mExpansionBudget(DEFAULT_EXPANSION_BUDGET)
+    , mLongPathSegments(DEFAULT_LONG_PATH_SEGMENTS)
+    , mLongPathTiles(DEFAULT_LONG_PATH_TILES)
+    , mNextTicket(1)
+    , mCacheCapacity(DEFAULT_CACHE_CAPACITY)
+    , mCacheHits(0)
+    , mSearches(0)
+    , mLongSearches(0)
+    , mGridWidth(0)
+    , mGridHeight(0)
+    , mStamp(0)
+    , mSearching(false)
+    , mSearchKey{-1, -1, 0}
+    , mSearchVersion(0)
+    , mExpanded(0)
+{
+}
+
+int32_t PathfindingService::CellAt(const Vector2& position) const
+{
+    const CollisionGrid& grid = mTileMap->GetCollisionGrid();
+    float tileSize = static_cast<float>(mTileMap->GetTileSize());
+    int x = static_cast<int>(std::floor(position.x / tileSize));
+    int y = static_cast<int>(std::floor(position.y / tileSize));
+    if (x < 0 || x >= grid.GetWidth() || y < 0 || y >= grid.GetHeight()) return -1;
+
+    return y * grid.GetWidth() + x;
+}
+
+uint32_t PathfindingService::RequestPath(const Vector2& start, const Vector2& goal)
+{
+    if (!mTileMap) return 0;
+
+    PathKey key{CellAt(start), CellAt(goal), mTileMap->GetCollisionVersion()};
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    uint32_t id = mNextTicket++;
+    if (mNextTicket == DEFERRED_TICKET) mNextTicket = 1;  // Neither 0 nor DEFERRED_TICKET is ever handed out
+
+    Ticket& ticket = mTickets[id];
+    ticket.key = key;
+    ticket.goal = goal;
+    ticket.status = PathStatus::Pending;
+
+    if (key.start < 0 || key.goal < 0)
+    {
+        ticket.status = PathStatus::Failed;
+    }
+    else if (key.start == key.goal)
+    {
+        // Same cell: walk straight to the goal
+        ticket.status = PathStatus::Ready;
+        ticket.cells = std::make_shared<const PathCells>(PathCells{{}, false});
+    }
+    else if (LookupCache(key, ticket.cells))
+    {
+        ticket.status = ticket.cells ? PathStatus::Ready : PathStatus::Failed;
+    }
+    else
+    {
+        // Identical requests share one search
+        std::vector<uint32_t>& waiting = mWaiting[key];
+        if (waiting.empty())
+        {
+            mQueue.push_back(key);
+        }
+        waiting.push_back(id);
+    }
+
+    return id;
+}
+
+void PathfindingService::RequestPath(const Vector2& start, const Vector2& goal, uint32_t* ticket)
+{
+    // Inside a parallel update: enter the queue at the sync point, in batch order
+    if (CommandBuffer* commands = CommandBuffer::Current())
+    {
+        *ticket = DEFERRED_TICKET;
+        commands->RequestPath(this, start, goal, ticket);
+        return;
+    }
+
+    *ticket = RequestPath(start, goal);
+}
+
+PathStatus PathfindingService::TakePath(uint32_t id, std::vector<Vector2>& waypoints, bool* complete)
+{
+    if (id == DEFERRED_TICKET) return PathStatus::Pending;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mTickets.find(id);
+    if (it == mTickets.end()) return PathStatus::None;
+
+    const Ticket& ticket = it->second;
+    PathStatus status = ticket.status;
+    if (status == PathStatus::Pending) return status;
+
+    if (status == PathStatus::Ready)
+    {
+        const int width = mTileMap->GetCollisionGrid().GetWidth();
+        const float tileSize = static_cast<float>(mTileMap->GetTileSize());
+
+        waypoints.clear();
+        for (int32_t cell : ticket.cells->cells)
+        {
+            waypoints.emplace_back((cell % width + 0.5f) * tileSize, (cell / width + 0.5f) * tileSize);
+        }
+
+        // The goal cell's center becomes the exact goal
+        if (!ticket.cells->partial)
+        {
+            if (!waypoints.empty())
+            {
+                waypoints.pop_back();
+            }
+            waypoints.push_back(ticket.goal);
+        }
+        if (complete)
+        {
+            *complete = !ticket.cells->partial;
+        }
+    }
+
+    mTickets.erase(it);
+    return status;
+}
+
+void PathfindingService::Cancel(uint32_t id)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    // Its search stays queued; it is skipped if nobody else waits for it
+    mTickets.erase(id);
+}
+
+size_t PathfindingService::GetQueueLength() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mQueue.size() + (mSearching ? 1 : 0);
+}
+
+void PathfindingService::SetCacheCapacity(size_t paths)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCacheCapacity = paths;
+    while (mCacheOrder.size() > mCacheCapacity)
+    {
+        mCache.erase(mCacheOrder.back().key);
+        mCacheOrder.pop_back();
+    }
+}
+
+void PathfindingService::Update()
+{
+    if (!mTileMap) return;
+
+    const uint32_t version = mTileMap->GetCollisionVersion();
+    // Counted in nodes rather than time, so how far the queue gets in a step
+    // does not depend on the machine or on what else is running
+    int budget = mExpansionBudget;
+
+    // Patches only the clusters whose collision changed
+    mHierarchy.Sync(*mTileMap);
+
+    while (budget > 0)
+    {
+        // The grid changed under a paused search: start it over
+        if (mSearching && mSearchVersion != version)
+        {
+            BeginSearch(mSearchKey);
+        }
+
+        if (!mSearching)
+        {
+            PathKey key{};
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (!PopQueued(key)) return;
+
+                // Queued before the grid changed: a search on the current grid may be cached
+                CellPath cells;
+                if (key.version != version && LookupCache(PathKey{key.start, key.goal, version}, cells))
+                {
+                    Resolve(key, cells);
+                    continue;
+                }
+            }
+
+            // Far goals: one hierarchical query instead of a long grid search.
+            // It runs unlocked (the hierarchy is main thread only), so parallel
+            // TakePath/Cancel calls do not wait for it.
+            if (key.start >= 0 && key.goal >= 0 && mHierarchy.IsBuilt() &&
+                OctileDistance(key.start, key.goal, mTileMap->GetCollisionGrid().GetWidth()) >
+                    static_cast<float>(mLongPathTiles))
+            {
+                CellPath cells = FindLongPath(key, budget);
+
+                std::lock_guard<std::mutex> lock(mMutex);
+                StoreCache(PathKey{key.start, key.goal, version}, cells);
+                Resolve(key, cells);
+                continue;
+            }
+
+            BeginSearch(key);
+        }
+
+        if (StepSearch(budget))
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            StoreCache(PathKey{mSearchKey.start, mSearchKey.goal, mSearchVersion}, mSearchResult);
+            Resolve(mSearchKey, mSearchResult);
+            mSearching = false;
+            mSearchResult.reset();
+        }
+    }
+}
+
+void PathfindingService::BeginSearch(const PathKey& key)
+{
+    const CollisionGrid& grid = mTileMap->GetCollisionGrid();
+    if (grid.GetWidth() != mGridWidth || grid.GetHeight() != mGridHeight)
+    {
+        mGridWidth = grid.GetWidth();
+        mGridHeight = grid.GetHeight();
+        size_t cells = static_cast<size_t>(mGridWidth) * mGridHeight;
+        mCost.assign(cells, 0.0f);
+        mParent.assign(cells, -1);
+        mOpenStamp.assign(cells, 0);
+        mClosedStamp.assign(cells, 0);
+        mStamp = 0;
+    }
+
+    // New stamp invalidates every node of the previous search
+    mStamp++;
+    if (mStamp == 0)
+    {
+        std::fill(mOpenStamp.begin(), mOpenStamp.end(), 0);
+        std::fill(mClosedStamp.begin(), mClosedStamp.end(), 0);
+        mStamp = 1;
+    }
+
+    mSearching = true;
+    mSearchKey = key;
+    mSearchVersion = mTileMap->GetCollisionVersion();
+    mSearchResult.reset();
+    mExpanded = 0;
+    mOpen.clear();
+    mSearches++;
+
+    size_t cells = static_cast<size_t>(mGridWidth) * mGridHeight;
+    if (key.start < 0 || key.goal < 0 || static_cast<size_t>(std::max(key.start, key.goal)) >= cells) return;
+    // A blocked goal leaves the open list empty, which fails on the first step
+    if (!IsFree(key.goal % mGridWidth, key.goal / mGridWidth)) return;
+
+    // The start may be inside a wall (pushed there); it is expanded anyway
+    mCost[key.start] = 0.0f;
+    mParent[key.start] = -1;
+    mOpenStamp[key.start] = mStamp;
+    mOpen.push_back({Heuristic(key.start, key.goal), key.start});
+}
+
+bool PathfindingService::StepSearch(int& budget)
+{
+    auto heapOrder = [](const OpenNode& a, const OpenNode& b) { return a.f > b.f; };  // Min-heap on f
+    const int32_t goal = mSearchKey.goal;
+
+    for (; budget > 0; budget--)
+    {
+        if (mOpen.empty()) return true;  // Unreachable
+
+        std::pop_heap(mOpen.begin(), mOpen.end(), heapOrder);
+        int32_t cell = mOpen.back().cell;
+        mOpen.pop_back();
+
+        // Stale heap entry (the cell was reached again more cheaply)
+        if (mClosedStamp[cell] == mStamp) continue;
+        mClosedStamp[cell] = mStamp;
+
+        if (cell == goal)
+        {
+            mSearchResult = BuildPath(goal);
+            return true;
+        }
+        if (++mExpanded > MAX_SEARCH_NODES) return true;
+
+        int x = cell % mGridWidth;
+        int y = cell / mGridWidth;
+        for (int n = 0; n < 8; n++)
+        {
+            int nx = x + NEIGHBOUR_X[n];
+            int ny = y + NEIGHBOUR_Y[n];
+            if (!IsFree(nx, ny)) continue;
+
+            // No cutting corners: both orthogonal neighbours must be free
+            bool diagonal = n >= 4;
+            if (diagonal && (!IsFree(nx, y) || !IsFree(x, ny))) continue;
+
+            int32_t next = ny * mGridWidth + nx;
+            if (mClosedStamp[next] == mStamp) continue;
+
+            float cost = mCost[cell] + (diagonal ? SQRT2 : 1.0f);
+            if (mOpenStamp[next] != mStamp || cost < mCost[next])
+            {
+                mOpenStamp[next] = mStamp;
+                mCost[next] = cost;
+                mParent[next] = cell;
+                mOpen.push_back({cost + Heuristic(next, goal), next});
+                std::push_heap(mOpen.begin(), mOpen.end(), heapOrder);
+            }
+        }
+    }
+
+    return false;
+}
+
+PathfindingService::CellPath PathfindingService::BuildPath(int32_t goal) const
+{
+    std::vector<int32_t> cells;
+    for (int32_t cell = goal; cell != -1; cell = mParent[cell])
+    {
+        cells.push_back(cell);
+    }
+    std::reverse(cells.begin(), cells.end());
+    return MakePath(cells, false);
+}
+
+PathfindingService::CellPath PathfindingService::FindLongPath(const PathKey& key, int& budget)
+{
+    // Each refined segment is a search over at most a cluster's tiles, and
+    // the abstract search is charged as one more
+    const int segmentCost = HierarchicalPathfinder::CLUSTER_SIZE * HierarchicalPathfinder::CLUSTER_SIZE;
+    mLongSearches++;
+    budget -= segmentCost;
+
+    if (!mHierarchy.FindAbstractPath(key.start, key.goal, mAbstractPath)) return nullptr;
+
+    // Refine the first segments of the route; the rest is refined when the
+    // caller asks again from where this one ends
+    mRefined.assign(1, key.start);
+    int32_t from = key.start;
+    bool partial = false;
+    int refined = 0;
+    for (size_t i = 0; i < mAbstractPath.size(); i++)
+    {
+        // Always make some progress (the start may itself be an entrance)
+        if (refined >= mLongPathSegments && mRefined.size() > 1)
+        {
+            partial = true;
+            break;
+        }
+
+        if (!mHierarchy.RefineSegment(from, mAbstractPath[i], mRefined)) return nullptr;
+        from = mAbstractPath[i];
+        refined++;
+        budget -= segmentCost;
+    }
+    return MakePath(mRefined, partial);
+}
+
+PathfindingService::CellPath PathfindingService::MakePath(const std::vector<int32_t>& cells, bool partial)
+{
+    // Keep only the cells where the direction changes (and the last one)
+    auto path = std::make_shared<PathCells>();
+    path->partial = partial;
+    for (size_t i = 1; i < cells.size(); i++)
+    {
+        if (i + 1 < cells.size() && cells[i] - cells[i - 1] == cells[i + 1] - cells[i]) continue;
+
+        path->cells.push_back(cells[i]);
+    }
+    return path;
+}
+
+float PathfindingService::Heuristic(int32_t cell, int32_t goal) const
+{
+    return OctileDistance(cell, goal, mGridWidth);
+}
+
+bool PathfindingService::IsFree(int x, int y) const
+{
+    return !mTileMap->GetCollisionGrid().IsSolid(x, y);
+}
+
+bool PathfindingService::PopQueued(PathKey& key)
+{
+    while (!mQueue.empty())
+    {
+        key = mQueue.front();
+        mQueue.pop_front();
+
+        auto waiting = mWaiting.find(key);
+        if (waiting == mWaiting.end()) continue;
+
+        for (uint32_t id : waiting->second)
+        {
+            if (mTickets.count(id) != 0) return true;
+        }
+        mWaiting.erase(waiting);
+    }
+    return false;
+}
+
+bool PathfindingService::LookupCache(const PathKey& key, CellPath& cells)
+{
+    auto it = mCache.find(key);
+    if (it == mCache.end()) return false;
+
+    mCacheOrder.splice(mCacheOrder.begin(), mCacheOrder, it->second);
+    cells = it->second->cells;
+    mCacheHits++;
+    return true;
+}
+
+void PathfindingService::StoreCache(const PathKey& key, const CellPath& cells)
+{
+    if (mCacheCapacity == 0) return;
+
+    auto it = mCache.find(key);
+    if (it != mCache.end())
+    {
+        it->second->cells = cells;
+        mCacheOrder.splice(mCacheOrder.begin(), mCacheOrder, it->second);
+        return;
+    }
+
+    mCacheOrder.push_front({key, cells});
+    mCache[key] = mCacheOrder.begin();
+    while (mCacheOrder.size() > mCacheCapacity)
+    {
+        mCache.erase(mCacheOrder.back().key);
+        mCacheOrder.pop_back();
+    }
+}
+
+void PathfindingService::Resolve(const PathKey& key, const CellPath& cells)
+{
+    auto waiting = mWaiting.find(key);
+    if (waiting == mWaiting.end()) return;
+
+    for (uint32_t id : waiting->second)
+    {
+        auto ticket = mTickets.find(id);
+        if (ticket == mTickets.end()) continue;  // Cancelled
+
+        ticket->second.status = cells ? PathStatus::Ready : PathStatus::Failed;
+        ticket->second.cells = cells;
+    }
+    mWaiting.erase(waiting);
+}
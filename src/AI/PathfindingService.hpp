@@ -0,0 +1,190 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "HierarchicalPathfinder.hpp"
+#include "../MathUtils.h"
+
+class TileMap;
+
+enum class PathStatus
+{
+    None,     // Unknown or already taken ticket
+    Pending,  // Queued or being searched
+    Ready,
+    Failed    // Goal blocked or unreachable
+};
+
+// A* over the TileMap collision grid, shared by every NPC.
+// Requests return a ticket and are answered asynchronously: Update runs the
+// queued searches on the main thread until a per-step budget of node
+// expansions is spent, pausing a long search and resuming it next step. Node storage is pooled
+// across searches (stamped, never cleared), and finished paths are kept in
+// an LRU cache keyed by (start cell, goal cell, collision version), so NPCs
+// re-planning toward the same cells cost a lookup.
+// Goals further than DEFAULT_LONG_PATH_TILES away are answered from a hierarchical
+// (HPA*) graph instead, in one go: only the first clusters of the route are
+// turned into tiles, up to a per-query number of segments, and the path is
+// marked incomplete so the caller asks again from its end.
+// Requests made from a parallel actor update are recorded in the thread's
+// CommandBuffer and enter the service when Game replays the buffers, so
+// ticket ids, cache order and queue order follow batch order, not thread
+// timing. TakePath/Cancel may be called from parallel actor updates.
+class PathfindingService
+{
+public:
+    static const int DEFAULT_EXPANSION_BUDGET = 8192;    // Nodes expanded per step
+    static const size_t DEFAULT_CACHE_CAPACITY = 512;    // Paths
+    static const int MAX_SEARCH_NODES = 1 << 16;         // Expansions before giving up
+    static const int DEFAULT_LONG_PATH_TILES = 2 * HierarchicalPathfinder::CLUSTER_SIZE;  // Octile distance
+    static const int DEFAULT_LONG_PATH_SEGMENTS = 4;     // Abstract segments refined per hierarchical query
+    static const uint32_t DEFERRED_TICKET = 0xFFFFFFFFu;  // Recorded, not yet replayed (never a real ticket)
+
+    explicit PathfindingService(const TileMap* tileMap);
+
+    // Main thread: returns a ticket (answered from the cache right away when possible)
+    uint32_t RequestPath(const Vector2& start, const Vector2& goal);
+    // From an actor update: writes the ticket to *ticket. Inside a parallel
+    // batch the request is recorded instead and *ticket reads DEFERRED_TICKET
+    // until the sync point; a request superseded or cleared (*ticket changed)
+    // before then is dropped.
+    void RequestPath(const Vector2& start, const Vector2& goal, uint32_t* ticket);
+    // Ready: fills waypoints (tile centers after the start cell, the last one
+    // being goal itself) and releases the ticket. Failed also releases it.
+    // A long path may stop short of the goal (complete = false); its last
+    // waypoint is then a tile center to request the rest from.
+    // DEFERRED_TICKET reads as Pending.
+    PathStatus TakePath(uint32_t ticket, std::vector<Vector2>& waypoints, bool* complete = nullptr);
+    // Drops a ticket that is no longer wanted
+    void Cancel(uint32_t ticket);
+
+    // Main thread, once per step: works through the queue within the budget
+    void Update();
+
+    void SetBudget(int expansions) { mExpansionBudget = expansions; }
+    void SetLongPathSegments(int segments) { mLongPathSegments = segments; }
+    void SetLongPathTiles(int tiles) { mLongPathTiles = tiles; }
+    void SetCacheCapacity(size_t paths);
+
+    size_t GetCacheHits() const { return mCacheHits; }
+    size_t GetSearches() const { return mSearches; }
+    size_t GetLongSearches() const { return mLongSearches; }
+    const HierarchicalPathfinder& GetHierarchy() const { return mHierarchy; }
+    size_t GetQueueLength() const;
+
+private:
+    struct PathKey
+    {
+        int32_t start;  // Cell indices
+        int32_t goal;
+        uint32_t version;
+
+        bool operator==(const PathKey& other) const
+        {
+            return start == other.start && goal == other.goal && version == other.version;
+        }
+    };
+
+    struct PathKeyHash
+    {
+        size_t operator()(const PathKey& key) const
+        {
+            uint64_t cells = (static_cast<uint64_t>(static_cast<uint32_t>(key.start)) << 32) |
+                             static_cast<uint32_t>(key.goal);
+            return static_cast<size_t>((cells ^ (static_cast<uint64_t>(key.version) * 0x9E3779B97F4A7C15ull)) *
+                                       0xBF58476D1CE4E5B9ull >> 17);
+        }
+    };
+
+    // Cell indices from start (exclusive) to goal, collinear cells removed;
+    // partial if it stops short of the goal. Null for an unreachable goal.
+    struct PathCells
+    {
+        std::vector<int32_t> cells;
+        bool partial;
+    };
+    using CellPath = std::shared_ptr<const PathCells>;
+
+    struct Ticket
+    {
+        PathKey key;
+        Vector2 goal;
+        PathStatus status;
+        CellPath cells;
+    };
+
+    struct CacheEntry
+    {
+        PathKey key;
+        CellPath cells;
+    };
+
+    struct OpenNode
+    {
+        float f;
+        int32_t cell;
+    };
+
+    // -1 outside the grid
+    int32_t CellAt(const Vector2& position) const;
+
+    // Search (main thread only)
+    void BeginSearch(const PathKey& key);
+    bool StepSearch(int& budget);  // Spends one per node popped; true once the search has finished
+    CellPath BuildPath(int32_t goal) const;
+    CellPath FindLongPath(const PathKey& key, int& budget);  // Hierarchical, up to mLongPathSegments
+    static CellPath MakePath(const std::vector<int32_t>& cells, bool partial);  // cells[0] = start
+    float Heuristic(int32_t cell, int32_t goal) const;
+    bool IsFree(int x, int y) const;
+
+    // Under mMutex
+    bool PopQueued(PathKey& key);  // Next key somebody still waits for
+    bool LookupCache(const PathKey& key, CellPath& cells);
+    void StoreCache(const PathKey& key, const CellPath& cells);
+    void Resolve(const PathKey& key, const CellPath& cells);
+
+    const TileMap* mTileMap;
+    int mExpansionBudget;
+    int mLongPathSegments;
+    int mLongPathTiles;
+
+    // Tickets, queue and cache
+    mutable std::mutex mMutex;
+    uint32_t mNextTicket;
+    std::unordered_map<uint32_t, Ticket> mTickets;
+    std::unordered_map<PathKey, std::vector<uint32_t>, PathKeyHash> mWaiting;  // Tickets per queued key
+    std::deque<PathKey> mQueue;
+    std::list<CacheEntry> mCacheOrder;  // Most recently used first
+    std::unordered_map<PathKey, std::list<CacheEntry>::iterator, PathKeyHash> mCache;
+    size_t mCacheCapacity;
+    size_t mCacheHits;
+    size_t mSearches;
+    size_t mLongSearches;
+
+    // Pooled node storage; a cell belongs to the current search only if its
+    // stamp matches, so nothing is cleared between searches
+    int mGridWidth;
+    int mGridHeight;
+    std::vector<float> mCost;
+    std::vector<int32_t> mParent;
+    std::vector<uint32_t> mOpenStamp;
+    std::vector<uint32_t> mClosedStamp;
+    std::vector<OpenNode> mOpen;  // Binary heap, stale entries skipped on pop
+    uint32_t mStamp;
+
+    // The search in progress (may span several steps)
+    bool mSearching;
+    PathKey mSearchKey;        // As requested (the waiting tickets' key)
+    uint32_t mSearchVersion;   // Grid version the search runs on
+    CellPath mSearchResult;
+    int mExpanded;
+
+    // Abstract graph for long paths (main thread only)
+    HierarchicalPathfinder mHierarchy;
+    std::vector<int32_t> mAbstractPath;
+    std::vector<int32_t> mRefined;
+};
@@ -9,11 +9,14 @@
 #include <SDL_stdinc.h>
 
 Actor::Actor(Game* game)
-    : mState(ActorState::Active)
+    : mGame(game)
+    , mState(ActorState::Active)
     , mPosition(Vector2::Zero)
+    , mPreviousPosition(Vector2::Zero)
     , mScale(Vector2(1.0f, 1.0f))
     , mRotation(0.0f)
-    , mGame(game)
+    , mComponentLookup{}
+    , mComponentMask(0)
 {
     // Game now manages Actor lifetime through smart pointers
 }
@@ -28,16 +31,28 @@ void Actor::Update(float deltaTime)
 {
     if (mState == ActorState::Active)
     {
-        // Update all components first
+        // Update all components first (pooled ones are stepped by Game's systems)
         for (auto& comp : mComponents)
         {
-            comp->Update(deltaTime);
+            if (!comp->IsUpdatedBySystem())
+            {
+                comp->Update(deltaTime);
+            }
         }
         // Then call the actor's own update
         OnUpdate(deltaTime);
     }
 }
 
+void Actor::SetState(ActorState state)
+{
+    if (state == ActorState::Destroy && mState != ActorState::Destroy && mGame)
+    {
+        mGame->QueueDestroy(this);
+    }
+    mState = state;
+}
+
 void Actor::OnUpdate(float deltaTime)
 {
     // Base implementation does nothing
@@ -69,6 +84,13 @@ void Actor::OnDraw(class TextRenderer* textRenderer)
 
 void Actor::AddComponent(std::unique_ptr<Component> c)
 {
+    ComponentType type = c->GetType();
+    if (type != ComponentType::Count && !(mComponentMask & ComponentBit(type)))
+    {
+        mComponentLookup[static_cast<size_t>(type)] = c.get();
+        mComponentMask |= ComponentBit(type);
+    }
+
     mComponents.push_back(std::move(c));
     std::sort(mComponents.begin(), mComponents.end(), 
         [](const std::unique_ptr<Component>& a, const std::unique_ptr<Component>& b) {
@@ -76,6 +98,16 @@ void Actor::AddComponent(std::unique_ptr<Component> c)
         });
 }
 
+Vector2 Actor::GetRenderPosition() const
+{
+    if (!mGame)
+    {
+        return mPosition;
+    }
+
+    return Vector2::Lerp(mPreviousPosition, mPosition, mGame->GetRenderAlpha());
+}
+
 Matrix4 Actor::GetModelMatrix() const
 {
     Matrix4 scaleMat = Matrix4::CreateScale(mScale.x, mScale.y, 1.0f);
@@ -4,13 +4,15 @@
 
 #pragma once
 #include <vector>
+#include <array>
 #include <cstdint>
 #include <memory>
 #include "../MathUtils.h"
+#include "../Component/Component.hpp"
+#include "ActorHandle.hpp"
 
 // Forward declarations
 class Game;
-class Component;
 
 bool ComponentUpdateOrderCompare(Component* a, Component* b);
 
@@ -21,6 +23,21 @@ enum class ActorState
     Destroy
 };
 
+// Coarse actor categories (bit flags) used to filter spatial queries
+namespace ActorKind
+{
+    enum : uint32_t
+    {
+        None       = 0,
+        Player     = 1u << 0,
+        Item       = 1u << 1,
+        NPC        = 1u << 2,
+        DialogNPC  = 1u << 3,
+        Damageable = 1u << 4,  // Has a HealthComponent
+        All        = 0xFFFFFFFFu
+    };
+}
+
 class Actor
 {
 public:
@@ -32,9 +49,20 @@ public:
     // ProcessInput function called from Game (not overridable)
     void ProcessInput(const uint8_t* keyState);
 
-    // Position getter/setter
+    // Position getter/setter. SetPosition places the actor (spawns,
+    // teleports), so rendering does not interpolate from where it was.
     const Vector2& GetPosition() const { return mPosition; }
-    void SetPosition(const Vector2& pos) { mPosition = pos; }
+    void SetPosition(const Vector2& pos) { mPosition = pos; mPreviousPosition = pos; }
+    // Moves the actor within the current step; rendering interpolates from
+    // its position at the start of the step
+    void MoveTo(const Vector2& pos) { mPosition = pos; }
+
+    // Position at the start of the current simulation step (for render interpolation)
+    const Vector2& GetPreviousPosition() const { return mPreviousPosition; }
+    // Snapshot the current transform as the previous simulation state
+    void SaveTransform() { mPreviousPosition = mPosition; }
+    // Position interpolated between the last two simulation states
+    Vector2 GetRenderPosition() const;
 
     // Scale getter/setter
     const Vector2& GetScale() const { return mScale; }
@@ -44,9 +72,12 @@ public:
     float GetRotation() const { return mRotation; }
     void SetRotation(float rotation) { mRotation = rotation; }
 
-    // State getter/setter
+    // State getter/setter (setting Destroy queues the actor for removal)
     ActorState GetState() const { return mState; }
-    void SetState(ActorState state) { mState = state; }
+    void SetState(ActorState state);
+
+    // Handle assigned by Game once the actor is in the world (invalid while pending)
+    ActorHandle GetHandle() const { return mHandle; }
 
     // Get Forward vector
     Vector2 GetForward() const
@@ -63,20 +94,42 @@ public:
     // Components getter
     const std::vector<std::unique_ptr<Component>>& GetComponents() const { return mComponents; }
 
-    // Returns component of type T, or null if doesn't exist
+    // Returns component of type T, or null if doesn't exist.
+    // Typed components come straight from the lookup table; others fall back to a scan.
     template <typename T>
     T* GetComponent() const
     {
-        for (auto& comp : mComponents)
+        if constexpr (HasComponentType<T>::value)
+        {
+            return static_cast<T*>(mComponentLookup[static_cast<size_t>(T::StaticType)]);
+        }
+        else
         {
-            T* t = dynamic_cast<T*>(comp.get());
-            if (t)
+            for (auto& comp : mComponents)
             {
-                return t;
+                T* t = dynamic_cast<T*>(comp.get());
+                if (t)
+                {
+                    return t;
+                }
             }
+
+            return nullptr;
+        }
+    }
+
+    // Cheap "has component" query (a single mask test for typed components)
+    template <typename T>
+    bool HasComponent() const
+    {
+        if constexpr (HasComponentType<T>::value)
+        {
+            return (mComponentMask & ComponentBit(T::StaticType)) != 0;
+        }
+        else
+        {
+            return GetComponent<T>() != nullptr;
         }
-        
-        return nullptr;
     }
 
     // Add a component and return a pointer to it
@@ -92,6 +145,20 @@ public:
     // Drawing method for rendering
     virtual void OnDraw(class TextRenderer* textRenderer);
 
+    // True if Update only writes this actor's own state (reading others is fine,
+    // mutating them goes through the thread's CommandBuffer). Such actors are
+    // updated in parallel batches after the serial ones.
+    virtual bool CanUpdateInParallel() const { return false; }
+
+    // ActorKind flags of the concrete type
+    virtual uint32_t GetKind() const { return ActorKind::None; }
+    // GetKind plus the flags derived from components (Damageable)
+    uint32_t GetKindMask() const
+    {
+        uint32_t damageable = (mComponentMask & ComponentBit(ComponentType::Health)) ? ActorKind::Damageable : ActorKind::None;
+        return GetKind() | damageable;
+    }
+
 protected:
     class Game* mGame;
 
@@ -105,14 +172,23 @@ protected:
 
     // Transform
     Vector2 mPosition;
+    Vector2 mPreviousPosition;
     Vector2 mScale;
     float mRotation;
 
     // Components
     std::vector<std::unique_ptr<Component>> mComponents;
+    // Typed components by ComponentType (first one added of each type)
+    std::array<Component*, static_cast<size_t>(ComponentType::Count)> mComponentLookup;
+    uint32_t mComponentMask;
+
+    static constexpr uint32_t ComponentBit(ComponentType type) { return 1u << static_cast<uint32_t>(type); }
 
 private:
     friend class Component;
+    friend class ActorSlotMap;
+
+    ActorHandle mHandle;
 
     // Adds component to Actor (this is automatically called
     // in the component constructor)
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+// Stable 32-bit reference to an actor owned by Game.
+// The low bits index a slot, the high bits hold that slot's generation when the
+// handle was issued. Once the actor is removed the slot's generation moves on,
+// so old handles resolve to null instead of dangling.
+class ActorHandle
+{
+public:
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+    ActorHandle() = default;
+    ActorHandle(uint32_t index, uint32_t generation)
+        : mID((generation << INDEX_BITS) | (index & INDEX_MASK))
+    {
+    }
+
+    // Returns true if this handle was ever issued (it may still be stale)
+    bool IsValid() const { return mID != 0; }
+
+    // Resets to an invalid handle
+    void Reset() { mID = 0; }
+
+    uint32_t GetIndex() const { return mID & INDEX_MASK; }
+    uint32_t GetGeneration() const { return mID >> INDEX_BITS; }
+    uint32_t GetID() const { return mID; }
+
+    bool operator==(const ActorHandle& rhs) const { return mID == rhs.mID; }
+    bool operator!=(const ActorHandle& rhs) const { return mID != rhs.mID; }
+
+private:
+    // Generations start at 1, so 0 is never a live handle
+    uint32_t mID = 0;
+};
+
+namespace std
+{
+    template <>
+    struct hash<ActorHandle>
+    {
+        size_t operator()(const ActorHandle& handle) const { return hash<uint32_t>()(handle.GetID()); }
+    };
+}
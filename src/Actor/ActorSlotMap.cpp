@@ -0,0 +1,120 @@
+#include "ActorSlotMap.hpp"
+#include "Actor.hpp"
+#include <SDL.h>
+
+ActorSlotMap::~ActorSlotMap()
+{
+    Clear();
+}
+
+void ActorSlotMap::ReleaseSlot(uint32_t slotIndex)
+{
+    // Wrapping would bring back the generations of old handles. Generation 0
+    // is never handed out, so a retired slot matches no handle at all.
+    Slot& slot = mSlots[slotIndex];
+    if (slot.generation == ActorHandle::GENERATION_MASK)
+    {
+        slot.generation = 0;
+        return;
+    }
+    slot.generation++;
+    mFreeSlots.push_back(slotIndex);
+}
+
+ActorHandle ActorSlotMap::Insert(std::unique_ptr<Actor> actor)
+{
+    if (!actor)
+    {
+        return ActorHandle();
+    }
+
+    uint32_t slotIndex;
+    if (!mFreeSlots.empty())
+    {
+        slotIndex = mFreeSlots.front();
+        mFreeSlots.pop_front();
+    }
+    else
+    {
+        if (mSlots.size() >= MAX_ACTORS)
+        {
+            SDL_Log("ActorSlotMap: actor limit (%u) reached, dropping actor", MAX_ACTORS);
+            return ActorHandle();
+        }
+        slotIndex = static_cast<uint32_t>(mSlots.size());
+        mSlots.push_back({0, 1});
+    }
+
+    Slot& slot = mSlots[slotIndex];
+    slot.denseIndex = static_cast<uint32_t>(mDense.size());
+
+    ActorHandle handle(slotIndex, slot.generation);
+    actor->mHandle = handle;
+    mDense.emplace_back(std::move(actor));
+    mDenseToSlot.push_back(slotIndex);
+    return handle;
+}
+
+std::unique_ptr<Actor> ActorSlotMap::Remove(ActorHandle handle)
+{
+    if (!Contains(handle))
+    {
+        return nullptr;
+    }
+
+    Slot& slot = mSlots[handle.GetIndex()];
+    uint32_t denseIndex = slot.denseIndex;
+    uint32_t lastIndex = static_cast<uint32_t>(mDense.size() - 1);
+
+    std::unique_ptr<Actor> actor = std::move(mDense[denseIndex]);
+
+    // Fill the hole with the last actor
+    if (denseIndex != lastIndex)
+    {
+        mDense[denseIndex] = std::move(mDense[lastIndex]);
+        mDenseToSlot[denseIndex] = mDenseToSlot[lastIndex];
+        mSlots[mDenseToSlot[denseIndex]].denseIndex = denseIndex;
+    }
+    mDense.pop_back();
+    mDenseToSlot.pop_back();
+
+    ReleaseSlot(handle.GetIndex());
+
+    actor->mHandle.Reset();
+    return actor;
+}
+
+Actor* ActorSlotMap::Get(ActorHandle handle) const
+{
+    if (!handle.IsValid())
+    {
+        return nullptr;
+    }
+
+    uint32_t index = handle.GetIndex();
+    if (index >= mSlots.size() || mSlots[index].generation != handle.GetGeneration())
+    {
+        return nullptr;
+    }
+
+    return mDense[mSlots[index].denseIndex].get();
+}
+
+void ActorSlotMap::Clear()
+{
+    // Invalidate every handle before running destructors, so an actor that
+    // looks up another one while being destroyed sees a consistent map
+    for (uint32_t slotIndex : mDenseToSlot)
+    {
+        ReleaseSlot(slotIndex);
+    }
+    mDenseToSlot.clear();
+
+    std::vector<std::unique_ptr<Actor>> actors = std::move(mDense);
+    mDense.clear();
+    for (auto& actor : actors)
+    {
+        actor->mHandle.Reset();
+    }
+    actors.clear();
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <deque>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "ActorHandle.hpp"
+
+class Actor;
+
+// Generational slot map owning the game's actors.
+// Actors live in a dense array (cache-friendly iteration), slots map handles to
+// dense indices. Insert and Remove are O(1); Remove swaps the last actor into
+// the hole, so iteration order is not preserved across removals.
+// Freed slots are reused oldest first, and a slot whose generation would wrap
+// is retired, so a stale handle never resolves to a later actor.
+class ActorSlotMap
+{
+public:
+    static constexpr uint32_t MAX_ACTORS = ActorHandle::INDEX_MASK + 1;
+
+    ActorSlotMap() = default;
+    ~ActorSlotMap();
+
+    ActorSlotMap(const ActorSlotMap&) = delete;
+    ActorSlotMap& operator=(const ActorSlotMap&) = delete;
+
+    // Takes ownership and returns the actor's handle (invalid if the map is full)
+    ActorHandle Insert(std::unique_ptr<Actor> actor);
+    // Releases ownership of the actor (null if the handle is stale)
+    std::unique_ptr<Actor> Remove(ActorHandle handle);
+    // Returns null for stale or invalid handles
+    Actor* Get(ActorHandle handle) const;
+    bool Contains(ActorHandle handle) const { return Get(handle) != nullptr; }
+
+    // Destroys every actor; all outstanding handles become stale
+    void Clear();
+
+    size_t Size() const { return mDense.size(); }
+    bool Empty() const { return mDense.empty(); }
+
+    // Dense iteration
+    const std::vector<std::unique_ptr<Actor>>& GetDense() const { return mDense; }
+    std::vector<std::unique_ptr<Actor>>::const_iterator begin() const { return mDense.begin(); }
+    std::vector<std::unique_ptr<Actor>>::const_iterator end() const { return mDense.end(); }
+
+private:
+    struct Slot
+    {
+        uint32_t denseIndex;
+        uint32_t generation;
+    };
+
+    // Bumps the slot's generation and queues it for reuse (or retires it)
+    void ReleaseSlot(uint32_t slotIndex);
+
+    std::vector<Slot> mSlots;
+    std::deque<uint32_t> mFreeSlots;  // First-in first-out
+    std::vector<std::unique_ptr<Actor>> mDense;
+    std::vector<uint32_t> mDenseToSlot;
+};
@@ -26,7 +26,7 @@ ItemActor::ItemActor(class Game* game, const Item& item)
     , mStartOffset(Vector2::Zero)
     , mJumpHeight(20.0f)
     , mIsBeingPickedUp(false)
-    , mPickupTarget(nullptr)
+    , mPickupTarget()
     , mPickupSpeed(400.0f)
 {
     // Generate random start offset for the jump
@@ -55,7 +55,7 @@ ItemActor::ItemActor(class Game* game, int itemId, const std::string& name, cons
     , mStartOffset(Vector2::Zero)
     , mJumpHeight(20.0f)
     , mIsBeingPickedUp(false)
-    , mPickupTarget(nullptr)
+    , mPickupTarget()
     , mPickupSpeed(400.0f)
 {
     // Generate random start offset for the jump
@@ -74,7 +74,7 @@ std::string ItemActor::GetDisplayText() const
     
     if (mShowEmoji && mShowName)
     {
-        text = mItem.emoji + " " + mItem.name;
+        text = mItem.displayName();
     }
     else if (mShowEmoji)
     {
@@ -95,7 +95,7 @@ void ItemActor::StartPickup(Actor* target)
     if (!mIsBeingPickedUp && target)
     {
         mIsBeingPickedUp = true;
-        mPickupTarget = target;
+        mPickupTarget = target->GetHandle();
         mDraggable = false; // Disable dragging while being picked up
         mIsDragging = false;
     }
@@ -103,10 +103,21 @@ void ItemActor::StartPickup(Actor* target)
 
 void ItemActor::OnUpdate(float deltaTime)
 {
-    if (mIsBeingPickedUp && mPickupTarget)
+    Actor* pickupTarget = mIsBeingPickedUp ? mGame->GetActor(mPickupTarget) : nullptr;
+    if (mIsBeingPickedUp && !pickupTarget)
+    {
+        // Target went away mid-pickup: drop the item where it is
+        mIsBeingPickedUp = false;
+        mPickupTarget.Reset();
+        mPickupSpeed = 400.0f;
+        mSpawnScale = 1.0f;
+        mDraggable = true;
+    }
+
+    if (pickupTarget)
     {
         Vector2 pos = GetPosition();
-        Vector2 targetPos = mPickupTarget->GetPosition();
+        Vector2 targetPos = pickupTarget->GetPosition();
         
         // Calculate direction to target
         Vector2 diff = targetPos - pos;
@@ -116,7 +127,7 @@ void ItemActor::OnUpdate(float deltaTime)
         if (distSq < 400.0f) // 20 pixels squared
         {
             // Try to cast target to Player to access inventory
-            Player* player = dynamic_cast<Player*>(mPickupTarget);
+            Player* player = dynamic_cast<Player*>(pickupTarget);
             if (player)
             {
                 player->PickupItem(mItem);
@@ -133,7 +144,7 @@ void ItemActor::OnUpdate(float deltaTime)
         mPickupSpeed += 1000.0f * deltaTime;
         
         pos += diff * mPickupSpeed * deltaTime;
-        SetPosition(pos);
+        MoveTo(pos);
         
         // Shrink while being picked up
         if (mSpawnScale > 0.2f)
@@ -171,12 +182,12 @@ void ItemActor::OnUpdate(float deltaTime)
         float jumpY = -mJumpHeight * 4.0f * t * (1.0f - t);
         
         // Update position
-        SetPosition(mBasePosition + currentOffset + Vector2(0.0f, jumpY));
+        MoveTo(mBasePosition + currentOffset + Vector2(0.0f, jumpY));
 
         if (mSpawnTimer >= mSpawnDuration)
         {
             mSpawnScale = 1.0f;
-            SetPosition(mBasePosition); // Ensure we land exactly on target
+            MoveTo(mBasePosition); // Ensure we land exactly on target
         }
     }
 }void ItemActor::OnDraw(class TextRenderer* textRenderer)
@@ -184,12 +195,12 @@ void ItemActor::OnUpdate(float deltaTime)
     if (!textRenderer)
         return;
 
-    Vector2 pos = GetPosition();
+    Vector2 pos = GetRenderPosition();
     
     // Adjust for camera
     if (GetGame())
     {
-        Vector2 cameraPos = GetGame()->GetCameraPosition();
+        Vector2 cameraPos = GetGame()->GetRenderCameraPosition();
         pos.x -= cameraPos.x;
         pos.y -= cameraPos.y;
     }
@@ -285,12 +296,13 @@ float ItemActor::GetTextHeight(float scale) const
 
 bool ItemActor::ContainsPoint(const Vector2& point) const
 {
-    Vector2 pos = GetPosition();
+    // Hit-test against where the item is drawn on screen
+    Vector2 pos = GetRenderPosition();
     
     // Adjust for camera
     if (GetGame())
     {
-        Vector2 cameraPos = GetGame()->GetCameraPosition();
+        Vector2 cameraPos = GetGame()->GetRenderCameraPosition();
         pos.x -= cameraPos.x;
         pos.y -= cameraPos.y;
     }
@@ -329,7 +341,7 @@ void ItemActor::OnMouseDown(const Vector2& mousePos)
         Vector2 worldMousePos = mousePos;
         if (GetGame())
         {
-            worldMousePos += GetGame()->GetCameraPosition();
+            worldMousePos += GetGame()->GetRenderCameraPosition();
         }
         
         mDragOffset = GetPosition() - worldMousePos;
@@ -358,7 +370,7 @@ void ItemActor::OnMouseMove(const Vector2& mousePos)
         Vector2 worldMousePos = mousePos;
         if (GetGame())
         {
-            worldMousePos += GetGame()->GetCameraPosition();
+            worldMousePos += GetGame()->GetRenderCameraPosition();
         }
         
         SetPosition(worldMousePos + mDragOffset);
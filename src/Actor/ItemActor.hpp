@@ -48,6 +48,9 @@ public:
     void StartPickup(Actor* target);
     bool IsBeingPickedUp() const { return mIsBeingPickedUp; }
 
+    bool CanUpdateInParallel() const override { return true; }
+    uint32_t GetKind() const override { return ActorKind::Item; }
+
 protected:
     void OnUpdate(float deltaTime) override;
     void OnDraw(class TextRenderer* textRenderer) override;
@@ -78,7 +81,7 @@ private:
     
     // Pickup state
     bool mIsBeingPickedUp;
-    Actor* mPickupTarget;
+    ActorHandle mPickupTarget;
     float mPickupSpeed;
 
     std::string GetDisplayText() const;
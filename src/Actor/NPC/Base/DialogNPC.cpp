@@ -77,7 +77,10 @@ void DialogNPC::OnDraw(TextRenderer* textRenderer)
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, 0);
     }
+}
 
+void DialogNPC::DrawDialog(TextRenderer* textRenderer, RectRenderer* rectRenderer)
+{
     // Draw dialog UI if active
     if (mDialogUI && mDialogUI->IsVisible())
     {
@@ -91,8 +94,8 @@ void DialogNPC::OnDraw(TextRenderer* textRenderer)
 
 bool DialogNPC::CanInteract(const Vector2& playerPos, float interactionRange) const
 {
-    float distance = (GetPosition() - playerPos).Length();
-    return distance <= interactionRange;
+    float distanceSq = (GetPosition() - playerPos).LengthSq();
+    return distanceSq <= interactionRange * interactionRange;
 }
 
 void DialogNPC::StartInteraction()
@@ -261,7 +264,7 @@ void DialogNPC::OnTradeMenuSelected()
             const Item* rewardItem = crafting ? crafting->FindItemById(trade.reward.itemId) : nullptr;
             if (rewardItem)
             {
-                desc += rewardItem->emoji + " " + rewardItem->name + " x" +
+                desc += rewardItem->displayName() + " x" +
                        std::to_string(trade.reward.quantity);
             }
             else
@@ -280,7 +283,7 @@ void DialogNPC::OnTradeMenuSelected()
 
                     if (reqItem)
                     {
-                        desc += reqItem->emoji + " " + reqItem->name + " x" +
+                        desc += reqItem->displayName() + " x" +
                                std::to_string(trade.requirements[i].quantity);
                     }
                     else
@@ -319,6 +322,40 @@ void DialogNPC::OnDialogOptionSelected(int index)
     }
 }
 
+// First combination toward itemId from what the player holds, e.g.
+// "Hint: combine Fogo + Terra"; empty if it cannot be crafted from there
+static std::string GetCraftHint(Game* game, const Inventory* inventory, int itemId)
+{
+    CraftPlanner* planner = game->GetCraftPlanner();
+    Crafting* crafting = game->GetCrafting();
+    if (!planner || !crafting)
+        return "";
+
+    std::vector<int> heldIds;
+    for (const auto& slot : inventory->GetAllSlots())
+    {
+        if (slot.IsEmpty()) continue;
+        heldIds.push_back(slot.item.id);
+    }
+
+    CraftPlanner::Plan plan;
+    if (!planner->FindPlan(heldIds, itemId, plan) || plan.steps.empty())
+        return "";
+
+    const CraftPlanner::Step& step = plan.steps.front();
+    const Item* item1 = crafting->FindItemById(step.item1Id);
+    const Item* item2 = crafting->FindItemById(step.item2Id);
+    if (!item1 || !item2)
+        return "";
+
+    std::string hint = "Hint: combine " + item1->displayName() + " + " + item2->displayName();
+    if (plan.steps.size() > 1)
+    {
+        hint += " (" + std::to_string(plan.steps.size()) + " combinations to go)";
+    }
+    return hint;
+}
+
 void DialogNPC::OnTradeOptionSelected(int index)
 {
     if (index >= 0 && index < static_cast<int>(mTradeOffers.size()))
@@ -343,12 +380,17 @@ void DialogNPC::OnTradeOptionSelected(int index)
         // Check if player has all required items
         bool hasAllItems = true;
         std::string missingItems;
+        std::string hint;
         auto* crafting = mGame->GetCrafting();
         
         for (const auto& req : trade.requirements)
         {
             if (!inventory->HasItem(req.itemId, req.quantity))
             {
+                if (hasAllItems)
+                {
+                    hint = GetCraftHint(mGame, inventory, req.itemId);
+                }
                 hasAllItems = false;
                 const Item* item = crafting ? crafting->FindItemById(req.itemId) : nullptr;
                 
@@ -357,7 +399,7 @@ void DialogNPC::OnTradeOptionSelected(int index)
                     
                 if (item)
                 {
-                    missingItems += item->emoji + " " + item->name + " x" + std::to_string(req.quantity);
+                    missingItems += item->displayName() + " x" + std::to_string(req.quantity);
                 }
                 else
                 {
@@ -369,7 +411,12 @@ void DialogNPC::OnTradeOptionSelected(int index)
         // If player doesn't have all items, show error message
         if (!hasAllItems)
         {
-            mDialogUI->ShowMessage("You don't have the required items!\nMissing: " + missingItems);
+            std::string message = "You don't have the required items!\nMissing: " + missingItems;
+            if (!hint.empty())
+            {
+                message += "\n" + hint;
+            }
+            mDialogUI->ShowMessage(message);
             return;
         }
         
@@ -388,7 +435,7 @@ void DialogNPC::OnTradeOptionSelected(int index)
             if (success)
             {
                 std::string successMsg = "Trade successful!\nYou received: " +
-                                        rewardItem->emoji + " " + rewardItem->name +
+                                        rewardItem->displayName() +
                                         " x" + std::to_string(trade.reward.quantity);
                 mDialogUI->ShowMessage(successMsg);
             }
@@ -55,9 +55,15 @@ public:
 
     void OnUpdate(float deltaTime) override;
     void OnDraw(class TextRenderer* textRenderer) override;
+    // Dialog box, drawn by Game after all actors so none can cover it
+    void DrawDialog(class TextRenderer* textRenderer, class RectRenderer* rectRenderer);
+    uint32_t GetKind() const override { return ActorKind::NPC | ActorKind::DialogNPC; }
+
+    // How close the player has to be to talk
+    static constexpr float INTERACTION_RANGE = 100.0f;
 
     // Interaction methods
-    bool CanInteract(const Vector2& playerPos, float interactionRange = 100.0f) const;
+    bool CanInteract(const Vector2& playerPos, float interactionRange = INTERACTION_RANGE) const;
     void StartInteraction();
     void EndInteraction();
     bool IsInteracting() const;
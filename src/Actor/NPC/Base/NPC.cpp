@@ -71,6 +71,11 @@ void NPC::SetSpriteConfiguration(int width, int height, int idleFrames, int walk
         mSpriteComponent->SetRenderSize(64.0f);
     }
 
+    if (mMovementComponent)
+    {
+        mMovementComponent->FitColliderToSprite(64.0f);
+    }
+
     if (mAnimationComponent)
     {
         mAnimationComponent->SetFrameCount(idleFrames);
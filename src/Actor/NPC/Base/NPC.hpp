@@ -16,6 +16,8 @@ public:
     NPC(Game* game);
     virtual ~NPC();
 
+    uint32_t GetKind() const override { return ActorKind::NPC; }
+
     // Sprite configuration
     void LoadSpriteSheetFromTSX(const std::string& tsxPath);
     void SetSpriteConfiguration(int width, int height, int idleFrames, int walkFrames, float animSpeed);
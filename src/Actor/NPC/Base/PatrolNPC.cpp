@@ -2,6 +2,8 @@
 #include "../../../Game/Game.hpp"
 #include "../../Player.hpp"
 #include "../../../Map/TiledParser.hpp"
+#include "../../../Map/TileMap.hpp"
+#include "../../../AI/PathfindingService.hpp"
 #include "../../../Core/TextRenderer/TextRenderer.hpp"
 #include "../../../Core/Texture/SpriteRenderer.hpp"
 #include "../../../Component/AnimationComponent.hpp"
@@ -24,6 +26,10 @@ PatrolNPC::PatrolNPC(Game* game, bool isAggressive)
     , mDeaggroRange(400.0f)
     , mChaseSpeed(150.0f)
     , mMaxChaseDistance(300.0f)
+    , mPathTicket(0)
+    , mPathGoalTile(-1)
+    , mPathIndex(0)
+    , mPathComplete(true)
     , mHealthComponent(nullptr)
     , mAttackComponent(nullptr)
     , mCurrentDirection(0)
@@ -87,6 +93,7 @@ PatrolNPC::PatrolNPC(Game* game, bool isAggressive)
 
 PatrolNPC::~PatrolNPC()
 {
+    ClearPath();
 }
 
 void PatrolNPC::OnUpdate(float deltaTime)
@@ -108,7 +115,7 @@ void PatrolNPC::OnUpdate(float deltaTime)
 void PatrolNPC::UpdatePatrolling(float deltaTime)
 {
     // Check if aggressive NPC should start chasing
-    if (mIsAggressive && IsPlayerInRange(mAggroRange))
+    if (mIsAggressive && CanSeePlayer(mAggroRange))
     {
         mState = PatrolNPCState::Chasing;
         return;
@@ -155,7 +162,7 @@ void PatrolNPC::UpdatePatrolling(float deltaTime)
     else
     {
         // Move towards waypoint
-        MoveTowards(targetWaypoint.position, mMovementSpeed, deltaTime);
+        MoveAlongPath(targetWaypoint.position, mMovementSpeed, deltaTime);
         mIsMoving = true;
     }
 }
@@ -209,15 +216,24 @@ void PatrolNPC::UpdateChasing(float deltaTime)
         }
     }
 
-    // Chase the player
-    MoveTowards(playerPos, mChaseSpeed, deltaTime);
+    // Chase the player down the shared flow field; A* only if it does not
+    // reach this far
+    Vector2 steerTarget;
+    if (mGame->GetPlayerFlowField().GetSteeringTarget(npcPos, mMovementComponent->GetColliderHalfSize(), steerTarget))
+    {
+        MoveTowards(steerTarget, mChaseSpeed, deltaTime);
+    }
+    else
+    {
+        MoveAlongPath(playerPos, mChaseSpeed, deltaTime);
+    }
     mIsMoving = true;
 }
 
 void PatrolNPC::UpdateReturning(float deltaTime)
 {
     // Check if player comes back into aggro range while returning
-    if (mIsAggressive && IsPlayerInRange(mAggroRange))
+    if (mIsAggressive && CanSeePlayer(mAggroRange))
     {
         mState = PatrolNPCState::Chasing;
         return;
@@ -230,7 +246,7 @@ void PatrolNPC::UpdateReturning(float deltaTime)
     if (distanceToAnchor < 5.0f)
     {
         // Reached anchor, resume patrolling
-        SetPosition(mAnchorPosition);
+        MoveTo(mAnchorPosition);
         mState = PatrolNPCState::Patrolling;
         mCurrentWaypointIndex = 0;  // Reset to first waypoint
         mWaitTimer = 0.0f;
@@ -241,7 +257,7 @@ void PatrolNPC::UpdateReturning(float deltaTime)
     else
     {
         // Move towards anchor
-        MoveTowards(mAnchorPosition, mMovementSpeed, deltaTime);
+        MoveAlongPath(mAnchorPosition, mMovementSpeed, deltaTime);
         mIsMoving = true;
     }
 }
@@ -271,6 +287,90 @@ void PatrolNPC::MoveTowards(const Vector2& target, float speed, float deltaTime)
     }
 }
 
+void PatrolNPC::MoveAlongPath(const Vector2& target, float speed, float deltaTime)
+{
+    PathfindingService* pathfinding = mGame->GetPathfinding();
+    TileMap* tileMap = mGame->GetTileMap();
+    if (!pathfinding || !tileMap)
+    {
+        MoveTowards(target, speed, deltaTime);
+        return;
+    }
+
+    // Re-plan only when the target moves to another tile; the old path is
+    // followed until the new one arrives
+    int tileSize = tileMap->GetTileSize();
+    int goalTile = static_cast<int>(std::floor(target.y / tileSize)) * tileMap->GetWidth() +
+                   static_cast<int>(std::floor(target.x / tileSize));
+    if (goalTile != mPathGoalTile)
+    {
+        if (mPathTicket != 0)
+        {
+            pathfinding->Cancel(mPathTicket);
+        }
+        pathfinding->RequestPath(GetPosition(), target, &mPathTicket);
+        mPathGoalTile = goalTile;
+    }
+
+    if (mPathTicket != 0)
+    {
+        PathStatus status = pathfinding->TakePath(mPathTicket, mPath, &mPathComplete);
+        if (status == PathStatus::Ready)
+        {
+            mPathTicket = 0;
+            mPathIndex = 0;
+        }
+        else if (status != PathStatus::Pending)
+        {
+            // Unreachable: fall back to steering straight at it
+            mPathTicket = 0;
+            mPath.clear();
+        }
+    }
+
+    if (mPath.empty())
+    {
+        MoveTowards(target, speed, deltaTime);
+        return;
+    }
+
+    // The path ends on the live target, not on where it was when requested
+    if (mPathComplete)
+    {
+        mPath.back() = target;
+    }
+
+    const float reachedSq = (tileSize * 0.25f) * (tileSize * 0.25f);
+    while (mPathIndex + 1 < mPath.size() && (mPath[mPathIndex] - GetPosition()).LengthSq() < reachedSq)
+    {
+        mPathIndex++;
+    }
+
+    // End of a long path's first stretch: ask for the next one from here
+    if (!mPathComplete && mPathTicket == 0 && mPathIndex + 1 == mPath.size() &&
+        (mPath[mPathIndex] - GetPosition()).LengthSq() < reachedSq)
+    {
+        pathfinding->RequestPath(GetPosition(), target, &mPathTicket);
+    }
+    MoveTowards(mPath[mPathIndex], speed, deltaTime);
+}
+
+void PatrolNPC::ClearPath()
+{
+    if (mPathTicket != 0)
+    {
+        if (PathfindingService* pathfinding = mGame->GetPathfinding())
+        {
+            pathfinding->Cancel(mPathTicket);
+        }
+    }
+    mPathTicket = 0;
+    mPathGoalTile = -1;
+    mPath.clear();
+    mPathIndex = 0;
+    mPathComplete = true;
+}
+
 void PatrolNPC::UpdateAnimation(const Vector2& velocity)
 {
     if (velocity.LengthSq() > 0.1f)
@@ -297,16 +397,16 @@ void PatrolNPC::UpdateAnimation(const Vector2& velocity)
     }
 }
 
-bool PatrolNPC::IsPlayerInRange(float range) const
+bool PatrolNPC::CanSeePlayer(float range) const
 {
     Player* player = mGame->GetPlayer();
     if (!player) return false;
 
     Vector2 playerPos = player->GetPosition();
     Vector2 npcPos = GetPosition();
-    float distance = (playerPos - npcPos).Length();
+    if ((playerPos - npcPos).LengthSq() > range * range) return false;
 
-    return distance <= range;
+    return mGame->GetPlayerSight().CanSeeTarget(npcPos);
 }
 
 void PatrolNPC::OnDraw(TextRenderer* textRenderer)
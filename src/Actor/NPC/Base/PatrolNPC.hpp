@@ -34,6 +34,9 @@ public:
     void OnUpdate(float deltaTime) override;
     void OnDraw(class TextRenderer* textRenderer) override;
 
+    // Only reads the player; attacks are deferred to the sync point
+    bool CanUpdateInParallel() const override { return true; }
+
     // Movement configuration
     void AddWaypoint(const Vector2& position, float waitTime = 0.0f);
     void SetMovementSpeed(float speed) { mMovementSpeed = speed; }
@@ -60,8 +63,13 @@ protected:
 
     // Helper methods
     void MoveTowards(const Vector2& target, float speed, float deltaTime);
+    // Walks to target around collision using the shared pathfinder (steers
+    // straight while the first path is pending or if there is none)
+    void MoveAlongPath(const Vector2& target, float speed, float deltaTime);
+    void ClearPath();
     void UpdateAnimation(const Vector2& velocity);
-    bool IsPlayerInRange(float range) const;
+    // Within range and not hidden behind collision
+    bool CanSeePlayer(float range) const;
 
     // NPC state
     PatrolNPCState mState;
@@ -80,6 +88,13 @@ protected:
     float mChaseSpeed;         // Speed when chasing player
     float mMaxChaseDistance;   // Max distance from NPC to chase player before giving up
 
+    // Path following
+    uint32_t mPathTicket;        // Pending request, 0 if none (DEFERRED_TICKET until the sync point)
+    int mPathGoalTile;           // Tile index the current path/request leads to
+    std::vector<Vector2> mPath;
+    size_t mPathIndex;
+    bool mPathComplete;          // False: a long path's first stretch, the rest is requested at its end
+
     // Components
     HealthComponent* mHealthComponent;
     AttackComponent* mAttackComponent;
@@ -1,6 +1,7 @@
 #include "Player.hpp"
 #include "../Game/Game.hpp"
 #include "../Game/Inventory.hpp"
+#include "../Game/CommandBuffer.hpp"
 #include "../UI/InventoryUI.hpp"
 #include "../Core/Texture/SpriteRenderer.hpp"
 #include "../Component/PlayerInputComponent.hpp"
@@ -108,6 +109,7 @@ void Player::LoadTextures()
         mSpriteComponent->SetSpriteSize(16, 16); // Tile size from TSX
         mSpriteComponent->SetRenderSize(64.0f);
     }
+    mMovementComponent->FitColliderToSprite(64.0f);
 }
 
 void Player::OnProcessInput(const Uint8* keyState)
@@ -195,14 +197,19 @@ void Player::OnUpdate(float deltaTime)
     // Radius increased to 150px (approx 3-4 tiles) to make pickup easier
     const float PICKUP_RADIUS = 150.0f;
     const float PICKUP_RADIUS_SQ = PICKUP_RADIUS * PICKUP_RADIUS;
+    // The grid indexes items by their left edge; pad the query by a generous
+    // half item width so items whose center is in range are not missed
+    const float ITEM_HALF_WIDTH_MARGIN = 128.0f;
     
     Vector2 myPos = GetPosition();
+
+    mNearbyActors.clear();
+    mGame->GetSpatialGrid().QueryRadius(myPos, PICKUP_RADIUS + ITEM_HALF_WIDTH_MARGIN, ActorKind::Item, mNearbyActors);
     
-    for (const auto& actor : mGame->GetActors())
+    for (Actor* actor : mNearbyActors)
     {
-        // Check if it's an ItemActor
-        ItemActor* item = dynamic_cast<ItemActor*>(actor.get());
-        if (item && item->GetState() == ActorState::Active && !item->IsBeingPickedUp())
+        ItemActor* item = static_cast<ItemActor*>(actor);
+        if (item->GetState() == ActorState::Active && !item->IsBeingPickedUp())
         {
             // Calculate item center (ItemActor position is Left-Center)
             Vector2 itemBounds = item->GetBounds();
@@ -301,6 +308,13 @@ bool Player::PickupItem(const Item& item, int quantity)
 {
     if (!mInventory)
         return false;
+
+    // Called from an item updating in parallel: add it at the sync point
+    if (CommandBuffer* commands = CommandBuffer::Current())
+    {
+        commands->PickupItem(this, item, quantity);
+        return true;
+    }
     
     return mInventory->AddItem(item, quantity);
 }
@@ -37,6 +37,7 @@ public:
     void OnProcessInput(const Uint8* keyState) override;
     void OnUpdate(float deltaTime) override;
     void OnDraw(class TextRenderer* textRenderer) override;
+    uint32_t GetKind() const override { return ActorKind::Player; }
     
     // State
     PlayerState GetState() const { return mState; }
@@ -76,6 +77,9 @@ private:
     std::unique_ptr<Inventory> mInventory;
     std::unique_ptr<InventoryUI> mInventoryUI;
 
+    // Scratch buffer for spatial grid queries
+    std::vector<Actor*> mNearbyActors;
+
     // Animation constants
     static constexpr float ANIM_SPEED = 8.0f; // Frames per second
     static constexpr float ATTACK_DURATION = 0.3f; // Seconds
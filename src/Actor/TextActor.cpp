@@ -12,12 +12,12 @@ void TextActor::OnDraw(class TextRenderer* textRenderer)
 {
     if (textRenderer)
     {
-        Vector2 pos = GetPosition();
+        Vector2 pos = GetRenderPosition();
         
         // Adjust for camera
         if (GetGame())
         {
-            Vector2 cameraPos = GetGame()->GetCameraPosition();
+            Vector2 cameraPos = GetGame()->GetRenderCameraPosition();
             pos.x -= cameraPos.x;
             pos.y -= cameraPos.y;
         }
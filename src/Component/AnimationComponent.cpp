@@ -1,23 +1,22 @@
 #include "AnimationComponent.hpp"
 #include "../Actor/Actor.hpp"
+#include "../Game/Game.hpp"
 
 AnimationComponent::AnimationComponent(Actor* owner, int updateOrder)
     : Component(owner, updateOrder)
-    , mAnimTime(0.0f)
-    , mAnimFrame(0)
-    , mMaxFrames(6)
-    , mAnimSpeed(8.0f)
+    , mPool(&owner->GetGame()->GetAnimationPool())
+    , mPoolIndex(0)
 {
+    mPoolIndex = mPool->Add(this);
+    mUpdatedBySystem = true;
+}
+
+AnimationComponent::~AnimationComponent()
+{
+    mPool->Remove(mPoolIndex);
 }
 
 void AnimationComponent::Update(float deltaTime)
 {
-    mAnimTime += deltaTime;
-    float frameTime = 1.0f / mAnimSpeed;
-    
-    if (mAnimTime >= frameTime)
-    {
-        mAnimTime -= frameTime;
-        mAnimFrame = (mAnimFrame + 1) % mMaxFrames;
-    }
+    mPool->Update(deltaTime, mPoolIndex, mPoolIndex + 1);
 }
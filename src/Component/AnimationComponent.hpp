@@ -1,25 +1,32 @@
 #pragma once
 #include "Component.hpp"
+#include "ComponentPools.hpp"
 
-// Component that handles sprite animation frame updates
+// Component that handles sprite animation frame updates.
+// State lives in Game's AnimationPool and is advanced in bulk by the animation system.
 class AnimationComponent : public Component
 {
 public:
+    static constexpr ComponentType StaticType = ComponentType::Animation;
+
     AnimationComponent(class Actor* owner, int updateOrder = 100);
+    ~AnimationComponent();
+    ComponentType GetType() const override { return StaticType; }
     
+    // Steps only this component (the animation system normally does this)
     void Update(float deltaTime) override;
     
     // Animation control
-    void SetFrameCount(int frames) { mMaxFrames = frames; }
-    void SetAnimSpeed(float fps) { mAnimSpeed = fps; }
-    void ResetAnimation() { mAnimTime = 0.0f; mAnimFrame = 0; }
+    void SetFrameCount(int frames) { mPool->SetFrameCount(mPoolIndex, frames); }
+    void SetAnimSpeed(float fps) { mPool->SetAnimSpeed(mPoolIndex, fps); }
+    void ResetAnimation() { mPool->Reset(mPoolIndex); }
     
     // Getters
-    int GetCurrentFrame() const { return mAnimFrame; }
+    int GetCurrentFrame() const { return mPool->GetFrame(mPoolIndex); }
     
 private:
-    float mAnimTime;
-    int mAnimFrame;
-    int mMaxFrames;
-    float mAnimSpeed;
+    friend class AnimationPool;
+
+    AnimationPool* mPool;
+    uint32_t mPoolIndex;
 };
@@ -3,7 +3,9 @@
 #include "MovementComponent.hpp"
 #include "../Actor/Actor.hpp"
 #include "../Game/Game.hpp"
+#include "../Game/CommandBuffer.hpp"
 #include <SDL.h>
+#include <algorithm>
 #include <cmath>
 
 AttackComponent::AttackComponent(Actor* owner, int updateOrder)
@@ -59,8 +61,16 @@ void AttackComponent::StartAttack(int direction)
         mAttackStartCallback(direction);
     }
 
-    // Perform the attack immediately
-    PerformAttack();
+    // Perform the attack immediately (at the sync point when updating in parallel,
+    // since hitting targets reads and mutates other actors)
+    if (CommandBuffer* commands = CommandBuffer::Current())
+    {
+        commands->PerformAttack(this);
+    }
+    else
+    {
+        PerformAttack();
+    }
 }
 
 void AttackComponent::PerformAttack()
@@ -115,31 +125,10 @@ void AttackComponent::FindTargetsInRange(std::vector<Actor*>& targets)
     Game* game = mOwner->GetGame();
     if (!game) return;
 
-    Vector2 ownerPos = mOwner->GetPosition();
-
-    // Get all actors from the game
-    const auto& actors = game->GetActors();
-
-    for (const auto& actorPtr : actors)
-    {
-        Actor* actor = actorPtr.get();
-
-        // Skip self
-        if (actor == mOwner) continue;
-
-        // Check if actor has health component (is damageable)
-        HealthComponent* healthComp = actor->GetComponent<HealthComponent>();
-        if (!healthComp) continue;
-
-        // Check if in range
-        Vector2 targetPos = actor->GetPosition();
-        float distance = (targetPos - ownerPos).Length();
-
-        if (distance <= mConfig.range)
-        {
-            targets.push_back(actor);
-        }
-    }
+    // Damageable actors (with a health component) within range, minus ourselves
+    size_t first = targets.size();
+    game->GetSpatialGrid().QueryRadius(mOwner->GetPosition(), mConfig.range, ActorKind::Damageable, targets);
+    targets.erase(std::remove(targets.begin() + first, targets.end(), mOwner), targets.end());
 }
 
 void AttackComponent::ApplyDamageAndKnockback(Actor* target, const Vector2& direction)
@@ -36,7 +36,10 @@ struct AttackConfig
 class AttackComponent : public Component
 {
 public:
+    static constexpr ComponentType StaticType = ComponentType::Attack;
+
     AttackComponent(class Actor* owner, int updateOrder = 100);
+    ComponentType GetType() const override { return StaticType; }
 
     void Update(float deltaTime) override;
 
@@ -71,6 +74,8 @@ public:
     void SetAttackEndCallback(std::function<void()> callback) { mAttackEndCallback = callback; }
 
 private:
+    friend class CommandBuffer;
+
     void PerformAttack();
     void FindTargetsInRange(std::vector<class Actor*>& targets);
     void ApplyDamageAndKnockback(class Actor* target, const Vector2& direction);
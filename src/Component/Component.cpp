@@ -8,6 +8,7 @@
 Component::Component(Actor* owner, int updateOrder)
     : mOwner(owner)
     , mUpdateOrder(updateOrder)
+    , mUpdatedBySystem(false)
 {
     // Component will be added to Actor through smart pointer management
 }
@@ -4,6 +4,34 @@
 
 #pragma once
 #include <cstdint>
+#include <type_traits>
+
+// Built-in component types, used by Actor for O(1) component lookup.
+// Each component class declares its own as `static constexpr ComponentType StaticType`
+// and returns it from its own GetType() override. Components without one
+// (Count), and subclasses of typed ones, still work through
+// Actor::GetComponent's dynamic_cast fallback.
+enum class ComponentType : uint8_t
+{
+    Animation,
+    Attack,
+    Health,
+    Movement,
+    PlayerInput,
+    Sprite,
+
+    Count
+};
+
+// True if T has a StaticType and declares GetType itself. A subclass of a
+// typed component that inherits both is not its type, so it is looked up
+// through the dynamic_cast fallback (the table would hand back the base).
+template <typename T, typename = void>
+struct HasComponentType : std::false_type {};
+
+template <typename T>
+struct HasComponentType<T, std::void_t<decltype(T::StaticType), decltype(&T::GetType)>>
+    : std::is_same<decltype(&T::GetType), ComponentType (T::*)() const> {};
 
 class Component
 {
@@ -18,6 +46,12 @@ public:
     // Process input for this component (if needed)
     virtual void ProcessInput(const uint8_t* keyState);
 
+    // Type used for Actor's lookup table (Count = untyped)
+    virtual ComponentType GetType() const { return ComponentType::Count; }
+
+    // Pooled components are stepped by Game's batch systems, not by Actor::Update
+    bool IsUpdatedBySystem() const { return mUpdatedBySystem; }
+
     int GetUpdateOrder() const { return mUpdateOrder; }
     class Actor* GetOwner() const { return mOwner; }
     class Game* GetGame() const;
@@ -27,4 +61,5 @@ protected:
     class Actor* mOwner;
     // Update order
     int mUpdateOrder;
+    bool mUpdatedBySystem;
 };
\ No newline at end of file
@@ -0,0 +1,304 @@
+#include "ComponentPools.hpp"
+#include "MovementComponent.hpp"
+#include "AnimationComponent.hpp"
+#include "SpriteComponent.hpp"
+#include "../Actor/Actor.hpp"
+#include "../Game/Game.hpp"
+#include "../Map/TileMap.hpp"
+#include "../Core/Texture/SpriteRenderer.hpp"
+#include "../Core/Texture/Texture.hpp"
+#include <algorithm>
+
+namespace
+{
+    // Moves the last element into index and drops the last slot
+    template <typename T>
+    void SwapRemove(std::vector<T>& values, uint32_t index)
+    {
+        if (index + 1 != values.size())
+        {
+            values[index] = std::move(values.back());
+        }
+        values.pop_back();
+    }
+}
+
+// ---------------------------------------------------------------- Movement
+
+uint32_t MovementPool::Add(MovementComponent* component, Actor* owner)
+{
+    uint32_t index = static_cast<uint32_t>(mComponents.size());
+    mComponents.push_back(component);
+    mOwners.push_back(owner);
+    mVelocityX.push_back(0.0f);
+    mVelocityY.push_back(0.0f);
+    mImpulseX.push_back(0.0f);
+    mImpulseY.push_back(0.0f);
+    mImpulseDecay.push_back(0.92f);  // Decay 8% per frame (smooth deceleration)
+    mMinX.push_back(32.0f);
+    mMinY.push_back(32.0f);
+    mMaxX.push_back(Game::WINDOW_WIDTH - 32.0f);
+    mMaxY.push_back(Game::WINDOW_HEIGHT - 32.0f);
+    mUseBounds.push_back(1);
+    mColliderHalfX.push_back(16.0f);  // 32x32 box, half of the player sprite width
+    mColliderHalfY.push_back(16.0f);
+    return index;
+}
+
+void MovementPool::Remove(uint32_t index)
+{
+    SwapRemove(mComponents, index);
+    SwapRemove(mOwners, index);
+    SwapRemove(mVelocityX, index);
+    SwapRemove(mVelocityY, index);
+    SwapRemove(mImpulseX, index);
+    SwapRemove(mImpulseY, index);
+    SwapRemove(mImpulseDecay, index);
+    SwapRemove(mMinX, index);
+    SwapRemove(mMinY, index);
+    SwapRemove(mMaxX, index);
+    SwapRemove(mMaxY, index);
+    SwapRemove(mUseBounds, index);
+    SwapRemove(mColliderHalfX, index);
+    SwapRemove(mColliderHalfY, index);
+
+    if (index < mComponents.size())
+    {
+        mComponents[index]->mPoolIndex = index;
+    }
+}
+
+void MovementPool::SetVelocity(uint32_t index, const Vector2& velocity)
+{
+    mVelocityX[index] = velocity.x;
+    mVelocityY[index] = velocity.y;
+}
+
+void MovementPool::AddImpulse(uint32_t index, const Vector2& impulse)
+{
+    mImpulseX[index] += impulse.x;
+    mImpulseY[index] += impulse.y;
+}
+
+void MovementPool::SetBounds(uint32_t index, float minX, float minY, float maxX, float maxY)
+{
+    mMinX[index] = minX;
+    mMinY[index] = minY;
+    mMaxX[index] = maxX;
+    mMaxY[index] = maxY;
+}
+
+void MovementPool::SetColliderSize(uint32_t index, float width, float height)
+{
+    mColliderHalfX[index] = width * 0.5f;
+    mColliderHalfY[index] = height * 0.5f;
+}
+
+void MovementPool::Update(float deltaTime, size_t begin, size_t end, const TileMap* tileMap)
+{
+    // Gap kept between a collider and the wall it stopped against
+    const float contactSkin = 0.01f;
+
+    for (size_t i = begin; i < end; i++)
+    {
+        // Only actors that are in the world and active move
+        Actor* owner = mOwners[i];
+        if (owner->GetState() != ActorState::Active || !owner->GetHandle().IsValid())
+        {
+            continue;
+        }
+
+        Vector2 currentPos = owner->GetPosition();
+        Vector2 totalVelocity(mVelocityX[i] + mImpulseX[i], mVelocityY[i] + mImpulseY[i]);
+        Vector2 motion = totalVelocity * deltaTime;
+        Vector2 newPos = currentPos + motion;
+
+        if (tileMap)
+        {
+            // Swept collision: move up to the first wall, drop the blocked axis
+            // and slide along it with the rest of the motion. Two passes cover
+            // one hit per axis.
+            Vector2 halfSize(mColliderHalfX[i], mColliderHalfY[i]);
+            for (int pass = 0; pass < 2 && (motion.x != 0.0f || motion.y != 0.0f); pass++)
+            {
+                SweepHit hit;
+                if (!tileMap->SweepBox(currentPos, halfSize, motion, hit))
+                {
+                    currentPos += motion;
+                    motion = Vector2::Zero;
+                    break;
+                }
+
+                Vector2 travel = motion * hit.time;
+                float remaining = 1.0f - hit.time;
+                if (hit.normal.x != 0.0f)
+                {
+                    // Stop just short of the wall and kill the X impulse
+                    travel.x = (travel.x > 0.0f) ? std::max(0.0f, travel.x - contactSkin)
+                                                 : std::min(0.0f, travel.x + contactSkin);
+                    motion = Vector2(0.0f, motion.y * remaining);
+                    mImpulseX[i] = 0.0f;
+                }
+                else
+                {
+                    travel.y = (travel.y > 0.0f) ? std::max(0.0f, travel.y - contactSkin)
+                                                 : std::min(0.0f, travel.y + contactSkin);
+                    motion = Vector2(motion.x * remaining, 0.0f);
+                    mImpulseY[i] = 0.0f;
+                }
+                currentPos += travel;
+            }
+
+            newPos = currentPos;
+        }
+
+        // Clamp to bounds if enabled
+        if (mUseBounds[i])
+        {
+            newPos.x = std::max(mMinX[i], std::min(newPos.x, mMaxX[i]));
+            newPos.y = std::max(mMinY[i], std::min(newPos.y, mMaxY[i]));
+        }
+
+        owner->MoveTo(newPos);
+    }
+
+    // Impulse decay touches only the arrays, so it runs as a separate
+    // branch-free pass the compiler can vectorize
+    float* impulseX = mImpulseX.data();
+    float* impulseY = mImpulseY.data();
+    const float* decay = mImpulseDecay.data();
+    for (size_t i = begin; i < end; i++)
+    {
+        float x = impulseX[i] * decay[i];
+        float y = impulseY[i] * decay[i];
+
+        // Stop impulse when it's very small
+        float keep = (x * x + y * y < 1.0f) ? 0.0f : 1.0f;
+        impulseX[i] = x * keep;
+        impulseY[i] = y * keep;
+    }
+}
+
+// ---------------------------------------------------------------- Animation
+
+uint32_t AnimationPool::Add(AnimationComponent* component)
+{
+    uint32_t index = static_cast<uint32_t>(mComponents.size());
+    mComponents.push_back(component);
+    mAnimTime.push_back(0.0f);
+    mAnimSpeed.push_back(8.0f);
+    mFrame.push_back(0);
+    mMaxFrames.push_back(6);
+    return index;
+}
+
+void AnimationPool::Remove(uint32_t index)
+{
+    SwapRemove(mComponents, index);
+    SwapRemove(mAnimTime, index);
+    SwapRemove(mAnimSpeed, index);
+    SwapRemove(mFrame, index);
+    SwapRemove(mMaxFrames, index);
+
+    if (index < mComponents.size())
+    {
+        mComponents[index]->mPoolIndex = index;
+    }
+}
+
+void AnimationPool::Update(float deltaTime, size_t begin, size_t end)
+{
+    float* animTime = mAnimTime.data();
+    const float* animSpeed = mAnimSpeed.data();
+    int* frame = mFrame.data();
+    const int* maxFrames = mMaxFrames.data();
+
+    for (size_t i = begin; i < end; i++)
+    {
+        float time = animTime[i] + deltaTime;
+        float frameTime = 1.0f / animSpeed[i];
+
+        if (time >= frameTime)
+        {
+            time -= frameTime;
+            frame[i] = (frame[i] + 1) % maxFrames[i];
+        }
+        animTime[i] = time;
+    }
+}
+
+// ---------------------------------------------------------------- Sprite
+
+uint32_t SpritePool::Add(SpriteComponent* component, Actor* owner)
+{
+    uint32_t index = static_cast<uint32_t>(mComponents.size());
+    mComponents.push_back(component);
+    mOwners.push_back(owner);
+    mTextures.emplace_back(nullptr);
+    mSpriteWidth.push_back(32);
+    mSpriteHeight.push_back(32);
+    mCurrentRow.push_back(0);
+    mCurrentCol.push_back(0);
+    mRenderSize.push_back(80.0f);
+    mFlipHorizontal.push_back(0);
+    return index;
+}
+
+void SpritePool::Remove(uint32_t index)
+{
+    SwapRemove(mComponents, index);
+    SwapRemove(mOwners, index);
+    SwapRemove(mTextures, index);
+    SwapRemove(mSpriteWidth, index);
+    SwapRemove(mSpriteHeight, index);
+    SwapRemove(mCurrentRow, index);
+    SwapRemove(mCurrentCol, index);
+    SwapRemove(mRenderSize, index);
+    SwapRemove(mFlipHorizontal, index);
+
+    if (index < mComponents.size())
+    {
+        mComponents[index]->mPoolIndex = index;
+    }
+}
+
+void SpritePool::SetSpriteSize(uint32_t index, int width, int height)
+{
+    mSpriteWidth[index] = width;
+    mSpriteHeight[index] = height;
+}
+
+void SpritePool::SetCurrentFrame(uint32_t index, int row, int col)
+{
+    mCurrentRow[index] = row;
+    mCurrentCol[index] = col;
+}
+
+void SpritePool::Draw(uint32_t index, SpriteRenderer* renderer) const
+{
+    Texture* texture = mTextures[index].get();
+    if (!renderer || !texture) return;
+
+    // If sprite size is 0 or texture size, use full texture
+    float texW = static_cast<float>(texture->GetWidth());
+    float texH = static_cast<float>(texture->GetHeight());
+
+    // Default to full texture if sprite size is not set or matches texture
+    float spriteW = (mSpriteWidth[index] > 0) ? static_cast<float>(mSpriteWidth[index]) : texW;
+    float spriteH = (mSpriteHeight[index] > 0) ? static_cast<float>(mSpriteHeight[index]) : texH;
+
+    // Calculate texture coordinates
+    Vector2 srcPos((mCurrentCol[index] * spriteW) / texW,
+                   (mCurrentRow[index] * spriteH) / texH);
+    Vector2 srcSize(spriteW / texW, spriteH / texH);
+
+    // Draw position (centered on actor position, interpolated between simulation steps)
+    float renderSize = mRenderSize[index];
+    Vector2 pos = mOwners[index]->GetRenderPosition();
+    Vector2 drawPos(pos.x - renderSize/2, pos.y - renderSize/2);
+    Vector2 drawSize(renderSize, renderSize);
+
+    // Draw using sprite sheet with source rectangle
+    renderer->DrawSprite(texture, drawPos, drawSize, srcPos, srcSize, 0.0f,
+                        Vector3(1.0f, 1.0f, 1.0f), mFlipHorizontal[index] != 0, false);
+}
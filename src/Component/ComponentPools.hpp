@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../MathUtils.h"
+
+class Actor;
+class TileMap;
+class Texture;
+class SpriteRenderer;
+class MovementComponent;
+class AnimationComponent;
+class SpriteComponent;
+
+// Structure-of-arrays storage for the hot per-frame components.
+// Game owns one pool per type. The component objects attached to actors are
+// thin handles that keep their index into the pool; the per-frame work runs
+// as batch systems over the arrays (Game::UpdateGame) instead of through each
+// actor's virtual Update. Removal swaps the last entry into the hole and
+// patches that component's index. Pools are main-thread only for add/remove;
+// disjoint Update ranges may run in parallel.
+
+class MovementPool
+{
+public:
+    uint32_t Add(MovementComponent* component, Actor* owner);
+    void Remove(uint32_t index);
+    size_t Size() const { return mComponents.size(); }
+
+    // Movement system: integrates entries [begin, end) against the tile map
+    void Update(float deltaTime, size_t begin, size_t end, const TileMap* tileMap);
+
+    Vector2 GetVelocity(uint32_t index) const { return Vector2(mVelocityX[index], mVelocityY[index]); }
+    void SetVelocity(uint32_t index, const Vector2& velocity);
+    void AddImpulse(uint32_t index, const Vector2& impulse);
+    void SetBoundsChecking(uint32_t index, bool enabled) { mUseBounds[index] = enabled ? 1 : 0; }
+    void SetBounds(uint32_t index, float minX, float minY, float maxX, float maxY);
+    void SetColliderSize(uint32_t index, float width, float height);
+    Vector2 GetColliderHalfSize(uint32_t index) const { return Vector2(mColliderHalfX[index], mColliderHalfY[index]); }
+
+private:
+    std::vector<MovementComponent*> mComponents;
+    std::vector<Actor*> mOwners;
+    std::vector<float> mVelocityX;
+    std::vector<float> mVelocityY;
+    std::vector<float> mImpulseX;       // Additional velocity from impulses (knockback)
+    std::vector<float> mImpulseY;
+    std::vector<float> mImpulseDecay;   // How fast impulse decays (friction)
+    std::vector<float> mMinX;
+    std::vector<float> mMinY;
+    std::vector<float> mMaxX;
+    std::vector<float> mMaxY;
+    std::vector<uint8_t> mUseBounds;
+    std::vector<float> mColliderHalfX;  // Tile collision box, centered on the position
+    std::vector<float> mColliderHalfY;
+};
+
+class AnimationPool
+{
+public:
+    uint32_t Add(AnimationComponent* component);
+    void Remove(uint32_t index);
+    size_t Size() const { return mComponents.size(); }
+
+    // Animation system: advances frames of entries [begin, end)
+    void Update(float deltaTime, size_t begin, size_t end);
+
+    int GetFrame(uint32_t index) const { return mFrame[index]; }
+    void SetFrameCount(uint32_t index, int frames) { mMaxFrames[index] = frames; }
+    void SetAnimSpeed(uint32_t index, float fps) { mAnimSpeed[index] = fps; }
+    void Reset(uint32_t index) { mAnimTime[index] = 0.0f; mFrame[index] = 0; }
+
+private:
+    std::vector<AnimationComponent*> mComponents;
+    std::vector<float> mAnimTime;
+    std::vector<float> mAnimSpeed;
+    std::vector<int> mFrame;
+    std::vector<int> mMaxFrames;
+};
+
+class SpritePool
+{
+public:
+    uint32_t Add(SpriteComponent* component, Actor* owner);
+    void Remove(uint32_t index);
+    size_t Size() const { return mComponents.size(); }
+
+    void Draw(uint32_t index, SpriteRenderer* renderer) const;
+
+    Texture* GetTexture(uint32_t index) const { return mTextures[index].get(); }
+    void SetTexture(uint32_t index, std::shared_ptr<Texture> texture) { mTextures[index] = std::move(texture); }
+    void SetSpriteSize(uint32_t index, int width, int height);
+    void SetCurrentFrame(uint32_t index, int row, int col);
+    void SetFlipHorizontal(uint32_t index, bool flip) { mFlipHorizontal[index] = flip ? 1 : 0; }
+    void SetRenderSize(uint32_t index, float size) { mRenderSize[index] = size; }
+
+private:
+    std::vector<SpriteComponent*> mComponents;
+    std::vector<Actor*> mOwners;
+    std::vector<std::shared_ptr<Texture>> mTextures;
+    std::vector<int> mSpriteWidth;
+    std::vector<int> mSpriteHeight;
+    std::vector<int> mCurrentRow;
+    std::vector<int> mCurrentCol;
+    std::vector<float> mRenderSize;
+    std::vector<uint8_t> mFlipHorizontal;
+};
@@ -1,5 +1,6 @@
 #include "HealthComponent.hpp"
 #include "../Actor/Actor.hpp"
+#include "../Game/CommandBuffer.hpp"
 #include <SDL.h>
 #include <algorithm>
 
@@ -13,6 +14,13 @@ HealthComponent::HealthComponent(Actor* owner, int updateOrder)
 
 void HealthComponent::TakeDamage(float damage)
 {
+    // Inside a parallel update: apply at the sync point
+    if (CommandBuffer* commands = CommandBuffer::Current())
+    {
+        commands->TakeDamage(this, damage);
+        return;
+    }
+
     if (IsDead()) return;
 
     mCurrentHealth -= damage;
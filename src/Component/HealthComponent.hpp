@@ -6,7 +6,10 @@
 class HealthComponent : public Component
 {
 public:
+    static constexpr ComponentType StaticType = ComponentType::Health;
+
     HealthComponent(class Actor* owner, int updateOrder = 100);
+    ComponentType GetType() const override { return StaticType; }
 
     // Health management
     void TakeDamage(float damage);
@@ -1,30 +1,43 @@
 #pragma once
 #include "Component.hpp"
+#include "ComponentPools.hpp"
 #include "../MathUtils.h"
 
-// Component that handles physics/movement updates
+// Component that handles physics/movement updates.
+// State lives in Game's MovementPool; the movement system integrates all
+// entries in bulk after the actor updates.
 class MovementComponent : public Component
 {
 public:
+    static constexpr ComponentType StaticType = ComponentType::Movement;
+
     MovementComponent(class Actor* owner, int updateOrder = 100);
+    ~MovementComponent();
+    ComponentType GetType() const override { return StaticType; }
     
+    // Steps only this component (the movement system normally does this)
     void Update(float deltaTime) override;
     
     // Set the velocity for this frame
-    void SetVelocity(const Vector2& velocity) { mVelocity = velocity; }
-    const Vector2& GetVelocity() const { return mVelocity; }
+    void SetVelocity(const Vector2& velocity) { mPool->SetVelocity(mPoolIndex, velocity); }
+    Vector2 GetVelocity() const { return mPool->GetVelocity(mPoolIndex); }
     
     // Apply an impulse (for knockback, etc.)
     void ApplyImpulse(const Vector2& impulse);
 
     // Enable/disable bounds checking
-    void SetBoundsChecking(bool enabled) { mUseBounds = enabled; }
+    void SetBoundsChecking(bool enabled) { mPool->SetBoundsChecking(mPoolIndex, enabled); }
     void SetBounds(float minX, float minY, float maxX, float maxY);
+
+    // Size of the box collided against the tile map (default 32x32, centered)
+    void SetColliderSize(float width, float height) { mPool->SetColliderSize(mPoolIndex, width, height); }
+    // Characters fill about the middle half of their frame; collide that body
+    void FitColliderToSprite(float renderSize) { SetColliderSize(renderSize * 0.5f, renderSize * 0.5f); }
+    Vector2 GetColliderHalfSize() const { return mPool->GetColliderHalfSize(mPoolIndex); }
     
 private:
-    Vector2 mVelocity;
-    Vector2 mImpulseVelocity;  // Additional velocity from impulses (knockback)
-    float mImpulseDecay;        // How fast impulse decays (friction)
-    bool mUseBounds;
-    float mMinX, mMinY, mMaxX, mMaxY;
+    friend class MovementPool;
+
+    MovementPool* mPool;
+    uint32_t mPoolIndex;
 };
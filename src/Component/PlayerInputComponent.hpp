@@ -7,7 +7,10 @@
 class PlayerInputComponent : public Component
 {
 public:
+    static constexpr ComponentType StaticType = ComponentType::PlayerInput;
+
     PlayerInputComponent(class Actor* owner, int updateOrder = 100);
+    ComponentType GetType() const override { return StaticType; }
     
     void ProcessInput(const uint8_t* keyState) override;
     
@@ -1,15 +1,19 @@
 #pragma once
 #include "Component.hpp"
+#include "ComponentPools.hpp"
 #include "../Core/Texture/Texture.hpp"
 #include "../MathUtils.h"
 #include <memory>
 #include <string>
 
-// Component that handles sprite rendering
+// Component that handles sprite rendering (state lives in Game's SpritePool)
 class SpriteComponent : public Component
 {
 public:
+    static constexpr ComponentType StaticType = ComponentType::Sprite;
+
     SpriteComponent(class Actor* owner, int updateOrder = 200);
+    ComponentType GetType() const override { return StaticType; }
     ~SpriteComponent();
     
     // Load sprite sheet
@@ -21,21 +25,18 @@ public:
     // Sprite sheet configuration
     void SetSpriteSize(int width, int height);
     void SetCurrentFrame(int row, int col);
-    void SetFlipHorizontal(bool flip) { mFlipHorizontal = flip; }
-    void SetRenderSize(float size) { mRenderSize = size; }
+    void SetFlipHorizontal(bool flip) { mPool->SetFlipHorizontal(mPoolIndex, flip); }
+    void SetRenderSize(float size) { mPool->SetRenderSize(mPoolIndex, size); }
     
     // Getters
-    Texture* GetTexture() const { return mTexture.get(); }
+    Texture* GetTexture() const { return mPool->GetTexture(mPoolIndex); }
     
     // Set texture directly
     void SetTexture(std::shared_ptr<Texture> texture);
 
 private:
-    std::shared_ptr<Texture> mTexture;
-    int mSpriteWidth;
-    int mSpriteHeight;
-    int mCurrentRow;
-    int mCurrentCol;
-    float mRenderSize;
-    bool mFlipHorizontal;
+    friend class SpritePool;
+
+    SpritePool* mPool;
+    uint32_t mPoolIndex;
 };
@@ -4,6 +4,7 @@
 
 Camera::Camera(float width, float height)
     : mPosition(Vector2::Zero)
+    , mPreviousPosition(Vector2::Zero)
     , mWidth(width)
     , mHeight(height)
     , mTargetPosition(Vector2::Zero)
@@ -13,6 +14,8 @@ Camera::Camera(float width, float height)
 
 void Camera::Update(float deltaTime, const Vector2& playerPos, int mapWidthPixels, int mapHeightPixels)
 {
+    mPreviousPosition = mPosition;
+
     // Calculate which "screen" the player is in
     // We want the camera to be at (col * width, row * height)
     // We use the center of the player to determine the screen
@@ -53,3 +56,8 @@ void Camera::Update(float deltaTime, const Vector2& playerPos, int mapWidthPixel
         mPosition = mPosition + diff * mTransitionSpeed * deltaTime;
     }
 }
+
+Vector2 Camera::GetRenderPosition(float alpha) const
+{
+    return Vector2::Lerp(mPreviousPosition, mPosition, alpha);
+}
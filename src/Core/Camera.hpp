@@ -9,10 +9,14 @@ public:
     void Update(float deltaTime, const Vector2& playerPos, int mapWidth, int mapHeight);
     
     const Vector2& GetPosition() const { return mPosition; }
-    void SetPosition(const Vector2& pos) { mPosition = pos; mTargetPosition = pos; }
+    void SetPosition(const Vector2& pos) { mPosition = pos; mPreviousPosition = pos; mTargetPosition = pos; }
+
+    // Position interpolated between the last two simulation steps
+    Vector2 GetRenderPosition(float alpha) const;
     
 private:
     Vector2 mPosition;
+    Vector2 mPreviousPosition;
     float mWidth;
     float mHeight;
     
@@ -0,0 +1,152 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+
+void JobSystem::WorkQueue::Push(const Job& job)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mJobs.push_back(job);
+}
+
+bool JobSystem::WorkQueue::Pop(Job& job)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mJobs.empty()) return false;
+
+    job = mJobs.back();
+    mJobs.pop_back();
+    return true;
+}
+
+bool JobSystem::WorkQueue::Steal(Job& job)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mJobs.empty()) return false;
+
+    job = mJobs.front();
+    mJobs.pop_front();
+    return true;
+}
+
+JobSystem::JobSystem(int workerCount)
+    : mQueuedJobs(0)
+    , mRemainingJobs(0)
+    , mShutdown(false)
+{
+    if (workerCount < 0)
+    {
+        int cores = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = std::max(0, cores - 1);
+    }
+
+    for (int i = 0; i <= workerCount; i++)
+    {
+        mQueues.emplace_back(std::make_unique<WorkQueue>());
+    }
+
+    for (int i = 1; i <= workerCount; i++)
+    {
+        mWorkers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mShutdown = true;
+    }
+    mWakeCondition.notify_all();
+
+    for (auto& worker : mWorkers)
+    {
+        worker.join();
+    }
+}
+
+void JobSystem::ParallelFor(int count, const std::function<void(int)>& job)
+{
+    if (count <= 0) return;
+
+    // Nothing to share the work with
+    if (mWorkers.empty() || count == 1)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            job(i);
+        }
+        return;
+    }
+
+    mRemainingJobs.store(count, std::memory_order_relaxed);
+    mQueuedJobs.fetch_add(count, std::memory_order_relaxed);
+
+    // Deal the jobs out round-robin; stealing evens out uneven jobs
+    int queueCount = static_cast<int>(mQueues.size());
+    for (int i = 0; i < count; i++)
+    {
+        mQueues[i % queueCount]->Push({&job, i});
+    }
+
+    {
+        // Taking the lock orders the wake-up after a worker's predicate check
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+    }
+    mWakeCondition.notify_all();
+
+    // Help out until everything is done
+    while (mRemainingJobs.load(std::memory_order_acquire) > 0)
+    {
+        Job next;
+        if (FindJob(0, next))
+        {
+            RunJob(next);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::WorkerLoop(int queueIndex)
+{
+    while (true)
+    {
+        Job job;
+        if (FindJob(queueIndex, job))
+        {
+            RunJob(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mWakeMutex);
+        mWakeCondition.wait(lock, [this]() {
+            return mShutdown || mQueuedJobs.load(std::memory_order_relaxed) > 0;
+        });
+
+        if (mShutdown) return;
+    }
+}
+
+bool JobSystem::FindJob(int queueIndex, Job& job)
+{
+    bool found = mQueues[queueIndex]->Pop(job);
+
+    int queueCount = static_cast<int>(mQueues.size());
+    for (int i = 1; i < queueCount && !found; i++)
+    {
+        found = mQueues[(queueIndex + i) % queueCount]->Steal(job);
+    }
+
+    if (found)
+    {
+        mQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return found;
+}
+
+void JobSystem::RunJob(const Job& job)
+{
+    (*job.function)(job.index);
+    mRemainingJobs.fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork-join job system with one work-stealing queue per thread.
+// ParallelFor spreads its jobs over the queues; each thread drains its own
+// queue from the back and steals from the front of the others when it runs
+// dry. The calling thread takes part, so a system with zero workers simply
+// runs every job inline.
+class JobSystem
+{
+public:
+    // workerCount < 0 picks one thread per core (the caller counts as one)
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int GetWorkerCount() const { return static_cast<int>(mWorkers.size()); }
+
+    // Runs job(0) ... job(count - 1) and returns once all of them finished.
+    // Jobs must not call ParallelFor themselves.
+    void ParallelFor(int count, const std::function<void(int)>& job);
+
+private:
+    struct Job
+    {
+        const std::function<void(int)>* function;
+        int index;
+    };
+
+    // Owner pushes/pops at the back, thieves take from the front
+    class WorkQueue
+    {
+    public:
+        void Push(const Job& job);
+        bool Pop(Job& job);
+        bool Steal(Job& job);
+
+    private:
+        std::mutex mMutex;
+        std::deque<Job> mJobs;
+    };
+
+    void WorkerLoop(int queueIndex);
+    bool FindJob(int queueIndex, Job& job);
+    void RunJob(const Job& job);
+
+    // Queue 0 belongs to the thread calling ParallelFor
+    std::vector<std::unique_ptr<WorkQueue>> mQueues;
+    std::vector<std::thread> mWorkers;
+
+    std::atomic<int> mQueuedJobs;     // Pushed but not yet picked up
+    std::atomic<int> mRemainingJobs;  // Not yet finished
+    std::mutex mWakeMutex;
+    std::condition_variable mWakeCondition;
+    bool mShutdown;
+};
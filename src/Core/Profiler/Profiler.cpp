@@ -0,0 +1,416 @@
+#include "Profiler.hpp"
+#include "../../Actor/Actor.hpp"
+#include "../TextRenderer/TextRenderer.hpp"
+#include "../RectRenderer/RectRenderer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <typeinfo>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+Profiler& Profiler::Instance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler()
+    : mFrames(new FrameRecord[MAX_FRAMES])
+    , mCurrentFrame(0)
+    , mFrameCount(0)
+    , mNextFrameIndex(0)
+    , mInFrame(false)
+    , mEnabled(false)
+    , mOverlayVisible(false)
+    , mDepth(0)
+    , mEpochNs(NowNs())
+    , mOwnerThread(std::this_thread::get_id())
+{
+}
+
+Profiler::~Profiler()
+{
+    delete[] mFrames;
+}
+
+uint64_t Profiler::NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::ToggleOverlay()
+{
+    mOverlayVisible = !mOverlayVisible;
+    if (mOverlayVisible)
+    {
+        mEnabled = true;
+    }
+}
+
+void Profiler::BeginFrame()
+{
+    if (!mEnabled || !IsRecordingThread()) return;
+
+    FrameRecord& frame = mFrames[mCurrentFrame];
+    frame.index = mNextFrameIndex++;
+    frame.startNs = NowNs() - mEpochNs;
+    frame.durationNs = 0;
+    frame.zoneCount = 0;
+    frame.droppedZones = 0;
+    frame.actorTypeCount = 0;
+
+    mDepth = 0;
+    mInFrame = true;
+}
+
+void Profiler::EndFrame()
+{
+    if (!mInFrame) return;
+
+    FrameRecord& frame = mFrames[mCurrentFrame];
+    frame.durationNs = (NowNs() - mEpochNs) - frame.startNs;
+
+    mInFrame = false;
+    mCurrentFrame = (mCurrentFrame + 1) % MAX_FRAMES;
+    mFrameCount = std::min(mFrameCount + 1, MAX_FRAMES);
+}
+
+int Profiler::BeginZone(const char* name)
+{
+    if (!mInFrame || !IsRecordingThread()) return -1;
+
+    FrameRecord& frame = mFrames[mCurrentFrame];
+    int depth = mDepth++;
+
+    // Out of room (or nested too deep): keep the depth balanced but drop the sample
+    if (frame.zoneCount >= MAX_ZONES_PER_FRAME || depth >= MAX_DEPTH)
+    {
+        frame.droppedZones++;
+        return MAX_ZONES_PER_FRAME;
+    }
+
+    ZoneSample& zone = frame.zones[frame.zoneCount];
+    zone.name = name;
+    zone.depth = static_cast<uint16_t>(depth);
+    zone.startNs = (NowNs() - mEpochNs) - frame.startNs;
+    zone.durationNs = 0;
+    return frame.zoneCount++;
+}
+
+void Profiler::EndZone(int token)
+{
+    if (!mInFrame || token < 0) return;
+
+    mDepth = std::max(0, mDepth - 1);
+
+    FrameRecord& frame = mFrames[mCurrentFrame];
+    if (token < frame.zoneCount)
+    {
+        ZoneSample& zone = frame.zones[token];
+        zone.durationNs = ((NowNs() - mEpochNs) - frame.startNs) - zone.startNs;
+    }
+}
+
+void Profiler::AddActorSample(const char* typeName, ActorPhase phase, uint64_t durationNs)
+{
+    if (!mInFrame || !IsRecordingThread()) return;
+
+    FrameRecord& frame = mFrames[mCurrentFrame];
+
+    // Few distinct actor types per frame, so a linear scan on the name pointer is enough
+    ActorTypeSample* sample = nullptr;
+    for (int i = 0; i < frame.actorTypeCount; i++)
+    {
+        if (frame.actorTypes[i].typeName == typeName)
+        {
+            sample = &frame.actorTypes[i];
+            break;
+        }
+    }
+
+    if (!sample)
+    {
+        if (frame.actorTypeCount >= MAX_ACTOR_TYPES) return;
+        sample = &frame.actorTypes[frame.actorTypeCount++];
+        *sample = ActorTypeSample{typeName, 0, 0, 0, 0};
+    }
+
+    if (phase == ActorPhase::Update)
+    {
+        sample->updateNs += durationNs;
+        sample->updateCount++;
+    }
+    else
+    {
+        sample->drawNs += durationNs;
+        sample->drawCount++;
+    }
+}
+
+const Profiler::FrameRecord* Profiler::GetFrame(int age) const
+{
+    if (age < 0 || age >= mFrameCount) return nullptr;
+
+    int slot = (mCurrentFrame - 1 - age + MAX_FRAMES) % MAX_FRAMES;
+    return &mFrames[slot];
+}
+
+const char* Profiler::GetReadableTypeName(const char* typeName) const
+{
+    auto it = mTypeNames.find(typeName);
+    if (it != mTypeNames.end())
+    {
+        return it->second.c_str();
+    }
+
+    std::string readable = typeName;
+#ifdef __GNUG__
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(typeName, nullptr, nullptr, &status);
+    if (status == 0 && demangled)
+    {
+        readable = demangled;
+    }
+    std::free(demangled);
+#endif
+
+    return mTypeNames.emplace(typeName, std::move(readable)).first->second.c_str();
+}
+
+bool Profiler::ExportCsv(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+
+    file << "frame,kind,name,depth,start_us,duration_us,count\n";
+
+    char line[256];
+    for (int age = mFrameCount - 1; age >= 0; age--)
+    {
+        const FrameRecord* frame = GetFrame(age);
+        unsigned long long index = static_cast<unsigned long long>(frame->index);
+
+        std::snprintf(line, sizeof(line), "%llu,frame,Frame,0,%.3f,%.3f,1\n",
+                      index, frame->startNs / 1000.0, frame->durationNs / 1000.0);
+        file << line;
+
+        for (int i = 0; i < frame->zoneCount; i++)
+        {
+            const ZoneSample& zone = frame->zones[i];
+            std::snprintf(line, sizeof(line), "%llu,zone,%s,%d,%.3f,%.3f,1\n",
+                          index, zone.name, zone.depth + 1, zone.startNs / 1000.0, zone.durationNs / 1000.0);
+            file << line;
+        }
+
+        for (int i = 0; i < frame->actorTypeCount; i++)
+        {
+            const ActorTypeSample& sample = frame->actorTypes[i];
+            const char* name = GetReadableTypeName(sample.typeName);
+            if (sample.updateCount > 0)
+            {
+                std::snprintf(line, sizeof(line), "%llu,actor_update,%s,,,%.3f,%u\n",
+                              index, name, sample.updateNs / 1000.0, sample.updateCount);
+                file << line;
+            }
+            if (sample.drawCount > 0)
+            {
+                std::snprintf(line, sizeof(line), "%llu,actor_draw,%s,,,%.3f,%u\n",
+                              index, name, sample.drawNs / 1000.0, sample.drawCount);
+                file << line;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+
+    // Trace Event Format: complete ("X") events for zones, counters ("C") for actor types.
+    // Load the file in chrome://tracing or https://ui.perfetto.dev
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    char line[320];
+    bool first = true;
+    auto writeEvent = [&file, &first](const char* event) {
+        if (!first) file << ",\n";
+        file << event;
+        first = false;
+    };
+
+    for (int age = mFrameCount - 1; age >= 0; age--)
+    {
+        const FrameRecord* frame = GetFrame(age);
+        double frameStartUs = frame->startNs / 1000.0;
+
+        std::snprintf(line, sizeof(line),
+                      "{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,"
+                      "\"args\":{\"frame\":%llu,\"dropped_zones\":%d}}",
+                      frameStartUs, frame->durationNs / 1000.0,
+                      static_cast<unsigned long long>(frame->index), frame->droppedZones);
+        writeEvent(line);
+
+        for (int i = 0; i < frame->zoneCount; i++)
+        {
+            const ZoneSample& zone = frame->zones[i];
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                          zone.name, frameStartUs + zone.startNs / 1000.0, zone.durationNs / 1000.0);
+            writeEvent(line);
+        }
+
+        for (int i = 0; i < frame->actorTypeCount; i++)
+        {
+            const ActorTypeSample& sample = frame->actorTypes[i];
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,"
+                          "\"args\":{\"update_us\":%.3f,\"draw_us\":%.3f,\"count\":%u}}",
+                          GetReadableTypeName(sample.typeName), frameStartUs,
+                          sample.updateNs / 1000.0, sample.drawNs / 1000.0,
+                          std::max(sample.updateCount, sample.drawCount));
+            writeEvent(line);
+        }
+    }
+
+    file << "\n]}\n";
+    return true;
+}
+
+void Profiler::DrawOverlay(TextRenderer* textRenderer, RectRenderer* rectRenderer)
+{
+    if (!mOverlayVisible || !textRenderer || !rectRenderer) return;
+
+    const float x = 10.0f;
+    const float y = 10.0f;
+    const float width = 430.0f;
+    const float lineHeight = 18.0f;
+    const float textScale = 0.45f;
+    const float graphHeight = 60.0f;
+    const float graphBudgetMs = 33.3f;  // Top of the graph
+
+    const FrameRecord* last = GetFrame(0);
+
+    // Average/max frame time over the whole ring buffer
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+    for (int age = 0; age < mFrameCount; age++)
+    {
+        double ms = GetFrame(age)->durationNs / 1e6;
+        totalMs += ms;
+        maxMs = std::max(maxMs, ms);
+    }
+    double avgMs = mFrameCount > 0 ? totalMs / mFrameCount : 0.0;
+
+    // Only the two outer zone levels and the costliest actor types are listed
+    int zoneLines = 0;
+    if (last)
+    {
+        for (int i = 0; i < last->zoneCount; i++)
+        {
+            if (last->zones[i].depth <= 1) zoneLines++;
+        }
+    }
+    int actorLines = last ? std::min(last->actorTypeCount, 8) : 0;
+    int lineCount = 2 + zoneLines + (actorLines > 0 ? actorLines + 1 : 0);
+    float height = lineCount * lineHeight + graphHeight + 20.0f;
+
+    rectRenderer->RenderRect(x, y, width, height, Vector3(0.05f, 0.05f, 0.08f), 0.8f);
+    rectRenderer->RenderRectOutline(x, y, width, height, Vector3(1.0f, 1.0f, 1.0f), 0.5f, 1.0f);
+
+    char text[160];
+    float lineY = y + lineHeight;
+    auto drawLine = [&](const Vector3& color) {
+        textRenderer->SetTextColor(color.x, color.y, color.z);
+        textRenderer->RenderText(text, x + 8.0f, lineY, textScale);
+        lineY += lineHeight;
+    };
+
+    std::snprintf(text, sizeof(text), "Frame %.2f ms  (avg %.2f, max %.2f over %d)",
+                  last ? last->durationNs / 1e6 : 0.0, avgMs, maxMs, mFrameCount);
+    drawLine(Vector3(1.0f, 1.0f, 0.6f));
+
+    std::snprintf(text, sizeof(text), "Zones: %d  dropped: %d  [F3 hide, F4 dump]",
+                  last ? last->zoneCount : 0, last ? last->droppedZones : 0);
+    drawLine(Vector3(0.7f, 0.7f, 0.7f));
+
+    if (last)
+    {
+        for (int i = 0; i < last->zoneCount; i++)
+        {
+            const ZoneSample& zone = last->zones[i];
+            if (zone.depth > 1) continue;
+
+            std::snprintf(text, sizeof(text), "%s%-20s %7.3f ms", zone.depth == 0 ? "" : "   ",
+                          zone.name, zone.durationNs / 1e6);
+            drawLine(Vector3(1.0f, 1.0f, 1.0f));
+        }
+
+        if (actorLines > 0)
+        {
+            // Sort a small index list by total cost (no allocation)
+            int order[MAX_ACTOR_TYPES];
+            for (int i = 0; i < last->actorTypeCount; i++) order[i] = i;
+            std::sort(order, order + last->actorTypeCount, [last](int a, int b) {
+                const ActorTypeSample& sa = last->actorTypes[a];
+                const ActorTypeSample& sb = last->actorTypes[b];
+                return sa.updateNs + sa.drawNs > sb.updateNs + sb.drawNs;
+            });
+
+            std::snprintf(text, sizeof(text), "Actor type            update    draw   count");
+            drawLine(Vector3(0.6f, 0.8f, 1.0f));
+
+            for (int i = 0; i < actorLines; i++)
+            {
+                const ActorTypeSample& sample = last->actorTypes[order[i]];
+                std::snprintf(text, sizeof(text), "%-20.20s %6.3f  %6.3f  %5u",
+                              GetReadableTypeName(sample.typeName), sample.updateNs / 1e6,
+                              sample.drawNs / 1e6, std::max(sample.updateCount, sample.drawCount));
+                drawLine(Vector3(1.0f, 1.0f, 1.0f));
+            }
+        }
+    }
+
+    // Frame time history, newest on the right
+    float graphTop = lineY;
+    float graphLeft = x + 8.0f;
+    float graphWidth = width - 16.0f;
+    float barWidth = graphWidth / MAX_FRAMES;
+    rectRenderer->RenderRect(graphLeft, graphTop, graphWidth, graphHeight, Vector3(0.15f, 0.15f, 0.2f), 0.8f);
+
+    for (int age = 0; age < mFrameCount; age++)
+    {
+        double ms = GetFrame(age)->durationNs / 1e6;
+        float barHeight = static_cast<float>(std::min(ms / graphBudgetMs, 1.0) * graphHeight);
+        float barX = graphLeft + graphWidth - (age + 1) * barWidth;
+        Vector3 color = ms > 16.7 ? Vector3(0.9f, 0.3f, 0.3f) : Vector3(0.3f, 0.9f, 0.4f);
+        rectRenderer->RenderRect(barX, graphTop + graphHeight - barHeight, barWidth, barHeight, color, 0.9f);
+    }
+}
+
+ProfileActorScope::ProfileActorScope(const Actor* actor, ActorPhase phase)
+    : mTypeName(nullptr)
+    , mPhase(phase)
+    , mStartNs(0)
+{
+    if (Profiler::Instance().IsEnabled())
+    {
+        mTypeName = typeid(*actor).name();
+        mStartNs = Profiler::NowNs();
+    }
+}
+
+ProfileActorScope::~ProfileActorScope()
+{
+    if (mTypeName)
+    {
+        Profiler::Instance().AddActorSample(mTypeName, mPhase, Profiler::NowNs() - mStartNs);
+    }
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+class TextRenderer;
+class RectRenderer;
+class Actor;
+
+// Which per-actor call is being timed
+enum class ActorPhase
+{
+    Update,
+    Draw
+};
+
+// Frame profiler with scoped timing zones.
+// All storage is allocated up front: the last MAX_FRAMES frames live in a ring
+// buffer, so recording a zone never allocates. Zones are only recorded on the
+// thread that created the profiler (the main thread); others are ignored.
+class Profiler
+{
+public:
+    static constexpr int MAX_FRAMES = 240;
+    static constexpr int MAX_ZONES_PER_FRAME = 256;
+    static constexpr int MAX_ACTOR_TYPES = 64;
+    static constexpr int MAX_DEPTH = 16;
+
+    // One timed zone inside a frame
+    struct ZoneSample
+    {
+        const char* name;
+        uint64_t startNs;      // Relative to the frame start
+        uint64_t durationNs;
+        uint16_t depth;
+    };
+
+    // Per-actor-type cost accumulated over a frame
+    struct ActorTypeSample
+    {
+        const char* typeName;  // typeid name (mangled on GCC/Clang)
+        uint64_t updateNs;
+        uint64_t drawNs;
+        uint32_t updateCount;
+        uint32_t drawCount;
+    };
+
+    struct FrameRecord
+    {
+        uint64_t index;
+        uint64_t startNs;      // Relative to profiler creation
+        uint64_t durationNs;
+        int zoneCount;
+        int droppedZones;
+        int actorTypeCount;
+        ZoneSample zones[MAX_ZONES_PER_FRAME];
+        ActorTypeSample actorTypes[MAX_ACTOR_TYPES];
+    };
+
+    static Profiler& Instance();
+
+    // Recording is off by default; zones are a single branch when disabled
+    void SetEnabled(bool enabled) { mEnabled = enabled; }
+    bool IsEnabled() const { return mEnabled; }
+
+    // Overlay visibility (toggling the overlay on also enables recording)
+    void ToggleOverlay();
+    bool IsOverlayVisible() const { return mOverlayVisible; }
+
+    void BeginFrame();
+    void EndFrame();
+
+    // Returns a token to pass to EndZone (-1 if nothing was recorded)
+    int BeginZone(const char* name);
+    void EndZone(int token);
+
+    void AddActorSample(const char* typeName, ActorPhase phase, uint64_t durationNs);
+
+    // Number of completed frames currently held (<= MAX_FRAMES)
+    int GetFrameCount() const { return mFrameCount; }
+    // 0 = most recent completed frame
+    const FrameRecord* GetFrame(int age) const;
+
+    // Dump all recorded frames
+    bool ExportCsv(const std::string& path) const;
+    bool ExportChromeTrace(const std::string& path) const;
+
+    void DrawOverlay(TextRenderer* textRenderer, RectRenderer* rectRenderer);
+
+    static uint64_t NowNs();
+
+private:
+    Profiler();
+    ~Profiler();
+
+    const char* GetReadableTypeName(const char* typeName) const;
+    bool IsRecordingThread() const { return std::this_thread::get_id() == mOwnerThread; }
+
+    FrameRecord* mFrames;
+    int mCurrentFrame;   // Ring slot being recorded
+    int mFrameCount;
+    uint64_t mNextFrameIndex;
+    bool mInFrame;
+    bool mEnabled;
+    bool mOverlayVisible;
+    int mDepth;
+    uint64_t mEpochNs;
+    std::thread::id mOwnerThread;
+
+    // Demangled actor type names, filled lazily for the overlay/exports
+    mutable std::unordered_map<const char*, std::string> mTypeNames;
+};
+
+// Times the enclosing scope as a named zone
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name)
+        : mToken(Profiler::Instance().IsEnabled() ? Profiler::Instance().BeginZone(name) : -1)
+    {
+    }
+    ~ProfileScope()
+    {
+        if (mToken >= 0)
+        {
+            Profiler::Instance().EndZone(mToken);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    int mToken;
+};
+
+// Times one actor's Update/OnDraw and attributes it to the actor's type
+class ProfileActorScope
+{
+public:
+    ProfileActorScope(const Actor* actor, ActorPhase phase);
+    ~ProfileActorScope();
+
+    ProfileActorScope(const ProfileActorScope&) = delete;
+    ProfileActorScope& operator=(const ProfileActorScope&) = delete;
+
+private:
+    const char* mTypeName;
+    ActorPhase mPhase;
+    uint64_t mStartNs;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_ACTOR(actor, phase) ProfileActorScope PROFILE_CONCAT(profileActor_, __LINE__)(actor, phase)
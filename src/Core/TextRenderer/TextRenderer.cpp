@@ -164,9 +164,9 @@ GlyphInfo TextRenderer::LoadGlyph(uint32_t codepoint, FT_Face face, bool isEmoji
     glBindTexture(GL_TEXTURE_2D, 0);
     return glyph;
 }
-void TextRenderer::RenderText(const std::string& text, float x, float y, float scale) {
+void TextRenderer::RenderText(std::string_view text, float x, float y, float scale) {
     // Convert text to uppercase
-    std::string upperText = text;
+    std::string upperText(text);
     std::transform(upperText.begin(), upperText.end(), upperText.begin(),
                    [](unsigned char c) { return std::toupper(c); });
 
@@ -254,10 +254,10 @@ void TextRenderer::RenderText(const std::string& text, float x, float y, float s
     RenderUtils::DisableBlending();
 }
 
-Vector2 TextRenderer::MeasureText(const std::string& text, float scale) const
+Vector2 TextRenderer::MeasureText(std::string_view text, float scale) const
 {
     // Convert text to uppercase for measurement consistency
-    std::string upperText = text;
+    std::string upperText(text);
     std::transform(upperText.begin(), upperText.end(), upperText.begin(),
                    [](unsigned char c) { return std::toupper(c); });
 
@@ -304,12 +304,12 @@ Vector2 TextRenderer::MeasureText(const std::string& text, float scale) const
     return Vector2(totalWidth, maxHeight);
 }
 
-float TextRenderer::GetTextWidth(const std::string& text, float scale) const
+float TextRenderer::GetTextWidth(std::string_view text, float scale) const
 {
     return MeasureText(text, scale).x;
 }
 
-float TextRenderer::GetTextHeight(const std::string& text, float scale) const
+float TextRenderer::GetTextHeight(std::string_view text, float scale) const
 {
     return MeasureText(text, scale).y;
 }
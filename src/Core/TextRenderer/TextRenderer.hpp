@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -26,13 +27,13 @@ public:
     ~TextRenderer();
 
     bool Initialize(float windowWidth = 800.0f, float windowHeight = 600.0f);
-    void RenderText(const std::string& text, float x, float y, float scale = 1.0f);
+    void RenderText(std::string_view text, float x, float y, float scale = 1.0f);
     void SetTextColor(float r, float g, float b) { mTextColor = Vector3(r, g, b); }
     
     // Calculate text dimensions
-    Vector2 MeasureText(const std::string& text, float scale = 1.0f) const;
-    float GetTextWidth(const std::string& text, float scale = 1.0f) const;
-    float GetTextHeight(const std::string& text, float scale = 1.0f) const;
+    Vector2 MeasureText(std::string_view text, float scale = 1.0f) const;
+    float GetTextWidth(std::string_view text, float scale = 1.0f) const;
+    float GetTextHeight(std::string_view text, float scale = 1.0f) const;
 
     // Get window dimensions
     float GetWindowWidth() const;
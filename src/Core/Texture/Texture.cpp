@@ -4,6 +4,8 @@
 #include <unistd.h>
 #include <fcntl.h>
 
+bool Texture::sHeadless = false;
+
 Texture::Texture()
     : mTextureID(0)
     , mWidth(0)
@@ -18,6 +20,11 @@ Texture::~Texture()
 
 bool Texture::Load(const std::string& fileName)
 {
+    if (sHeadless)
+    {
+        return true;
+    }
+
     // Load from file
     // Suppress libpng warnings by redirecting stderr
     int stderr_backup = dup(STDERR_FILENO);
@@ -94,6 +101,11 @@ bool Texture::CreateForRendering(int width, int height, unsigned int format)
 {
     mWidth = width;
     mHeight = height;
+
+    if (sHeadless)
+    {
+        return true;
+    }
     
     glGenTextures(1, &mTextureID);
     glBindTexture(GL_TEXTURE_2D, mTextureID);
@@ -17,8 +17,15 @@ public:
     int GetWidth() const { return mWidth; }
     int GetHeight() const { return mHeight; }
     GLuint GetTextureID() const { return mTextureID; }
+
+    // When headless there is no GL context: loads succeed without touching
+    // the file or GL, leaving an empty placeholder texture
+    static void SetHeadless(bool headless) { sHeadless = headless; }
+    static bool IsHeadless() { return sHeadless; }
     
 private:
+    static bool sHeadless;
+
     GLuint mTextureID;
     int mWidth;
     int mHeight;
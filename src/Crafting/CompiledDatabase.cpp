@@ -0,0 +1,317 @@
+#include "CompiledDatabase.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char MAGIC[8] = {'S', 'Z', 'D', 'B', 'I', 'T', 'E', 'M'};
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;  // Reads differently on a foreign byte order
+
+    size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    bool SectionFits(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t alignment, size_t fileSize) {
+        if (offset % alignment != 0 || offset > fileSize) return false;
+        return count <= (fileSize - offset) / elementSize;
+    }
+}
+
+struct CompiledDatabase::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t fileSize;
+
+    uint64_t itemsSourceSize;
+    uint64_t itemsSourceHash;
+    uint64_t recipesSourceSize;
+    uint64_t recipesSourceHash;
+
+    uint64_t itemCount;
+    uint64_t itemsOffset;         // ItemRecord[itemCount]
+    uint64_t indexCount;
+    uint64_t indexOffset;         // int32_t[indexCount], item id -> record, -1 if none
+    uint64_t recipeCount;
+    uint64_t recipeCapacity;      // Power of two, or 0
+    uint64_t recipeKeysOffset;    // uint64_t[recipeCapacity]
+    uint64_t recipeResultsOffset; // int32_t[recipeCapacity]
+    uint64_t multiRecipeCount;
+    uint64_t multiRecipeCapacity;      // Power of two, or 0
+    uint64_t multiRecipeKeysOffset;    // MultiRecipeTable::Key[multiRecipeCapacity]
+    uint64_t multiRecipeResultsOffset; // int32_t[multiRecipeCapacity]
+    uint64_t stringBytes;
+    uint64_t stringsOffset;       // Null-terminated UTF-8, deduplicated
+};
+
+struct CompiledDatabase::ItemRecord {
+    int32_t id;
+    uint32_t nameOffset;   // Into the string section
+    uint32_t nameLength;
+    uint32_t emojiOffset;
+    uint32_t emojiLength;
+};
+
+bool SourceStamp::FromFile(const std::string& path, SourceStamp& stamp) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    // FNV-1a over the raw bytes: reading is far cheaper than parsing
+    uint64_t hash = 0xCBF29CE484222325ull;
+    uint64_t size = 0;
+    char chunk[64 * 1024];
+    while (file) {
+        file.read(chunk, sizeof(chunk));
+        std::streamsize read = file.gcount();
+        for (std::streamsize i = 0; i < read; i++) {
+            hash = (hash ^ static_cast<uint8_t>(chunk[i])) * 0x100000001B3ull;
+        }
+        size += static_cast<uint64_t>(read);
+    }
+
+    stamp.size = size;
+    stamp.hash = hash;
+    return true;
+}
+
+CompiledDatabase::~CompiledDatabase() {
+#ifndef _WIN32
+    if (data && buffer.empty()) {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+#endif
+}
+
+std::unique_ptr<CompiledDatabase> CompiledDatabase::Open(const std::string& path, const SourceStamp& itemsSource,
+                                                         const SourceStamp& recipesSource) {
+    std::unique_ptr<CompiledDatabase> database(new CompiledDatabase());
+
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (mapped == MAP_FAILED) return nullptr;
+
+    database->data = static_cast<const uint8_t*>(mapped);
+    database->size = static_cast<size_t>(info.st_size);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return nullptr;
+
+    database->buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(database->buffer.data()), database->buffer.size());
+    if (!file || database->buffer.size() < sizeof(Header)) return nullptr;
+
+    database->data = database->buffer.data();
+    database->size = database->buffer.size();
+#endif
+
+    // Format and layout
+    const Header& header = database->GetHeader();
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.byteOrder != BYTE_ORDER_MARK || header.fileSize != database->size) {
+        return nullptr;
+    }
+
+    // Staleness: compiled from exactly these sources
+    if (header.itemsSourceSize != itemsSource.size || header.itemsSourceHash != itemsSource.hash ||
+        header.recipesSourceSize != recipesSource.size || header.recipesSourceHash != recipesSource.hash) {
+        return nullptr;
+    }
+
+    size_t fileSize = database->size;
+    if (!SectionFits(header.itemsOffset, header.itemCount, sizeof(ItemRecord), alignof(ItemRecord), fileSize) ||
+        !SectionFits(header.indexOffset, header.indexCount, sizeof(int32_t), alignof(int32_t), fileSize) ||
+        !SectionFits(header.recipeKeysOffset, header.recipeCapacity, sizeof(uint64_t), alignof(uint64_t), fileSize) ||
+        !SectionFits(header.recipeResultsOffset, header.recipeCapacity, sizeof(int32_t), alignof(int32_t), fileSize) ||
+        !SectionFits(header.stringsOffset, header.stringBytes, 1, 1, fileSize) ||
+        !SectionFits(header.multiRecipeKeysOffset, header.multiRecipeCapacity, sizeof(MultiRecipeTable::Key),
+                     alignof(MultiRecipeTable::Key), fileSize) ||
+        !SectionFits(header.multiRecipeResultsOffset, header.multiRecipeCapacity, sizeof(int32_t), alignof(int32_t),
+                     fileSize) ||
+        (header.recipeCapacity & (header.recipeCapacity - 1)) != 0 ||
+        header.recipeCount > header.recipeCapacity ||
+        (header.multiRecipeCapacity & (header.multiRecipeCapacity - 1)) != 0 ||
+        header.multiRecipeCount > header.multiRecipeCapacity) {
+        return nullptr;
+    }
+
+    // Every string must lie inside the arena
+    const ItemRecord* records = reinterpret_cast<const ItemRecord*>(database->data + header.itemsOffset);
+    for (uint64_t i = 0; i < header.itemCount; i++) {
+        const ItemRecord& record = records[i];
+        if (static_cast<uint64_t>(record.nameOffset) + record.nameLength > header.stringBytes ||
+            static_cast<uint64_t>(record.emojiOffset) + record.emojiLength > header.stringBytes) {
+            return nullptr;
+        }
+    }
+    const int32_t* index = database->GetItemIndex();
+    for (uint64_t i = 0; i < header.indexCount; i++) {
+        if (index[i] < -1 || index[i] >= static_cast<int64_t>(header.itemCount)) return nullptr;
+    }
+
+    return database;
+}
+
+bool CompiledDatabase::Write(const std::string& path, const std::vector<Item>& items,
+                             const std::vector<int32_t>& itemIndex, const RecipeTable& recipes,
+                             const MultiRecipeTable& multiRecipes, const SourceStamp& itemsSource, const SourceStamp& recipesSource) {
+    // String arena, each distinct string once
+    std::vector<char> strings;
+    std::unordered_map<std::string_view, uint32_t> stringOffsets;
+    auto addString = [&](std::string_view text) {
+        auto it = stringOffsets.find(text);
+        if (it != stringOffsets.end()) return it->second;
+
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings.insert(strings.end(), text.begin(), text.end());
+        strings.push_back('\0');
+        stringOffsets.emplace(text, offset);
+        return offset;
+    };
+
+    std::vector<ItemRecord> records;
+    records.reserve(items.size());
+    for (const Item& item : items) {
+        ItemRecord record;
+        record.id = item.id;
+        record.nameOffset = addString(item.name);
+        record.nameLength = static_cast<uint32_t>(item.name.size());
+        record.emojiOffset = addString(item.emoji);
+        record.emojiLength = static_cast<uint32_t>(item.emoji.size());
+        records.push_back(record);
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.itemsSourceSize = itemsSource.size;
+    header.itemsSourceHash = itemsSource.hash;
+    header.recipesSourceSize = recipesSource.size;
+    header.recipesSourceHash = recipesSource.hash;
+
+    // Sections back to back, each 8-byte aligned
+    size_t offset = AlignUp(sizeof(Header), 8);
+    header.itemCount = records.size();
+    header.itemsOffset = offset;
+    offset = AlignUp(offset + records.size() * sizeof(ItemRecord), 8);
+    header.indexCount = itemIndex.size();
+    header.indexOffset = offset;
+    offset = AlignUp(offset + itemIndex.size() * sizeof(int32_t), 8);
+    header.recipeCount = recipes.Size();
+    header.recipeCapacity = recipes.Capacity();
+    header.recipeKeysOffset = offset;
+    offset = AlignUp(offset + recipes.Capacity() * sizeof(uint64_t), 8);
+    header.recipeResultsOffset = offset;
+    offset = AlignUp(offset + recipes.Capacity() * sizeof(int32_t), 8);
+    header.multiRecipeCount = multiRecipes.Size();
+    header.multiRecipeCapacity = multiRecipes.Capacity();
+    header.multiRecipeKeysOffset = offset;
+    offset = AlignUp(offset + multiRecipes.Capacity() * sizeof(MultiRecipeTable::Key), 8);
+    header.multiRecipeResultsOffset = offset;
+    offset = AlignUp(offset + multiRecipes.Capacity() * sizeof(int32_t), 8);
+    header.stringBytes = strings.size();
+    header.stringsOffset = offset;
+    offset += strings.size();
+    header.fileSize = offset;
+
+    std::vector<uint8_t> image(offset, 0);
+    auto copy = [&image](uint64_t at, const void* source, size_t bytes) {
+        if (bytes > 0) std::memcpy(image.data() + at, source, bytes);
+    };
+    copy(0, &header, sizeof(header));
+    copy(header.itemsOffset, records.data(), records.size() * sizeof(ItemRecord));
+    copy(header.indexOffset, itemIndex.data(), itemIndex.size() * sizeof(int32_t));
+    copy(header.recipeKeysOffset, recipes.KeyData(), recipes.Capacity() * sizeof(uint64_t));
+    copy(header.recipeResultsOffset, recipes.ResultData(), recipes.Capacity() * sizeof(int32_t));
+    copy(header.multiRecipeKeysOffset, multiRecipes.KeyData(), multiRecipes.Capacity() * sizeof(MultiRecipeTable::Key));
+    copy(header.multiRecipeResultsOffset, multiRecipes.ResultData(), multiRecipes.Capacity() * sizeof(int32_t));
+    copy(header.stringsOffset, strings.data(), strings.size());
+
+    // Write next to the target and rename over it, so a running game never maps a half-written file
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open database file for writing: " << temporary << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        if (!file) {
+            std::cerr << "Failed to write database file: " << temporary << std::endl;
+            return false;
+        }
+    }
+    std::remove(path.c_str());  // rename does not replace on every platform
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to move database file into place: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+const CompiledDatabase::Header& CompiledDatabase::GetHeader() const {
+    return *reinterpret_cast<const Header*>(data);
+}
+
+std::string_view CompiledDatabase::GetString(uint32_t offset, uint32_t length) const {
+    return std::string_view(reinterpret_cast<const char*>(data + GetHeader().stringsOffset + offset), length);
+}
+
+size_t CompiledDatabase::GetItemCount() const {
+    return static_cast<size_t>(GetHeader().itemCount);
+}
+
+Item CompiledDatabase::GetItem(size_t i) const {
+    const ItemRecord& record = reinterpret_cast<const ItemRecord*>(data + GetHeader().itemsOffset)[i];
+    return Item(record.id, GetString(record.nameOffset, record.nameLength),
+                GetString(record.emojiOffset, record.emojiLength));
+}
+
+const int32_t* CompiledDatabase::GetItemIndex() const {
+    return reinterpret_cast<const int32_t*>(data + GetHeader().indexOffset);
+}
+
+size_t CompiledDatabase::GetItemIndexCount() const {
+    return static_cast<size_t>(GetHeader().indexCount);
+}
+
+void CompiledDatabase::AttachRecipes(RecipeTable& table, MultiRecipeTable& multiTable) const {
+    const Header& header = GetHeader();
+    if (header.recipeCapacity == 0) {
+        table.Clear();
+    } else {
+        table.Attach(reinterpret_cast<const uint64_t*>(data + header.recipeKeysOffset),
+                     reinterpret_cast<const int32_t*>(data + header.recipeResultsOffset),
+                     static_cast<size_t>(header.recipeCapacity), static_cast<size_t>(header.recipeCount));
+    }
+
+    if (header.multiRecipeCapacity == 0) {
+        multiTable.Clear();
+    } else {
+        multiTable.Attach(reinterpret_cast<const MultiRecipeTable::Key*>(data + header.multiRecipeKeysOffset),
+                          reinterpret_cast<const int32_t*>(data + header.multiRecipeResultsOffset),
+                          static_cast<size_t>(header.multiRecipeCapacity),
+                          static_cast<size_t>(header.multiRecipeCount));
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef COMPILED_DATABASE_HPP
+#define COMPILED_DATABASE_HPP
+
+#include "Item.hpp"
+#include "MultiRecipeTable.hpp"
+#include "RecipeTable.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Size and content hash of a JSON source, stored in the database so a
+// stale one (built from other sources) is detected without parsing
+struct SourceStamp {
+    uint64_t size = 0;
+    uint64_t hash = 0;
+
+    bool operator==(const SourceStamp& other) const { return size == other.size && hash == other.hash; }
+
+    // False if the file cannot be read
+    static bool FromFile(const std::string& path, SourceStamp& stamp);
+};
+
+// Binary form of items.json + recipes.json, written offline by sintezia_dbc.
+// One file: header, item records, the dense id -> index table, the recipe
+// hash tables exactly as RecipeTable and MultiRecipeTable lay them out, and
+// a string arena. At
+// runtime it is memory-mapped read-only and used in place: the recipe table
+// is attached as is, nothing is parsed.
+// Native byte order; a file from another layout or version is rejected.
+class CompiledDatabase {
+public:
+    static const uint32_t VERSION = 2;  // Bump with any format or recipe table Hash change
+
+    ~CompiledDatabase();
+
+    // Maps path; null if it is missing, malformed, of another version, or
+    // was not compiled from these two sources (stale)
+    static std::unique_ptr<CompiledDatabase> Open(const std::string& path, const SourceStamp& itemsSource,
+                                                  const SourceStamp& recipesSource);
+
+    // Writes items, their id -> index table and recipes, stamped with the sources
+    static bool Write(const std::string& path, const std::vector<Item>& items, const std::vector<int32_t>& itemIndex,
+                      const RecipeTable& recipes, const MultiRecipeTable& multiRecipes,
+                      const SourceStamp& itemsSource, const SourceStamp& recipesSource);
+
+    size_t GetItemCount() const;
+    // Item handle for record i (strings interned from the arena)
+    Item GetItem(size_t i) const;
+
+    const int32_t* GetItemIndex() const;
+    size_t GetItemIndexCount() const;
+
+    // Attaches the mapped recipe tables; valid while this is alive
+    void AttachRecipes(RecipeTable& table, MultiRecipeTable& multiTable) const;
+
+private:
+    struct Header;
+    struct ItemRecord;
+
+    CompiledDatabase() = default;
+    CompiledDatabase(const CompiledDatabase&) = delete;
+    CompiledDatabase& operator=(const CompiledDatabase&) = delete;
+
+    const Header& GetHeader() const;
+    std::string_view GetString(uint32_t offset, uint32_t length) const;
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> buffer;  // Used instead of a mapping where mmap is unavailable
+};
+
+#endif // COMPILED_DATABASE_HPP
@@ -0,0 +1,239 @@
+#include "CraftPlanner.hpp"
+#include "../Core/Jobs/JobSystem.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    const size_t EXPAND_CHUNK = 128;  // Bucket items per job
+
+    // |a U b| for sorted, duplicate-free a and b
+    size_t UnionSize(const std::vector<int32_t>& a, const std::vector<int32_t>& b) {
+        size_t i = 0, j = 0, count = 0;
+        while (i < a.size() && j < b.size()) {
+            if (a[i] < b[j]) {
+                i++;
+            } else if (b[j] < a[i]) {
+                j++;
+            } else {
+                i++;
+                j++;
+            }
+            count++;
+        }
+        return count + (a.size() - i) + (b.size() - j);
+    }
+}
+
+void CraftPlanner::Sync(const Crafting& crafting) {
+    if (crafting.GetRevision() == revision) return;
+    revision = crafting.GetRevision();
+
+    // Dense indices in item order; the first item with an id owns it, as in
+    // Crafting, which also keeps ids within MAX_ITEM_ID so indexOfId stays small
+    itemIds.clear();
+    indexOfId.clear();
+    for (const Item& item : crafting.GetAllItems()) {
+        if (item.id < 0 || item.id > Crafting::MAX_ITEM_ID) continue;
+        if (static_cast<size_t>(item.id) >= indexOfId.size()) {
+            indexOfId.resize(item.id + 1, -1);
+        }
+        if (indexOfId[item.id] < 0) {
+            indexOfId[item.id] = static_cast<int32_t>(itemIds.size());
+            itemIds.push_back(item.id);
+        }
+    }
+    size_t itemCount = itemIds.size();
+
+    // Recipes by ingredient: count, then fill (a self-recipe is one edge)
+    offsets.assign(itemCount + 1, 0);
+    crafting.GetRecipes().ForEach([this](int id1, int id2, int resultId) {
+        int32_t index1 = IndexOf(id1), index2 = IndexOf(id2);
+        if (index1 < 0 || index2 < 0 || IndexOf(resultId) < 0) return;
+        offsets[index1 + 1]++;
+        if (index1 != index2) offsets[index2 + 1]++;
+    });
+    for (size_t i = 0; i < itemCount; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    edges.resize(offsets[itemCount]);
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    crafting.GetRecipes().ForEach([&](int id1, int id2, int resultId) {
+        int32_t index1 = IndexOf(id1), index2 = IndexOf(id2), result = IndexOf(resultId);
+        if (index1 < 0 || index2 < 0 || result < 0) return;
+        edges[fill[index1]++] = Edge{index2, result};
+        if (index1 != index2) edges[fill[index2]++] = Edge{index1, result};
+    });
+
+    // Any search in progress was over the old graph
+    heldKey.clear();
+    cost.clear();
+}
+
+int32_t CraftPlanner::IndexOf(int id) const {
+    if (id < 0 || static_cast<size_t>(id) >= indexOfId.size()) return -1;
+    return indexOfId[id];
+}
+
+void CraftPlanner::Reset(const std::vector<int32_t>& held) {
+    size_t itemCount = itemIds.size();
+    heldKey = held;
+    cost.assign(itemCount, -1);
+    depth.assign(itemCount, 0);
+    ingredients.assign(itemCount * 2, -1);
+    settled.assign(itemCount, 0);
+    made.clear();
+    made.resize(itemCount);
+    buckets.clear();
+    nextBucket = 0;
+    settledCount = 0;
+
+    // Held items cost nothing and need nothing made
+    buckets.emplace_back();
+    for (int32_t index : held) {
+        cost[index] = 0;
+        buckets[0].push_back(index);
+    }
+}
+
+bool CraftPlanner::IsBetter(const Candidate& candidate) const {
+    int32_t current = cost[candidate.result];
+    if (current < 0 || candidate.cost < current) return true;
+    if (candidate.cost > current) return false;
+    if (candidate.depth != depth[candidate.result]) return candidate.depth < depth[candidate.result];
+
+    // Same cost and depth: lowest ingredient pair, so the merge order decides nothing
+    const int32_t* best = &ingredients[candidate.result * 2];
+    int32_t low = std::min(candidate.ingredient1, candidate.ingredient2);
+    int32_t bestLow = std::min(best[0], best[1]);
+    if (low != bestLow) return low < bestLow;
+    return std::max(candidate.ingredient1, candidate.ingredient2) < std::max(best[0], best[1]);
+}
+
+void CraftPlanner::Settle(int32_t index) {
+    settled[index] = 1;
+    settledCount++;
+    if (cost[index] == 0) return;
+
+    // This item's plan: both sub-plans (shared steps once) plus its own step
+    const std::vector<int32_t>& plan1 = made[ingredients[index * 2]];
+    const std::vector<int32_t>& plan2 = made[ingredients[index * 2 + 1]];
+    std::vector<int32_t>& plan = made[index];
+    plan.reserve(cost[index]);
+    std::set_union(plan1.begin(), plan1.end(), plan2.begin(), plan2.end(), std::back_inserter(plan));
+    plan.insert(std::lower_bound(plan.begin(), plan.end(), index), index);
+}
+
+void CraftPlanner::Expand(const int32_t* items, size_t count, int32_t bucketCost, std::vector<Candidate>& out) const {
+    for (size_t i = 0; i < count; i++) {
+        int32_t index = items[i];
+        for (uint32_t e = offsets[index]; e < offsets[index + 1]; e++) {
+            const Edge& edge = edges[e];
+            // Both ingredients settled; a pair within this bucket is taken by its larger index
+            if (!settled[edge.other] || settled[edge.result]) continue;
+            if (cost[edge.other] == bucketCost && edge.other > index) continue;
+
+            int32_t newCost = static_cast<int32_t>(UnionSize(made[index], made[edge.other])) + 1;
+            if (cost[edge.result] >= 0 && newCost > cost[edge.result]) continue;  // Dominated
+
+            int32_t newDepth = std::max(depth[index], depth[edge.other]) + 1;
+            out.push_back(Candidate{edge.result, newCost, newDepth, index, edge.other});
+        }
+    }
+}
+
+bool CraftPlanner::SettleNextBucket(int maxSteps) {
+    while (nextBucket < static_cast<int32_t>(buckets.size()) && nextBucket <= maxSteps) {
+        int32_t bucketCost = nextBucket++;
+
+        // Everything still open at this cost is final now: later plans only cost more
+        bucketItems.clear();
+        for (int32_t index : buckets[bucketCost]) {
+            if (!settled[index] && cost[index] == bucketCost) {
+                bucketItems.push_back(index);
+            }
+        }
+        std::vector<int32_t>().swap(buckets[bucketCost]);
+        if (bucketItems.empty()) continue;
+
+        std::sort(bucketItems.begin(), bucketItems.end());
+        bucketItems.erase(std::unique(bucketItems.begin(), bucketItems.end()), bucketItems.end());
+        for (int32_t index : bucketItems) {
+            Settle(index);
+        }
+
+        // Expand in chunks (in parallel when worth it), then merge in chunk order
+        size_t chunkCount = 1;
+        if (jobs && bucketItems.size() >= PARALLEL_BUCKET_SIZE) {
+            chunkCount = (bucketItems.size() + EXPAND_CHUNK - 1) / EXPAND_CHUNK;
+        }
+        if (chunkCandidates.size() < chunkCount) {
+            chunkCandidates.resize(chunkCount);
+        }
+        if (chunkCount == 1) {
+            chunkCandidates[0].clear();
+            Expand(bucketItems.data(), bucketItems.size(), bucketCost, chunkCandidates[0]);
+        } else {
+            jobs->ParallelFor(static_cast<int>(chunkCount), [this, bucketCost](int chunk) {
+                size_t begin = static_cast<size_t>(chunk) * EXPAND_CHUNK;
+                size_t count = std::min(EXPAND_CHUNK, bucketItems.size() - begin);
+                chunkCandidates[chunk].clear();
+                Expand(bucketItems.data() + begin, count, bucketCost, chunkCandidates[chunk]);
+            });
+        }
+
+        for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+            for (const Candidate& candidate : chunkCandidates[chunk]) {
+                if (!IsBetter(candidate)) continue;
+
+                cost[candidate.result] = candidate.cost;
+                depth[candidate.result] = candidate.depth;
+                ingredients[candidate.result * 2] = candidate.ingredient1;
+                ingredients[candidate.result * 2 + 1] = candidate.ingredient2;
+                if (static_cast<size_t>(candidate.cost) >= buckets.size()) {
+                    buckets.resize(candidate.cost + 1);
+                }
+                buckets[candidate.cost].push_back(candidate.result);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+bool CraftPlanner::FindPlan(const std::vector<int>& heldIds, int targetId, Plan& plan, int maxSteps) {
+    plan = Plan();
+    plan.targetId = targetId;
+    int32_t target = IndexOf(targetId);
+    if (target < 0) return false;
+
+    std::vector<int32_t> held;
+    held.reserve(heldIds.size());
+    for (int id : heldIds) {
+        int32_t index = IndexOf(id);
+        if (index >= 0) held.push_back(index);
+    }
+    std::sort(held.begin(), held.end());
+    held.erase(std::unique(held.begin(), held.end()), held.end());
+
+    // Same inventory and graph: carry on with the previous search
+    if (held != heldKey || cost.size() != itemIds.size()) {
+        Reset(held);
+    }
+
+    while (!settled[target] && SettleNextBucket(maxSteps)) {
+    }
+    if (!settled[target] || cost[target] > maxSteps) return false;
+
+    // The target's plan lists every item to make; cheaper ones never depend on dearer ones
+    std::vector<int32_t> order = made[target];
+    std::sort(order.begin(), order.end(), [this](int32_t a, int32_t b) {
+        return cost[a] != cost[b] ? cost[a] < cost[b] : a < b;
+    });
+    for (int32_t index : order) {
+        plan.steps.push_back(Step{itemIds[ingredients[index * 2]], itemIds[ingredients[index * 2 + 1]], itemIds[index]});
+    }
+    plan.depth = depth[target];
+    plan.found = true;
+    return true;
+}
@@ -0,0 +1,118 @@
+#ifndef CRAFT_PLANNER_HPP
+#define CRAFT_PLANNER_HPP
+
+#include "Crafting.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// A short sequence of combinations that makes a target item from the items
+// held. Held items are treated as reusable (the discovery loop of the game:
+// once you have Fogo you can keep combining it), so a plan's cost is the
+// number of distinct combinations, and an intermediate used twice is made
+// once. Its limits:
+// - Combining item actors in the world uses both inputs up, so a plan says
+//   which combinations to make, not how many copies of each input it takes.
+// - Steps are pair recipes only (Crafting::GetRecipes), as combining in the
+//   game is always two items: a recipe of three or more items is never used.
+// - Plans are near-cheapest, not guaranteed cheapest: an item keeps only its
+//   best sub-plan, and a recipe whose inputs have costlier sub-plans that
+//   share more steps can be cheaper than the one built from the best ones
+//   (on exhaustive small synthetic graphs, one step too long for 2 of 1466
+//   targets).
+//
+// Best-first search over items in buckets of plan cost. Every item reached
+// memoizes its sub-plan as the sorted set of items it needs made; a recipe
+// a + b -> r costs |plan(a) U plan(b)| + 1, so shared sub-plans are counted
+// once. A candidate plan for r that is not strictly better than the one
+// found so far (cost, then depth) is dropped. All items of a bucket are
+// final at once, so the bucket is expanded in parallel on the JobSystem and
+// merged in a fixed order, which keeps plans the same for any thread count.
+// The search state is kept for the held set it was run with: asking for
+// another target with the same inventory resumes where the last query
+// stopped instead of starting over.
+class CraftPlanner {
+public:
+    static const int DEFAULT_MAX_STEPS = 32;
+    // Buckets with fewer items than this are expanded on the calling thread
+    static const size_t PARALLEL_BUCKET_SIZE = 512;
+
+    struct Step {
+        int item1Id;
+        int item2Id;
+        int resultId;
+    };
+
+    struct Plan {
+        bool found = false;
+        int targetId = -1;
+        int depth = 0;            // Longest chain of steps
+        std::vector<Step> steps;  // Ingredients are held or made by an earlier step
+    };
+
+    // Rebuilds the recipe graph if crafting changed since the last call
+    void Sync(const Crafting& crafting);
+
+    // Workers for bucket expansion (null: single-threaded). ParallelFor is
+    // called from FindPlan, so FindPlan must not run inside another one.
+    void SetJobSystem(JobSystem* jobs) { this->jobs = jobs; }
+
+    // False (plan.found false) if targetId cannot be made within maxSteps;
+    // an empty plan if it is already held
+    bool FindPlan(const std::vector<int>& heldIds, int targetId, Plan& plan, int maxSteps = DEFAULT_MAX_STEPS);
+
+    size_t GetItemCount() const { return itemIds.size(); }
+    // Items settled by the current search (for profiling)
+    size_t GetSettledCount() const { return settledCount; }
+
+private:
+    struct Edge {
+        int32_t other;   // The other ingredient
+        int32_t result;
+    };
+
+    struct Candidate {
+        int32_t result;
+        int32_t cost;
+        int32_t depth;
+        int32_t ingredient1;
+        int32_t ingredient2;
+    };
+
+    int32_t IndexOf(int id) const;
+    void Reset(const std::vector<int32_t>& held);
+    // Settles the cheapest open bucket; false once nothing is left within maxSteps
+    bool SettleNextBucket(int maxSteps);
+    void Expand(const int32_t* items, size_t count, int32_t bucketCost, std::vector<Candidate>& out) const;
+    bool IsBetter(const Candidate& candidate) const;
+    void Settle(int32_t index);
+
+    uint64_t revision = ~uint64_t(0);
+    JobSystem* jobs = nullptr;
+
+    std::vector<int> itemIds;        // Dense index -> item id
+    std::vector<int32_t> indexOfId;  // Item id -> dense index, -1 if none
+
+    // Recipes by ingredient: edges[offsets[i] .. offsets[i + 1]) use item i
+    std::vector<uint32_t> offsets;
+    std::vector<Edge> edges;
+
+    // Search state for heldKey (sorted held indices)
+    std::vector<int32_t> heldKey;
+    std::vector<int32_t> cost;    // Best plan cost found, -1 if unreached
+    std::vector<int32_t> depth;
+    std::vector<int32_t> ingredients;          // 2 per item: recipe of the best plan
+    std::vector<char> settled;
+    std::vector<std::vector<int32_t>> made;    // Settled items: sorted items the plan makes
+    std::vector<std::vector<int32_t>> buckets; // Items by tentative cost (may hold stale entries)
+    int32_t nextBucket = 0;
+    size_t settledCount = 0;
+
+    // Scratch
+    std::vector<int32_t> bucketItems;
+    std::vector<std::vector<Candidate>> chunkCandidates;
+};
+
+#endif // CRAFT_PLANNER_HPP
@@ -0,0 +1,236 @@
+#include "CraftSuggestions.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    int CountTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int count = 0;
+        while ((word & 1) == 0) {
+            word >>= 1;
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    size_t PopCount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        size_t count = 0;
+        for (; word; word &= word - 1) {
+            count++;
+        }
+        return count;
+#endif
+    }
+}
+
+void CraftSuggestions::Sync(const Crafting& crafting) {
+    if (crafting.GetRevision() == revision) return;
+    revision = crafting.GetRevision();
+
+    // Dense indices in item order; the first item with an id owns it, as in
+    // Crafting, which also keeps ids within MAX_ITEM_ID so indexOfId stays small
+    itemIds.clear();
+    indexOfId.clear();
+    for (const Item& item : crafting.GetAllItems()) {
+        if (item.id < 0 || item.id > Crafting::MAX_ITEM_ID) continue;
+        if (static_cast<size_t>(item.id) >= indexOfId.size()) {
+            indexOfId.resize(item.id + 1, -1);
+        }
+        if (indexOfId[item.id] < 0) {
+            indexOfId[item.id] = static_cast<int32_t>(itemIds.size());
+            itemIds.push_back(item.id);
+        }
+    }
+    size_t itemCount = itemIds.size();
+
+    // Adjacency list: count degrees, then fill (a self-recipe is one entry)
+    offsets.assign(itemCount + 1, 0);
+    crafting.GetRecipes().ForEach([this](int id1, int id2, int) {
+        int32_t index1 = IndexOf(id1), index2 = IndexOf(id2);
+        if (index1 < 0 || index2 < 0) return;
+        offsets[index1 + 1]++;
+        if (index1 != index2) offsets[index2 + 1]++;
+    });
+    for (size_t i = 0; i < itemCount; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<std::pair<int32_t, int32_t>> edges(offsets[itemCount]);  // (neighbor, result)
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    crafting.GetRecipes().ForEach([&](int id1, int id2, int resultId) {
+        int32_t index1 = IndexOf(id1), index2 = IndexOf(id2);
+        if (index1 < 0 || index2 < 0) return;
+        edges[fill[index1]++] = std::make_pair(index2, resultId);
+        if (index1 != index2) edges[fill[index2]++] = std::make_pair(index1, resultId);
+    });
+
+    neighbors.resize(edges.size());
+    results.resize(edges.size());
+    for (size_t i = 0; i < itemCount; i++) {
+        std::sort(edges.begin() + offsets[i], edges.begin() + offsets[i + 1]);
+    }
+    for (size_t e = 0; e < edges.size(); e++) {
+        neighbors[e] = edges[e].first;
+        results[e] = edges[e].second;
+    }
+
+    wordCount = (itemCount + 63) / 64;
+    rows.clear();
+    heldBits.assign(wordCount, 0);
+    heldIndices.clear();
+    heldDoubles.clear();
+}
+
+int32_t CraftSuggestions::IndexOf(int id) const {
+    if (id < 0 || static_cast<size_t>(id) >= indexOfId.size()) return -1;
+    return indexOfId[id];
+}
+
+const CraftSuggestions::Row& CraftSuggestions::GetRow(int32_t index) {
+    auto it = rows.find(index);
+    if (it != rows.end()) {
+        return it->second;
+    }
+
+    // Rows follow what is being held, which changes slowly; dropping them
+    // all now and then is simpler than tracking recency
+    if (rows.size() >= ROW_CACHE_LIMIT) {
+        rows.clear();
+    }
+
+    Row& row = rows[index];
+    uint32_t begin = offsets[index], end = offsets[index + 1];
+    if (begin == end) {
+        return row;  // No recipes: an empty span, no storage
+    }
+
+    row.bits.assign(wordCount, 0);
+    for (uint32_t e = begin; e < end; e++) {
+        row.bits[neighbors[e] >> 6] |= uint64_t(1) << (neighbors[e] & 63);
+    }
+    row.firstWord = static_cast<size_t>(neighbors[begin]) >> 6;
+    row.lastWord = (static_cast<size_t>(neighbors[end - 1]) >> 6) + 1;
+    return row;
+}
+
+int CraftSuggestions::FindResult(int32_t index1, int32_t index2) const {
+    auto begin = neighbors.begin() + offsets[index1];
+    auto end = neighbors.begin() + offsets[index1 + 1];
+    auto it = std::lower_bound(begin, end, index2);
+    return (it != end && *it == index2) ? results[it - neighbors.begin()] : RecipeTable::NO_RESULT;
+}
+
+void CraftSuggestions::SetHeld(const std::vector<HeldItem>& held) {
+    for (int32_t index : heldIndices) {
+        heldBits[index >> 6] = 0;
+    }
+    heldIndices.clear();
+    heldDoubles.clear();
+
+    for (const HeldItem& item : held) {
+        int32_t index = IndexOf(item.id);
+        if (index < 0 || item.quantity <= 0) continue;
+
+        uint64_t bit = uint64_t(1) << (index & 63);
+        if (heldBits[index >> 6] & bit) {
+            heldDoubles.push_back(index);  // Same item in two slots
+        } else {
+            heldBits[index >> 6] |= bit;
+            heldIndices.push_back(index);
+            if (item.quantity >= 2) heldDoubles.push_back(index);
+        }
+    }
+    std::sort(heldDoubles.begin(), heldDoubles.end());
+    heldDoubles.erase(std::unique(heldDoubles.begin(), heldDoubles.end()), heldDoubles.end());
+}
+
+bool CraftSuggestions::IsDense(int32_t index) const {
+    // Testing each neighbor's held bit costs about as much as ANDing a word
+    return (offsets[index + 1] - offsets[index]) * DENSE_ROW_RATIO >= wordCount;
+}
+
+size_t CraftSuggestions::FindCraftablePairs(const std::vector<HeldItem>& held, std::vector<Pair>& pairs) {
+    SetHeld(held);
+    size_t found = 0;
+
+    for (int32_t index : heldIndices) {
+        if (!IsDense(index)) {
+            for (uint32_t e = offsets[index]; e < offsets[index + 1]; e++) {
+                int32_t other = neighbors[e];
+                if (other > index && (heldBits[other >> 6] >> (other & 63) & 1)) {
+                    pairs.push_back(Pair{itemIds[index], itemIds[other], results[e]});
+                    found++;
+                }
+            }
+            continue;
+        }
+
+        const Row& row = GetRow(index);
+
+        // Pairs with a higher index only, so each is reported once
+        size_t ownWord = static_cast<size_t>(index) >> 6;
+        for (size_t w = std::max(row.firstWord, ownWord); w < row.lastWord; w++) {
+            uint64_t word = row.bits[w] & heldBits[w];
+            if (w == ownWord) {
+                word &= ~((uint64_t(2) << (index & 63)) - 1);
+            }
+            for (; word; word &= word - 1) {
+                int32_t other = static_cast<int32_t>((w << 6) + CountTrailingZeros(word));
+                pairs.push_back(Pair{itemIds[index], itemIds[other], FindResult(index, other)});
+                found++;
+            }
+        }
+    }
+
+    // An item combined with itself
+    for (int32_t index : heldDoubles) {
+        int resultId = FindResult(index, index);
+        if (resultId != RecipeTable::NO_RESULT) {
+            pairs.push_back(Pair{itemIds[index], itemIds[index], resultId});
+            found++;
+        }
+    }
+    return found;
+}
+
+size_t CraftSuggestions::FindOneStepAway(const std::vector<HeldItem>& held, std::vector<Pair>& pairs,
+                                         size_t maxPairs) {
+    SetHeld(held);
+    size_t total = 0;
+    size_t added = 0;
+
+    for (int32_t index : heldIndices) {
+        if (!IsDense(index)) {
+            for (uint32_t e = offsets[index]; e < offsets[index + 1]; e++) {
+                int32_t other = neighbors[e];
+                if (heldBits[other >> 6] >> (other & 63) & 1) continue;
+
+                total++;
+                if (added < maxPairs) {
+                    pairs.push_back(Pair{itemIds[index], itemIds[other], results[e]});
+                    added++;
+                }
+            }
+            continue;
+        }
+
+        const Row& row = GetRow(index);
+        for (size_t w = row.firstWord; w < row.lastWord; w++) {
+            uint64_t word = row.bits[w] & ~heldBits[w];
+            if (!word) continue;
+
+            total += PopCount(word);
+            for (; word && added < maxPairs; word &= word - 1, added++) {
+                int32_t other = static_cast<int32_t>((w << 6) + CountTrailingZeros(word));
+                pairs.push_back(Pair{itemIds[index], itemIds[other], FindResult(index, other)});
+            }
+        }
+    }
+    return total;
+}
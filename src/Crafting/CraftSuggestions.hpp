@@ -0,0 +1,83 @@
+#ifndef CRAFT_SUGGESTIONS_HPP
+#define CRAFT_SUGGESTIONS_HPP
+
+#include "Crafting.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// "What can I craft now": which pairs of held items have a recipe, and
+// which unheld items would combine with something held.
+// Pair recipes only (Crafting::GetRecipes): recipes of three or more items
+// are left out, since combining in the game is always two items.
+// The recipe graph is kept as per-item adjacency bitsets over dense item
+// indices. A query ANDs the row of each held item with a bitset of the held
+// items, one 64-bit word at a time over the span of words the row actually
+// uses, and walks the set bits (popcount for totals). Rows are materialized
+// on demand from a compact adjacency list and cached, so memory grows with
+// the items that get queried rather than items squared. Items with few
+// recipes skip the row and test their neighbors against the held bitset
+// directly, which is cheaper than scanning items/64 mostly empty words.
+class CraftSuggestions {
+public:
+    static const size_t ROW_CACHE_LIMIT = 256;  // Rows kept before the cache is dropped
+    // A row is used once an item has at least one recipe per this many words
+    static const size_t DENSE_ROW_RATIO = 8;
+
+    struct HeldItem {
+        int id;
+        int quantity;  // A pair of the same item needs two
+    };
+
+    struct Pair {
+        int item1Id;  // Held
+        int item2Id;  // Held for FindCraftablePairs, missing for FindOneStepAway
+        int resultId;
+    };
+
+    // Rebuilds the graph if crafting changed since the last call
+    void Sync(const Crafting& crafting);
+
+    // Every recipe whose two ingredients are held, each once; returns the count
+    size_t FindCraftablePairs(const std::vector<HeldItem>& held, std::vector<Pair>& pairs);
+
+    // Recipes with one ingredient held and the other not, up to maxPairs;
+    // returns how many there are in total
+    size_t FindOneStepAway(const std::vector<HeldItem>& held, std::vector<Pair>& pairs, size_t maxPairs);
+
+    size_t GetItemCount() const { return itemIds.size(); }
+
+private:
+    struct Row {
+        std::vector<uint64_t> bits;
+        size_t firstWord = 0;  // Words outside [firstWord, lastWord) are zero
+        size_t lastWord = 0;
+    };
+
+    bool IsDense(int32_t index) const;
+    const Row& GetRow(int32_t index);
+    // Result id of the recipe between two item indices
+    int FindResult(int32_t index1, int32_t index2) const;
+    int32_t IndexOf(int id) const;
+    // Fills heldBits/heldIndices from held; clears the previous query's bits
+    void SetHeld(const std::vector<HeldItem>& held);
+
+    uint64_t revision = ~uint64_t(0);
+    std::vector<int> itemIds;        // Dense index -> item id
+    std::vector<int32_t> indexOfId;  // Item id -> dense index, -1 if none
+
+    // Adjacency list: neighbors of index i are neighbors[offsets[i] .. offsets[i + 1]),
+    // sorted, with the recipe result beside each
+    std::vector<uint32_t> offsets;
+    std::vector<int32_t> neighbors;
+    std::vector<int32_t> results;
+
+    size_t wordCount = 0;
+    std::unordered_map<int32_t, Row> rows;
+    std::vector<uint64_t> heldBits;
+    std::vector<int32_t> heldIndices;
+    std::vector<int32_t> heldDoubles;  // Indices held at least twice
+};
+
+#endif // CRAFT_SUGGESTIONS_HPP
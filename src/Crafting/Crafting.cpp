@@ -1,44 +1,100 @@
 #include "Crafting.hpp"
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <utility>
 
-Crafting::Crafting() {
+namespace {
+    // Shared by every instance, so a reloaded Crafting never repeats a
+    // revision that derived data was built from
+    std::atomic<uint64_t> revisionCounter{1};
+
+    uint64_t NextRevision() {
+        return revisionCounter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // The two ids if key is two single items (or one item twice)
+    bool AsPair(const MultiRecipeTable::Key& key, int& item1Id, int& item2Id) {
+        if (MultiRecipeTable::TotalQuantity(key) != 2) return false;
+        item1Id = static_cast<int>(key.lanes[0] >> 32);
+        bool twice = key.lanes[1] == MultiRecipeTable::EMPTY_LANE;
+        item2Id = static_cast<int>(key.lanes[twice ? 0 : 1] >> 32);
+        return true;
+    }
+
+    // False (with a warning) if a quantity is above MultiRecipeTable::MAX_QUANTITY
+    bool IngredientsFromJson(const json& ingredientsJson, std::vector<Ingredient>& ingredients) {
+        for (const auto& ingredientJson : ingredientsJson) {
+            Ingredient ingredient{ingredientJson.at("item_id").get<int>(), ingredientJson.value("quantity", 1)};
+            if (ingredient.quantity > MultiRecipeTable::MAX_QUANTITY) {
+                std::cerr << "Warning: Quantity " << ingredient.quantity << " of ingredient ID " << ingredient.itemId
+                          << " is above " << MultiRecipeTable::MAX_QUANTITY << ", skipping recipe" << std::endl;
+                return false;
+            }
+            ingredients.push_back(ingredient);
+        }
+        return true;
+    }
 }
 
-Crafting::~Crafting() {
+Crafting::Crafting()
+    : revision(NextRevision()) {
 }
 
-std::string Crafting::CreateRecipeKey(int id1, int id2) const {
-    // Always use the smaller ID first to ensure consistency
-    int minId = std::min(id1, id2);
-    int maxId = std::max(id1, id2);
-    return std::to_string(minId) + "," + std::to_string(maxId);
+Crafting::~Crafting() {
 }
 
 void Crafting::RegisterRecipe(int item1Id, int item2Id, int resultId) {
-    std::string key = CreateRecipeKey(item1Id, item2Id);
-    
-    // Find the result item from the items list
-    const Item* resultItem = FindItemById(resultId);
-    if (resultItem) {
-        recipes[key] = std::make_unique<Item>(resultItem->id, resultItem->name, resultItem->emoji);
+    // The result item must exist in the items list
+    if (FindItemById(resultId)) {
+        recipes.Insert(item1Id, item2Id, resultId);
+        revision = NextRevision();
     } else {
         std::cerr << "Warning: Result item with ID " << resultId << " not found!" << std::endl;
     }
 }
 
-std::unique_ptr<Item> Crafting::combine_items(const Item& item1, const Item& item2) {
-    std::string key = CreateRecipeKey(item1.id, item2.id);
-    
-    auto it = recipes.find(key);
-    if (it != recipes.end()) {
-        // Create a copy of the result item
-        return std::make_unique<Item>(it->second->id, it->second->name, it->second->emoji);
+bool Crafting::RegisterRecipe(const std::vector<Ingredient>& ingredients, int resultId) {
+    MultiRecipeTable::Key key;
+    int item1Id, item2Id;
+    if (!MultiRecipeTable::MakeKey(ingredients.data(), ingredients.size(), key) ||
+        MultiRecipeTable::TotalQuantity(key) < 2) {
+        std::cerr << "Warning: Recipe for item ID " << resultId << " needs 2 to "
+                  << MultiRecipeTable::MAX_INGREDIENTS << " distinct valid ingredients" << std::endl;
+        return false;
     }
-    
-    // No valid recipe found
-    return nullptr;
+    if (!FindItemById(resultId)) {
+        std::cerr << "Warning: Result item with ID " << resultId << " not found!" << std::endl;
+        return false;
+    }
+    if (AsPair(key, item1Id, item2Id)) {
+        RegisterRecipe(item1Id, item2Id, resultId);
+    } else {
+        multiRecipes.Insert(key, resultId);
+        revision = NextRevision();
+    }
+    return true;
+}
+
+int Crafting::FindRecipe(const Ingredient* ingredients, size_t count) const {
+    MultiRecipeTable::Key key;
+    if (!MultiRecipeTable::MakeKey(ingredients, count, key)) return RecipeTable::NO_RESULT;
+
+    int item1Id, item2Id;
+    if (AsPair(key, item1Id, item2Id)) {
+        return recipes.Find(item1Id, item2Id);
+    }
+    return multiRecipes.Find(key);
+}
+
+const Item* Crafting::combine_items(const Item& item1, const Item& item2) const {
+    int resultId = recipes.Find(item1.id, item2.id);
+    if (resultId == RecipeTable::NO_RESULT) {
+        // No valid recipe found
+        return nullptr;
+    }
+    return FindItemById(resultId);
 }
 
 bool Crafting::LoadItemsFromJson(const std::string& filepath) {
@@ -51,10 +107,23 @@ bool Crafting::LoadItemsFromJson(const std::string& filepath) {
     try {
         json j;
         file >> j;
+
+        // Checked up front, so a bad file leaves the current items in place
+        std::vector<Item> loaded;
+        for (const auto& itemJson : j["items"]) {
+            loaded.push_back(Item::fromJson(itemJson));
+            if (loaded.back().id > MAX_ITEM_ID) {
+                std::cerr << "Error: Item '" << loaded.back().name << "' in " << filepath << " has ID "
+                          << loaded.back().id << ", above the maximum of " << MAX_ITEM_ID << std::endl;
+                return false;
+            }
+        }
         
         items.clear();
-        for (const auto& itemJson : j["items"]) {
-            items.push_back(Item::fromJson(itemJson));
+        itemIndex.clear();
+        revision = NextRevision();
+        for (const Item& item : loaded) {
+            AddItem(item);
         }
         
         // std::cout << "Loaded " << items.size() << " items from " << filepath << std::endl;
@@ -76,23 +145,36 @@ bool Crafting::LoadRecipesFromJson(const std::string& filepath) {
         json j;
         file >> j;
         
-        recipes.clear();
+        const json& recipesJson = j["recipes"];
+        recipes.Clear();  // Also detaches from a compiled database
+        multiRecipes.Clear();
+        compiled.reset();
+        revision = NextRevision();
+        recipes.Reserve(recipesJson.size());
         int recipeCount = 0;
         
-        for (const auto& recipeJson : j["recipes"]) {
-            int item1Id = recipeJson.at("item1_id").get<int>();
-            int item2Id = recipeJson.at("item2_id").get<int>();
+        for (const auto& recipeJson : recipesJson) {
             int resultId = recipeJson.at("result_id").get<int>();
             
             // Find the result item from loaded items
-            const Item* resultItem = FindItemById(resultId);
-            if (resultItem) {
-                std::string key = CreateRecipeKey(item1Id, item2Id);
-                recipes[key] = std::make_unique<Item>(resultItem->id, resultItem->name, resultItem->emoji);
-                recipeCount++;
-            } else {
+            if (!FindItemById(resultId)) {
                 std::cerr << "Warning: Recipe references unknown result item ID: " << resultId << std::endl;
+                continue;
             }
+
+            // "ingredients": [{"item_id", "quantity"}, ...] for anything but a plain pair
+            if (recipeJson.contains("ingredients")) {
+                std::vector<Ingredient> ingredients;
+                if (!IngredientsFromJson(recipeJson["ingredients"], ingredients) ||
+                    !RegisterRecipe(ingredients, resultId)) {
+                    continue;
+                }
+            } else {
+                int item1Id = recipeJson.at("item1_id").get<int>();
+                int item2Id = recipeJson.at("item2_id").get<int>();
+                recipes.Insert(item1Id, item2Id, resultId);
+            }
+            recipeCount++;
         }
         
         // std::cout << "Loaded " << recipeCount << " recipes from " << filepath << std::endl;
@@ -103,15 +185,70 @@ bool Crafting::LoadRecipesFromJson(const std::string& filepath) {
     }
 }
 
-void Crafting::AddItem(const Item& item) {
+bool Crafting::LoadCompiled(const std::string& dbPath, const std::string& itemsPath, const std::string& recipesPath) {
+    SourceStamp itemsSource, recipesSource;
+    if (!SourceStamp::FromFile(itemsPath, itemsSource) || !SourceStamp::FromFile(recipesPath, recipesSource)) {
+        return false;
+    }
+
+    std::unique_ptr<CompiledDatabase> database = CompiledDatabase::Open(dbPath, itemsSource, recipesSource);
+    if (!database || database->GetItemIndexCount() > static_cast<size_t>(MAX_ITEM_ID) + 1) {
+        return false;
+    }
+
+    // Items copy their strings into the arena so handles outlive the mapping
+    std::vector<Item> loadedItems;
+    loadedItems.reserve(database->GetItemCount());
+    for (size_t i = 0; i < database->GetItemCount(); i++) {
+        loadedItems.push_back(database->GetItem(i));
+    }
+    items.swap(loadedItems);
+
+    const int32_t* index = database->GetItemIndex();
+    itemIndex.assign(index, index + database->GetItemIndexCount());
+
+    // The recipe tables are used in place
+    database->AttachRecipes(recipes, multiRecipes);
+    compiled = std::move(database);
+    revision = NextRevision();
+    return true;
+}
+
+bool Crafting::WriteCompiled(const std::string& dbPath, const std::string& itemsPath,
+                             const std::string& recipesPath) const {
+    SourceStamp itemsSource, recipesSource;
+    if (!SourceStamp::FromFile(itemsPath, itemsSource) || !SourceStamp::FromFile(recipesPath, recipesSource)) {
+        std::cerr << "Failed to read sources for " << dbPath << std::endl;
+        return false;
+    }
+    return CompiledDatabase::Write(dbPath, items, itemIndex, recipes, multiRecipes, itemsSource, recipesSource);
+}
+
+bool Crafting::AddItem(const Item& item) {
+    if (item.id > MAX_ITEM_ID) {
+        std::cerr << "Warning: Item '" << item.name << "' has ID " << item.id << ", above the maximum of "
+                  << MAX_ITEM_ID << ", and was not added" << std::endl;
+        return false;
+    }
+    if (item.id < 0) {
+        std::cerr << "Warning: Item '" << item.name << "' has a negative ID and cannot be looked up" << std::endl;
+    } else {
+        if (static_cast<size_t>(item.id) >= itemIndex.size()) {
+            itemIndex.resize(item.id + 1, -1);
+        }
+        // First item with an id wins, as with the old linear search
+        if (itemIndex[item.id] < 0) {
+            itemIndex[item.id] = static_cast<int32_t>(items.size());
+        }
+    }
     items.push_back(item);
+    revision = NextRevision();
+    return true;
 }
 
 const Item* Crafting::FindItemById(int id) const {
-    for (const auto& item : items) {
-        if (item.id == id) {
-            return &item;
-        }
+    if (id < 0 || static_cast<size_t>(id) >= itemIndex.size() || itemIndex[id] < 0) {
+        return nullptr;
     }
-    return nullptr;
+    return &items[itemIndex[id]];
 }
@@ -1,9 +1,12 @@
 #ifndef CRAFTING_HPP
 #define CRAFTING_HPP
 
+#include "CompiledDatabase.hpp"
 #include "Item.hpp"
+#include "MultiRecipeTable.hpp"
+#include "RecipeTable.hpp"
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
 #include <string>
 #include <vector>
 #include <nlohmann/json.hpp>
@@ -12,41 +15,84 @@ using json = nlohmann::json;
 
 class Crafting {
 public:
+    // Ids index a dense table (here and in CraftSuggestions/CraftPlanner), so
+    // they must be small: larger ones are refused, and fail the items load
+    static const int MAX_ITEM_ID = (1 << 24) - 1;
+
     Crafting();
     ~Crafting();
 
     // Combine two items to create a new item
-    // Returns nullptr if combination is not valid
-    std::unique_ptr<Item> combine_items(const Item& item1, const Item& item2);
+    // Returns the registered result item, or nullptr if combination is not valid
+    const Item* combine_items(const Item& item1, const Item& item2) const;
+
+    // Result item id for two ingredient ids, or RecipeTable::NO_RESULT
+    int FindRecipe(int item1Id, int item2Id) const { return recipes.Find(item1Id, item2Id); }
+
+    // Result item id for any ingredients (order and repeats do not matter:
+    // {A, A, B} is {A x2, B}), or RecipeTable::NO_RESULT. Allocation-free;
+    // two single items go to the pair table, anything else to the multiset one
+    int FindRecipe(const Ingredient* ingredients, size_t count) const;
+    int FindRecipe(const std::vector<Ingredient>& ingredients) const {
+        return FindRecipe(ingredients.data(), ingredients.size());
+    }
 
     // Register a crafting recipe
     void RegisterRecipe(int item1Id, int item2Id, int resultId);
+    // Register a recipe of 2..MultiRecipeTable::MAX_INGREDIENTS distinct items with quantities;
+    // false (with a warning) if the ingredients are invalid or the result item is unknown
+    bool RegisterRecipe(const std::vector<Ingredient>& ingredients, int resultId);
     
-    // Load items from JSON file
+    // Load items from JSON file; fails, leaving the items unchanged, if an id
+    // is above MAX_ITEM_ID
     bool LoadItemsFromJson(const std::string& filepath);
     
     // Load recipes from JSON file
     bool LoadRecipesFromJson(const std::string& filepath);
+
+    // Load items and recipes from a compiled database (see sintezia_dbc).
+    // Fails, leaving everything unchanged, if it is missing or was not
+    // compiled from the current itemsPath/recipesPath; load the JSON then.
+    bool LoadCompiled(const std::string& dbPath, const std::string& itemsPath, const std::string& recipesPath);
+
+    // Write the loaded items and recipes as a database stamped with the sources
+    bool WriteCompiled(const std::string& dbPath, const std::string& itemsPath, const std::string& recipesPath) const;
     
     // Get all loaded items
     const std::vector<Item>& GetAllItems() const { return items; }
     
-    // Add an item to the collection
-    void AddItem(const Item& item);
+    // Add an item to the collection; false (and not added) if its id is above MAX_ITEM_ID
+    bool AddItem(const Item& item);
     
     // Find item by ID
     const Item* FindItemById(int id) const;
 
+    size_t GetRecipeCount() const { return recipes.Size() + multiRecipes.Size(); }
+    // Recipes of two single items (what combining two item actors looks up)
+    const RecipeTable& GetRecipes() const { return recipes; }
+    // Every other recipe: three or more items in total
+    const MultiRecipeTable& GetMultiRecipes() const { return multiRecipes; }
+
+    // Changed by every change to the items or recipes, so derived data
+    // (e.g. CraftSuggestions) can tell it is out of date; unique across
+    // instances, so a reloaded Crafting is never mistaken for the old one
+    uint64_t GetRevision() const { return revision; }
+
 private:
-    // Store crafting recipes as a map of (item1_id, item2_id) -> result_id
-    // Using a string key for simplicity: "id1,id2" or "id2,id1"
-    std::unordered_map<std::string, std::unique_ptr<Item>> recipes;
+    // Store crafting recipes as (item1_id, item2_id) -> result_id, order-independent
+    RecipeTable recipes;
+    // Recipes needing three or more items, by canonical ingredient multiset
+    MultiRecipeTable multiRecipes;
     
     // Store all items
     std::vector<Item> items;
+    // Item id -> index into items, -1 for unknown ids (ids are at most MAX_ITEM_ID)
+    std::vector<int32_t> itemIndex;
+
+    // Mapped database the recipe tables are attached to, if loaded from one
+    std::unique_ptr<CompiledDatabase> compiled;
 
-    // Helper to create recipe key
-    std::string CreateRecipeKey(int id1, int id2) const;
+    uint64_t revision;
 };
 
 #endif // CRAFTING_HPP
@@ -0,0 +1,146 @@
+#include "CraftingReloader.hpp"
+#include <chrono>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // "assets/items.json" -> "assets" and "items.json"
+    void SplitPath(const std::string& path, std::string& directory, std::string& name) {
+        size_t slash = path.find_last_of("/\\");
+        directory = slash == std::string::npos ? "." : path.substr(0, slash);
+        name = slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+}
+
+CraftingReloader::CraftingReloader(const std::string& itemsPath, const std::string& recipesPath)
+    : itemsPath(itemsPath)
+    , recipesPath(recipesPath)
+    , published(nullptr)
+    , shutdown(false)
+    , reloadCount(0)
+    , watchFd(-1) {
+    SourceStamp::FromFile(itemsPath, itemsStamp);
+    SourceStamp::FromFile(recipesPath, recipesStamp);
+
+#ifdef __linux__
+    // Watch the directories rather than the files: a save that renames a
+    // new file into place would leave a watch on the old inode behind
+    watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watchFd >= 0) {
+        std::string directory, name;
+        bool watching = true;
+        for (const std::string* path : {&itemsPath, &recipesPath}) {
+            SplitPath(*path, directory, name);
+            if (inotify_add_watch(watchFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+                watching = false;
+            }
+        }
+        if (!watching) {
+            close(watchFd);
+            watchFd = -1;
+        }
+    }
+#endif
+    if (watchFd < 0) {
+        std::cerr << "Warning: Cannot watch " << itemsPath << " and " << recipesPath
+                  << " for changes, polling them instead" << std::endl;
+    }
+
+    worker = std::thread(&CraftingReloader::WorkerLoop, this);
+}
+
+CraftingReloader::~CraftingReloader() {
+    shutdown.store(true);
+    worker.join();
+#ifdef __linux__
+    if (watchFd >= 0) {
+        close(watchFd);
+    }
+#endif
+    delete published.exchange(nullptr);
+}
+
+std::unique_ptr<Crafting> CraftingReloader::TakeReloaded() {
+    // Cheap when nothing is pending: one load, no exchange
+    if (!published.load(std::memory_order_relaxed)) return nullptr;
+    return std::unique_ptr<Crafting>(published.exchange(nullptr, std::memory_order_acquire));
+}
+
+bool CraftingReloader::WaitForChange() {
+#ifdef __linux__
+    if (watchFd >= 0) {
+        std::string directory, itemsName, recipesName;
+        SplitPath(itemsPath, directory, itemsName);
+        SplitPath(recipesPath, directory, recipesName);
+
+        // Read everything queued; true if any event names one of the sources
+        auto drain = [&]() {
+            alignas(inotify_event) char buffer[4096];
+            bool relevant = false;
+            ssize_t length;
+            while ((length = read(watchFd, buffer, sizeof(buffer))) > 0) {
+                for (ssize_t at = 0; at < length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + at);
+                    if (event->len > 0 && (itemsName == event->name || recipesName == event->name)) {
+                        relevant = true;
+                    }
+                    at += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                }
+            }
+            return relevant;
+        };
+
+        pollfd descriptor{watchFd, POLLIN, 0};
+        while (!shutdown.load()) {
+            if (poll(&descriptor, 1, POLL_INTERVAL_MS) <= 0 || !drain()) continue;
+
+            // Let the save finish: wait until the directory has been quiet for a while
+            while (!shutdown.load() && poll(&descriptor, 1, SETTLE_MS) > 0) {
+                drain();
+            }
+            return !shutdown.load();
+        }
+        return false;
+    }
+#endif
+
+    // Polling: the stamps are compared by the caller
+    auto wakeAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(POLL_INTERVAL_MS);
+    while (!shutdown.load() && std::chrono::steady_clock::now() < wakeAt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    return !shutdown.load();
+}
+
+bool CraftingReloader::SourcesChanged(SourceStamp& items, SourceStamp& recipes) const {
+    // A file missing mid-save counts as unchanged; its replacement will show up
+    if (!SourceStamp::FromFile(itemsPath, items) || !SourceStamp::FromFile(recipesPath, recipes)) return false;
+    return !(items == itemsStamp) || !(recipes == recipesStamp);
+}
+
+void CraftingReloader::WorkerLoop() {
+    while (WaitForChange()) {
+        // Editors touch files without changing them; only content counts
+        SourceStamp items, recipes;
+        if (!SourcesChanged(items, recipes)) continue;
+
+        std::unique_ptr<Crafting> reloaded = std::make_unique<Crafting>();
+        if (!reloaded->LoadItemsFromJson(itemsPath) || !reloaded->LoadRecipesFromJson(recipesPath)) {
+            // Keep the stamps, so the next save is tried again
+            std::cerr << "Warning: Reload of " << itemsPath << " and " << recipesPath
+                      << " failed, keeping the current recipes" << std::endl;
+            continue;
+        }
+        itemsStamp = items;
+        recipesStamp = recipes;
+
+        // Replaces a reload the game has not taken yet
+        delete published.exchange(reloaded.release(), std::memory_order_acq_rel);
+        reloadCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef CRAFTING_RELOADER_HPP
+#define CRAFTING_RELOADER_HPP
+
+#include "CompiledDatabase.hpp"
+#include "Crafting.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Rebuilds Crafting from items.json and recipes.json whenever they change,
+// so recipes can be balanced without restarting.
+// A worker thread waits for changes (inotify on the files' directories where
+// available, since editors often save by renaming a new file over the old
+// one; polling the files elsewhere), lets a burst of writes settle, and
+// loads a complete new Crafting off the main thread. The result is published
+// through a single atomic pointer that TakeReloaded exchanges out, so the
+// game never locks or waits on a reload: it swaps the new Crafting in
+// between steps (see Game::ApplyCraftingReload), when nothing holds pointers
+// into the old one. Items are handles into the string arena, so the Items
+// already held by actors and inventories stay valid across the swap.
+class CraftingReloader {
+public:
+    static constexpr int SETTLE_MS = 150;         // Quiet time after the last change before loading
+    static constexpr int POLL_INTERVAL_MS = 500;  // Polling period without inotify; also the shutdown latency
+
+    // Starts watching; changes are compared against the sources as they are now
+    CraftingReloader(const std::string& itemsPath, const std::string& recipesPath);
+    ~CraftingReloader();
+
+    CraftingReloader(const CraftingReloader&) = delete;
+    CraftingReloader& operator=(const CraftingReloader&) = delete;
+
+    // The newest reload since the last call, or null (main thread). A reload
+    // that fails to parse (e.g. a file caught half-saved) is never published.
+    std::unique_ptr<Crafting> TakeReloaded();
+
+    bool IsWatching() const { return watchFd >= 0; }
+    size_t GetReloadCount() const { return reloadCount.load(std::memory_order_relaxed); }
+
+private:
+    // Blocks until the sources may have changed; false on shutdown
+    bool WaitForChange();
+    // True if either source's size or hash differs from the last load
+    bool SourcesChanged(SourceStamp& items, SourceStamp& recipes) const;
+    void WorkerLoop();
+
+    std::string itemsPath;
+    std::string recipesPath;
+    SourceStamp itemsStamp;    // Of the sources last loaded (worker only)
+    SourceStamp recipesStamp;
+
+    std::atomic<Crafting*> published;  // Owned; null once taken
+    std::atomic<bool> shutdown;
+    std::atomic<size_t> reloadCount;
+    int watchFd;  // inotify descriptor, -1 when polling
+    std::thread worker;
+};
+
+#endif // CRAFTING_RELOADER_HPP
@@ -1,5 +1,12 @@
 #include "Item.hpp"
 
+std::string Item::displayName() const {
+    std::string text;
+    text.reserve(emoji.size() + 1 + name.size());
+    text.append(emoji).append(" ").append(name);
+    return text;
+}
+
 json Item::toJson() const {
     json j;
     to_json(j, *this);
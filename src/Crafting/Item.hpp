@@ -1,39 +1,50 @@
 #ifndef ITEM_HPP
 #define ITEM_HPP
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <nlohmann/json.hpp>
+#include "StringArena.hpp"
 
 using json = nlohmann::json;
 
+// Trivially copyable handle: name and emoji are views of strings interned
+// in the StringArena, so copying an Item (into inventory slots, item actors,
+// commands) never allocates.
 class Item {
 public:
     int id;
-    std::string name;
-    std::string emoji;
+    std::string_view name;
+    std::string_view emoji;
+
+    Item(int id, std::string_view name, std::string_view emoji = "🔹")
+        : id(id)
+        , name(StringArena::Instance().Intern(name))
+        , emoji(StringArena::Instance().Intern(emoji)) {}
+
+    // "emoji name", as shown in the world and in dialogs
+    std::string displayName() const;
 
-    Item(int id, const std::string& name, const std::string& emoji = "🔹") 
-        : id(id), name(name), emoji(emoji) {}
-    
     // JSON serialization
     json toJson() const;
-    
+
     // JSON deserialization
     static Item fromJson(const json& j);
 };
 
+static_assert(std::is_trivially_copyable<Item>::value, "Item must stay a plain handle");
+
 // JSON conversion helpers for nlohmann/json library
 inline void to_json(json& j, const Item& item) {
     j = json{
         {"id", item.id},
-        {"name", item.name},
-        {"emoji", item.emoji}
+        {"name", std::string(item.name)},
+        {"emoji", std::string(item.emoji)}
     };
 }
 
 inline void from_json(const json& j, Item& item) {
-    j.at("id").get_to(item.id);
-    j.at("name").get_to(item.name);
-    j.at("emoji").get_to(item.emoji);
+    item = Item(j.at("id").get<int>(), j.at("name").get<std::string>(), j.at("emoji").get<std::string>());
 }
 
 #endif // ITEM_HPP
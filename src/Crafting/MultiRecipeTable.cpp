@@ -0,0 +1,254 @@
+#include "MultiRecipeTable.hpp"
+#include <algorithm>
+
+namespace {
+    const size_t MIN_CAPACITY = 16;
+
+    // Keep the table at most 3/4 full so probe runs stay short
+    bool OverLoaded(size_t count, size_t capacity) {
+        return count * 4 > capacity * 3;
+    }
+
+    // One odd multiplier per lane, so equal lanes in different positions differ
+    const uint64_t LANE_MULTIPLIERS[MultiRecipeTable::MAX_INGREDIENTS] = {
+        0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull,
+        0xD6E8FEB86659FD93ull, 0xFF51AFD7ED558CCDull, 0xC4CEB9FE1A85EC53ull,
+    };
+
+    MultiRecipeTable::Key EmptyKey() {
+        MultiRecipeTable::Key key;
+        std::fill(key.lanes, key.lanes + MultiRecipeTable::MAX_INGREDIENTS, MultiRecipeTable::EMPTY_LANE);
+        return key;
+    }
+}
+
+MultiRecipeTable::MultiRecipeTable()
+    : keyData(nullptr), resultData(nullptr), capacity(0), count(0), mask(0) {
+}
+
+MultiRecipeTable::MultiRecipeTable(const MultiRecipeTable& other)
+    : keys(other.keys), results(other.results), capacity(other.capacity), count(other.count), mask(other.mask) {
+    // Borrowed arrays stay borrowed; owned ones point at the copies
+    keyData = other.IsAttached() ? other.keyData : keys.data();
+    resultData = other.IsAttached() ? other.resultData : results.data();
+    if (capacity == 0) {
+        keyData = nullptr;
+        resultData = nullptr;
+    }
+}
+
+MultiRecipeTable& MultiRecipeTable::operator=(const MultiRecipeTable& other) {
+    if (this != &other) {
+        MultiRecipeTable copy(other);
+        keys.swap(copy.keys);
+        results.swap(copy.results);
+        keyData = copy.keyData;
+        resultData = copy.resultData;
+        capacity = copy.capacity;
+        count = copy.count;
+        mask = copy.mask;
+    }
+    return *this;
+}
+
+bool MultiRecipeTable::MakeKey(const Ingredient* ingredients, size_t ingredientCount, Key& key) {
+    if (ingredientCount == 0 || ingredientCount > MAX_INGREDIENTS) {
+        return ingredientCount > 0 && MakeKeyMerging(ingredients, ingredientCount, key);
+    }
+
+    // Unsorted lanes, then an optimal 6-input sorting network: min/max with
+    // no data-dependent branches, and the padding (all ones) sorts last
+    uint64_t lanes[MAX_INGREDIENTS];
+    for (size_t i = 0; i < MAX_INGREDIENTS; i++) {
+        if (i >= ingredientCount) {
+            lanes[i] = EMPTY_LANE;
+            continue;
+        }
+        const Ingredient& ingredient = ingredients[i];
+        if (ingredient.itemId < 0 || ingredient.quantity < 1 || ingredient.quantity > MAX_QUANTITY) return false;
+        lanes[i] = (static_cast<uint64_t>(static_cast<uint32_t>(ingredient.itemId)) << 32) |
+                   static_cast<uint32_t>(ingredient.quantity);
+    }
+    static const uint8_t NETWORK[][2] = {
+        {0, 5}, {1, 3}, {2, 4}, {1, 2}, {3, 4}, {0, 3}, {2, 5}, {0, 1}, {2, 3}, {4, 5}, {1, 2}, {3, 4},
+    };
+    for (const auto& pair : NETWORK) {
+        uint64_t low = std::min(lanes[pair[0]], lanes[pair[1]]);
+        uint64_t high = std::max(lanes[pair[0]], lanes[pair[1]]);
+        lanes[pair[0]] = low;
+        lanes[pair[1]] = high;
+    }
+
+    // Repeated ids are now adjacent: add up their quantities
+    key = EmptyKey();
+    size_t used = 0;
+    for (size_t i = 0; i < ingredientCount; i++) {
+        if (used > 0 && (key.lanes[used - 1] >> 32) == (lanes[i] >> 32)) {
+            uint64_t quantity = (key.lanes[used - 1] & 0xFFFFFFFFu) + (lanes[i] & 0xFFFFFFFFu);
+            if (quantity > static_cast<uint64_t>(MAX_QUANTITY)) return false;
+            key.lanes[used - 1] = (lanes[i] & ~uint64_t(0xFFFFFFFFu)) | quantity;
+        } else {
+            key.lanes[used++] = lanes[i];
+        }
+    }
+    return true;
+}
+
+bool MultiRecipeTable::MakeKeyMerging(const Ingredient* ingredients, size_t ingredientCount, Key& key) {
+    key = EmptyKey();
+
+    // More entries than lanes: insertion sort, merging repeated ids as they
+    // come, so it only fails if there are too many distinct items
+    size_t used = 0;
+    for (size_t i = 0; i < ingredientCount; i++) {
+        const Ingredient& ingredient = ingredients[i];
+        if (ingredient.itemId < 0 || ingredient.quantity < 1 || ingredient.quantity > MAX_QUANTITY) return false;
+
+        uint64_t id = static_cast<uint32_t>(ingredient.itemId);
+        size_t at = 0;
+        while (at < used && (key.lanes[at] >> 32) < id) {
+            at++;
+        }
+        if (at < used && (key.lanes[at] >> 32) == id) {
+            uint64_t quantity = (key.lanes[at] & 0xFFFFFFFFu) + static_cast<uint32_t>(ingredient.quantity);
+            if (quantity > static_cast<uint64_t>(MAX_QUANTITY)) return false;
+            key.lanes[at] = (id << 32) | quantity;
+            continue;
+        }
+        if (used == MAX_INGREDIENTS) return false;
+
+        for (size_t j = used; j > at; j--) {
+            key.lanes[j] = key.lanes[j - 1];
+        }
+        key.lanes[at] = (id << 32) | static_cast<uint32_t>(ingredient.quantity);
+        used++;
+    }
+    return true;
+}
+
+int MultiRecipeTable::TotalQuantity(const Key& key) {
+    int total = 0;
+    for (size_t i = 0; i < MAX_INGREDIENTS && key.lanes[i] != EMPTY_LANE; i++) {
+        total += static_cast<int>(key.lanes[i] & 0xFFFFFFFFu);
+    }
+    return total;
+}
+
+size_t MultiRecipeTable::Hash(const Key& key) {
+    // Lanes mixed independently and folded: no dependency between lanes, so
+    // the loop vectorizes; the splitmix64 finalizer then spreads the bits
+    uint64_t folded = 0;
+    for (size_t i = 0; i < MAX_INGREDIENTS; i++) {
+        uint64_t lane = key.lanes[i] * LANE_MULTIPLIERS[i];
+        folded ^= lane ^ (lane >> 32);
+    }
+    folded ^= folded >> 30;
+    folded *= 0xBF58476D1CE4E5B9ull;
+    folded ^= folded >> 27;
+    folded *= 0x94D049BB133111EBull;
+    folded ^= folded >> 31;
+    return static_cast<size_t>(folded);
+}
+
+bool MultiRecipeTable::Equal(const Key& a, const Key& b) {
+    uint64_t difference = 0;
+    for (size_t i = 0; i < MAX_INGREDIENTS; i++) {
+        difference |= a.lanes[i] ^ b.lanes[i];
+    }
+    return difference == 0;
+}
+
+void MultiRecipeTable::Reserve(size_t recipes) {
+    size_t newCapacity = std::max(capacity, MIN_CAPACITY);
+    while (OverLoaded(recipes, newCapacity)) {
+        newCapacity *= 2;
+    }
+    if (newCapacity != capacity) {
+        Rehash(newCapacity);
+    }
+}
+
+void MultiRecipeTable::Insert(const Key& key, int resultId) {
+    if (IsEmpty(key)) return;
+
+    if (capacity == 0 || OverLoaded(count + 1, capacity)) {
+        Rehash(std::max(capacity * 2, MIN_CAPACITY));
+    } else if (IsAttached()) {
+        Own();
+    }
+
+    size_t slot = Hash(key) & mask;
+    while (!IsEmpty(keys[slot]) && !Equal(keys[slot], key)) {
+        slot = (slot + 1) & mask;
+    }
+    if (IsEmpty(keys[slot])) {
+        keys[slot] = key;
+        count++;
+    }
+    results[slot] = resultId;
+}
+
+int MultiRecipeTable::Find(const Key& key) const {
+    if (count == 0) return NO_RESULT;
+
+    size_t slot = Hash(key) & mask;
+    while (!IsEmpty(keyData[slot])) {
+        if (Equal(keyData[slot], key)) {
+            return resultData[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    return NO_RESULT;
+}
+
+void MultiRecipeTable::Clear() {
+    if (IsAttached()) {
+        *this = MultiRecipeTable();
+        return;
+    }
+    std::fill(keys.begin(), keys.end(), EmptyKey());
+    count = 0;
+}
+
+void MultiRecipeTable::Attach(const Key* borrowedKeys, const int32_t* borrowedResults, size_t slots, size_t recipes) {
+    keys.clear();
+    keys.shrink_to_fit();
+    results.clear();
+    results.shrink_to_fit();
+    keyData = borrowedKeys;
+    resultData = borrowedResults;
+    capacity = slots;
+    count = recipes;
+    mask = slots - 1;
+}
+
+void MultiRecipeTable::Own() {
+    keys.assign(keyData, keyData + capacity);
+    results.assign(resultData, resultData + capacity);
+    keyData = keys.data();
+    resultData = results.data();
+}
+
+void MultiRecipeTable::Rehash(size_t newCapacity) {
+    std::vector<Key> newKeys(newCapacity, EmptyKey());
+    std::vector<int32_t> newResults(newCapacity, NO_RESULT);
+    size_t newMask = newCapacity - 1;
+
+    for (size_t i = 0; i < capacity; i++) {
+        if (IsEmpty(keyData[i])) continue;
+
+        size_t slot = Hash(keyData[i]) & newMask;
+        while (!IsEmpty(newKeys[slot])) {
+            slot = (slot + 1) & newMask;
+        }
+        newKeys[slot] = keyData[i];
+        newResults[slot] = resultData[i];
+    }
+
+    keys.swap(newKeys);
+    results.swap(newResults);
+    keyData = keys.data();
+    resultData = results.data();
+    capacity = newCapacity;
+    mask = newMask;
+}
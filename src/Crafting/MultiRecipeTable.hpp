@@ -0,0 +1,90 @@
+#ifndef MULTI_RECIPE_TABLE_HPP
+#define MULTI_RECIPE_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Ingredient {
+    int itemId;
+    int quantity = 1;
+};
+
+// Recipe lookup for more than two ingredients (or quantities): ingredient
+// multiset -> result id. The key is the multiset in canonical form, a
+// fixed-size array of (id, quantity) lanes sorted by id and padded with
+// empty lanes, so any order or repetition of the same ingredients gives the
+// same key. Sorting is a branch-free network over the lanes, and every lane
+// is hashed independently before the lanes are folded, a loop of fixed
+// length the compiler can vectorize. Open addressing with linear probing
+// over flat arrays as in RecipeTable; canonicalizing happens on the stack,
+// so a lookup allocates nothing and costs the same for 2 or 6 ingredients.
+// Pairs of single items belong in RecipeTable (see Crafting).
+class MultiRecipeTable {
+public:
+    static constexpr int NO_RESULT = -1;
+    static const size_t MAX_INGREDIENTS = 6;  // Distinct items per recipe
+    static const int MAX_QUANTITY = 0xFFFF;   // Per distinct item, so TotalQuantity fits in an int
+
+    struct Key {
+        uint64_t lanes[MAX_INGREDIENTS];  // (id << 32) | quantity, ascending; EMPTY_LANE after the last
+    };
+    static constexpr uint64_t EMPTY_LANE = ~uint64_t(0);
+
+    MultiRecipeTable();
+    MultiRecipeTable(const MultiRecipeTable& other);
+    MultiRecipeTable& operator=(const MultiRecipeTable& other);
+
+    // Canonical key for count ingredients (any order, ids may repeat);
+    // false if they are more than MAX_INGREDIENTS distinct items or have
+    // a negative id, a quantity below one or (added up) above MAX_QUANTITY
+    static bool MakeKey(const Ingredient* ingredients, size_t count, Key& key);
+    // Total quantity of the ingredients in key
+    static int TotalQuantity(const Key& key);
+    // Slot a key starts probing at; part of the compiled database format
+    static size_t Hash(const Key& key);
+
+    void Reserve(size_t recipes);
+    // Adds or replaces the recipe for the key
+    void Insert(const Key& key, int resultId);
+    // Result id for the key, or NO_RESULT
+    int Find(const Key& key) const;
+    void Clear();
+
+    // Calls f(key, result id) for every recipe, in slot order
+    template <typename F>
+    void ForEach(F&& f) const {
+        for (size_t i = 0; i < capacity; i++) {
+            if (IsEmpty(keyData[i])) continue;
+            f(keyData[i], resultData[i]);
+        }
+    }
+
+    // Uses capacity slots of keys/results in place, as RecipeTable::Attach
+    void Attach(const Key* keys, const int32_t* results, size_t capacity, size_t count);
+    bool IsAttached() const { return keyData != nullptr && keyData != keys.data(); }
+
+    const Key* KeyData() const { return keyData; }
+    const int32_t* ResultData() const { return resultData; }
+    size_t Size() const { return count; }
+    size_t Capacity() const { return capacity; }
+
+private:
+    static bool IsEmpty(const Key& key) { return key.lanes[0] == EMPTY_LANE; }
+    static bool Equal(const Key& a, const Key& b);
+    // MakeKey for more entries than lanes (repeated ids)
+    static bool MakeKeyMerging(const Ingredient* ingredients, size_t count, Key& key);
+
+    void Rehash(size_t newCapacity);
+    void Own();
+
+    std::vector<Key> keys;  // Owned storage (empty while attached)
+    std::vector<int32_t> results;
+    const Key* keyData;
+    const int32_t* resultData;
+    size_t capacity;
+    size_t count;
+    size_t mask;
+};
+
+#endif // MULTI_RECIPE_TABLE_HPP
@@ -0,0 +1,221 @@
+#include "RecipeGenerationService.hpp"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+RecipeGenerationService::RecipeGenerationService(Crafting& crafting, std::unique_ptr<IRecipeGenerator> generator,
+                                                 const std::string& logPath)
+    : crafting(&crafting)
+    , generator(std::move(generator))
+    , nextId(FIRST_GENERATED_ID)
+    , generatedCount(0)
+    , shutdown(false) {
+    IndexItems();
+    ReplayLog(logPath);
+    log.open(logPath, std::ios::app);
+    if (!log.is_open()) {
+        std::cerr << "Warning: Cannot write generated recipe log " << logPath
+                  << ", results will not be kept" << std::endl;
+    }
+
+    worker = std::thread(&RecipeGenerationService::WorkerLoop, this);
+}
+
+RecipeGenerationService::~RecipeGenerationService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        shutdown = true;
+    }
+    wake.notify_one();
+    worker.join();
+
+    // Keep results that finished after the last Poll too
+    std::vector<Result> finished;
+    Poll(finished);
+    if (log.is_open()) {
+        for (const std::string& line : logLines) {
+            log << line << '\n';
+        }
+    }
+}
+
+void RecipeGenerationService::ReplayLog(const std::string& logPath) {
+    std::ifstream file(logPath);
+    if (!file.is_open()) return;  // First session
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty()) continue;
+
+        // A crash can leave the last line cut short; skip anything unreadable
+        json entry = json::parse(line, nullptr, false);
+        if (entry.is_discarded() || !entry.is_object()) {
+            std::cerr << "Warning: Skipping malformed generated recipe at line " << lineNumber << std::endl;
+            continue;
+        }
+
+        Generated generated{entry.value("item1_id", -1), entry.value("item2_id", -1), entry.value("name", ""),
+                            entry.value("emoji", "🔹")};
+        if (generated.name.empty() || !crafting->FindItemById(generated.item1Id) ||
+            !crafting->FindItemById(generated.item2Id)) {
+            std::cerr << "Warning: Skipping generated recipe with unknown items at line " << lineNumber << std::endl;
+            continue;
+        }
+
+        if (Apply(generated)) {
+            generatedCount++;
+        }
+        history.push_back(std::move(generated));
+    }
+}
+
+bool RecipeGenerationService::Apply(const Generated& generated) {
+    // A hand-written recipe added since takes precedence
+    if (crafting->FindRecipe(generated.item1Id, generated.item2Id) != RecipeTable::NO_RESULT) return false;
+
+    int resultId = ResolveItem(generated.name, generated.emoji);
+    if (resultId == RecipeTable::NO_RESULT) return false;
+
+    crafting->RegisterRecipe(generated.item1Id, generated.item2Id, resultId);
+    return true;
+}
+
+void RecipeGenerationService::IndexItems() {
+    itemIds.clear();
+    nextId = FIRST_GENERATED_ID;
+    for (const Item& item : crafting->GetAllItems()) {
+        itemIds.emplace(item.name, item.id);  // First item with a name wins
+        nextId = std::max(nextId, item.id + 1);
+    }
+}
+
+void RecipeGenerationService::Rebind(Crafting& reloaded) {
+    crafting = &reloaded;
+    IndexItems();
+
+    // Same order as the log, so invented items get the ids they had (unless
+    // the reload added a hand-written item of the same name, which wins)
+    for (const Generated& generated : history) {
+        if (crafting->FindItemById(generated.item1Id) && crafting->FindItemById(generated.item2Id)) {
+            Apply(generated);
+        }
+    }
+}
+
+int RecipeGenerationService::ResolveItem(const std::string& name, const std::string& emoji) {
+    auto it = itemIds.find(name);
+    if (it != itemIds.end()) {
+        return it->second;
+    }
+
+    // Ids are handed out in log order, so replaying the log reproduces them
+    Item item(nextId, name, emoji);
+    if (!crafting->AddItem(item)) return RecipeTable::NO_RESULT;  // Past Crafting::MAX_ITEM_ID
+
+    nextId++;
+    itemIds.emplace(item.name, item.id);
+    return item.id;
+}
+
+bool RecipeGenerationService::Request(const Item& item1, const Item& item2) {
+    if (crafting->FindRecipe(item1.id, item2.id) != RecipeTable::NO_RESULT) return false;
+
+    uint64_t key = RecipeTable::MakeKey(item1.id, item2.id);
+    if (failed.count(key) > 0 || !pending.insert(key).second) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (item2.id < item1.id) {
+            tasks.push_back(Task{key, item2, item1});
+        } else {
+            tasks.push_back(Task{key, item1, item2});
+        }
+    }
+    wake.notify_one();
+    return true;
+}
+
+bool RecipeGenerationService::IsPending(int item1Id, int item2Id) const {
+    return pending.count(RecipeTable::MakeKey(item1Id, item2Id)) > 0;
+}
+
+void RecipeGenerationService::Poll(std::vector<Result>& finished) {
+    std::vector<Done> results;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (done.empty()) return;
+        results.swap(done);
+    }
+
+    std::vector<std::string> lines;
+    for (Done& result : results) {
+        pending.erase(result.key);
+        int resultId = result.success && !result.item.name.empty()
+            ? ResolveItem(result.item.name, result.item.emoji)
+            : RecipeTable::NO_RESULT;
+        if (resultId == RecipeTable::NO_RESULT) {
+            failed.insert(result.key);
+            finished.push_back(Result{result.item1Id, result.item2Id, RecipeTable::NO_RESULT});
+            continue;
+        }
+
+        crafting->RegisterRecipe(result.item1Id, result.item2Id, resultId);
+        history.push_back(Generated{result.item1Id, result.item2Id, result.item.name, result.item.emoji});
+        generatedCount++;
+        finished.push_back(Result{result.item1Id, result.item2Id, resultId});
+
+        json entry = {
+            {"item1_id", result.item1Id},
+            {"item2_id", result.item2Id},
+            {"result_id", resultId},
+            {"name", result.item.name},
+            {"emoji", result.item.emoji}
+        };
+        lines.push_back(entry.dump());
+    }
+
+    if (!lines.empty()) {
+        // The worker does the file I/O too
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            logLines.insert(logLines.end(), std::make_move_iterator(lines.begin()),
+                            std::make_move_iterator(lines.end()));
+        }
+        wake.notify_one();
+    }
+}
+
+void RecipeGenerationService::WorkerLoop() {
+    std::vector<std::string> lines;
+    while (true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [this] { return shutdown || !tasks.empty() || !logLines.empty(); });
+
+        if (!logLines.empty()) {
+            lines.swap(logLines);
+            lock.unlock();
+            if (log.is_open()) {
+                for (const std::string& line : lines) {
+                    log << line << '\n';
+                }
+                log.flush();
+            }
+            lines.clear();
+            continue;
+        }
+        // Queued generations are dropped on shutdown; nothing was promised for them
+        if (shutdown) break;
+
+        Task task = tasks.front();
+        tasks.pop_front();
+        lock.unlock();
+
+        Done result{task.key, task.first.id, task.second.id, false, GeneratedItem()};
+        result.success = generator->Generate(task.first, task.second, result.item);
+
+        lock.lock();
+        done.push_back(std::move(result));
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef RECIPE_GENERATION_SERVICE_HPP
+#define RECIPE_GENERATION_SERVICE_HPP
+
+#include "Crafting.hpp"
+#include "RecipeGenerator.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Fills in recipes for combinations Crafting does not know.
+// Request queues a pair for the generator, which runs on a worker thread so
+// the game never waits for it; Poll (main thread) registers the finished
+// results with Crafting and reports them. Every result is appended to a log
+// (one JSON object per line) that is replayed on startup, so a pair is
+// generated at most once across sessions. A result whose name matches an
+// existing item reuses that item.
+class RecipeGenerationService {
+public:
+    // Ids for invented items start here, clear of the hand-written ones
+    static const int FIRST_GENERATED_ID = 10000;
+
+    struct Result {
+        int item1Id;
+        int item2Id;
+        int resultId;  // RecipeTable::NO_RESULT if generation failed
+    };
+
+    // Replays logPath into crafting and starts the worker
+    RecipeGenerationService(Crafting& crafting, std::unique_ptr<IRecipeGenerator> generator,
+                            const std::string& logPath);
+    // Waits for the generation in progress and the pending log writes
+    ~RecipeGenerationService();
+
+    RecipeGenerationService(const RecipeGenerationService&) = delete;
+    RecipeGenerationService& operator=(const RecipeGenerationService&) = delete;
+
+    // Queues the pair; false if it already has a recipe, is queued, or
+    // failed to generate earlier this session
+    bool Request(const Item& item1, const Item& item2);
+    bool IsPending(int item1Id, int item2Id) const;
+
+    // Registers finished results and appends them to finished (main thread)
+    void Poll(std::vector<Result>& finished);
+
+    // Switches to a reloaded crafting and registers every generated recipe
+    // (replayed or new) with it again, from memory (main thread)
+    void Rebind(Crafting& crafting);
+
+    size_t GetPendingCount() const { return pending.size(); }
+    // Log entries replayed at startup plus results generated since
+    size_t GetGeneratedCount() const { return generatedCount; }
+
+private:
+    struct Task {
+        uint64_t key;
+        Item first;  // Smaller id first
+        Item second;
+    };
+
+    struct Generated {
+        int item1Id;
+        int item2Id;
+        std::string name;
+        std::string emoji;
+    };
+
+    struct Done {
+        uint64_t key;
+        int item1Id;
+        int item2Id;
+        bool success;
+        GeneratedItem item;
+    };
+
+    void ReplayLog(const std::string& logPath);
+    // Registers a generated recipe; false if a hand-written one has the pair
+    bool Apply(const Generated& generated);
+    // Collects the names of crafting's items and the next free id
+    void IndexItems();
+    // Id for a result named name, adding the item if it is new;
+    // RecipeTable::NO_RESULT if no id is left (Crafting::MAX_ITEM_ID)
+    int ResolveItem(const std::string& name, const std::string& emoji);
+    void WorkerLoop();
+
+    Crafting* crafting;
+    std::unique_ptr<IRecipeGenerator> generator;
+    std::ofstream log;
+
+    // Main thread only
+    std::unordered_set<uint64_t> pending;  // Requested, not yet polled
+    std::unordered_set<uint64_t> failed;   // Not retried until the next session
+    std::unordered_map<std::string_view, int> itemIds;  // Interned name -> item id
+    std::vector<Generated> history;  // Every generated recipe, in log order
+    int nextId;
+    size_t generatedCount;
+
+    // Shared with the worker
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Task> tasks;
+    std::vector<std::string> logLines;  // Written before the next task is started
+    std::vector<Done> done;
+    bool shutdown;
+    std::thread worker;
+};
+
+#endif // RECIPE_GENERATION_SERVICE_HPP
@@ -0,0 +1,220 @@
+#include "RecipeGenerator.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#ifndef _WIN32
+#include <csignal>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Item names are Portuguese; these adjectives do not change with gender
+    const char* const ADJECTIVES[] = {
+        "Selvagem", "Ardente", "Celeste", "Gigante", "Lunar", "Solar", "Primordial", "Brilhante",
+        "Flutuante", "Instável", "Feroz", "Colossal", "Infernal", "Imortal", "Estelar", "Polar"
+    };
+    const char* const NOUNS[] = {
+        "Golem", "Espírito", "Semente", "Jardim", "Forja", "Cristal", "Fera", "Torre",
+        "Pó", "Flor", "Motor", "Ídolo", "Pântano", "Coroa", "Portal", "Essência"
+    };
+    const char* const EMOJIS[] = {
+        "✨", "🌀", "🔮", "🌋", "❄️", "🌪️", "🌱", "🪨", "💎", "🧪", "⚙️", "🗿",
+        "🌙", "☄️", "🍄", "🐉", "🔥", "💧", "🌊", "⚡", "🌈", "🧱", "🌿", "👑"
+    };
+
+    template <typename T, size_t N>
+    size_t CountOf(const T (&)[N]) {
+        return N;
+    }
+
+    uint64_t HashName(std::string_view text, uint64_t hash) {
+        for (char c : text) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    uint64_t Mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    std::string_view FirstWord(std::string_view name) {
+        return name.substr(0, name.find(' '));
+    }
+
+}
+
+bool HashRecipeGenerator::Generate(const Item& first, const Item& second, GeneratedItem& result) {
+    // Seed from the names, not the ids, so the same ingredients give the
+    // same result whatever ids they end up with
+    std::string_view a = first.name;
+    std::string_view b = second.name;
+    if (b < a) std::swap(a, b);
+    uint64_t seed = Mix(HashName(b, HashName(a, 0xCBF29CE484222325ull) ^ 0xFF));
+
+    std::string_view head = (seed & 1) ? a : b;  // Ingredient the name is built on
+    std::string_view tail = (seed & 1) ? b : a;
+    uint64_t pick = seed >> 8;
+
+    std::string_view left = FirstWord(head);
+    std::string_view right = FirstWord(tail);
+    switch ((seed >> 1) % 3) {
+    case 0:  // "Golem de Pedra"
+        result.name = std::string(NOUNS[pick % CountOf(NOUNS)]) + " de " + std::string(right);
+        break;
+    case 1:  // "Fogo Selvagem"
+        result.name = std::string(left) + " " + ADJECTIVES[pick % CountOf(ADJECTIVES)];
+        break;
+    default:  // "Fogovapor"; words that do not glue plainly fall back to an adjective
+        if (left == right || left.size() + right.size() > 16 || right.empty() ||
+            static_cast<uint8_t>(right[0]) >= 0x80) {
+            result.name = std::string(left) + " " + ADJECTIVES[pick % CountOf(ADJECTIVES)];
+        } else {
+            result.name = std::string(left) + std::string(right);
+            char& joint = result.name[left.size()];
+            if (joint >= 'A' && joint <= 'Z') joint = static_cast<char>(joint - 'A' + 'a');
+        }
+        break;
+    }
+
+    // Mostly a fresh emoji, sometimes one inherited from an ingredient
+    uint64_t emojiPick = seed >> 32;
+    if (emojiPick % 4 == 0 && !first.emoji.empty()) {
+        result.emoji = std::string((emojiPick & 16) ? second.emoji : first.emoji);
+    } else {
+        result.emoji = EMOJIS[(emojiPick >> 2) % CountOf(EMOJIS)];
+    }
+    return true;
+}
+
+ProcessRecipeGenerator::ProcessRecipeGenerator(const std::string& command)
+    : command(command), pid(-1), channel(-1), failed(false) {
+}
+
+ProcessRecipeGenerator::~ProcessRecipeGenerator() {
+    Stop();
+}
+
+#ifndef _WIN32
+
+bool ProcessRecipeGenerator::Start() {
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) return false;
+
+    // Everything the child needs is prepared before fork: only
+    // async-signal-safe calls are allowed between fork and exec
+    const char* shellCommand = command.c_str();
+    pid = fork();
+    if (pid < 0) {
+        close(sockets[0]);
+        close(sockets[1]);
+        return false;
+    }
+    if (pid == 0) {
+        dup2(sockets[1], STDIN_FILENO);
+        dup2(sockets[1], STDOUT_FILENO);
+        close(sockets[0]);
+        close(sockets[1]);
+        execl("/bin/sh", "sh", "-c", shellCommand, static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    close(sockets[1]);
+    channel = sockets[0];
+    return true;
+}
+
+void ProcessRecipeGenerator::Stop() {
+    if (channel >= 0) {
+        close(channel);  // The child sees end of input
+        channel = -1;
+    }
+    if (pid > 0) {
+        kill(pid, SIGTERM);
+        waitpid(pid, nullptr, 0);
+        pid = -1;
+    }
+}
+
+bool ProcessRecipeGenerator::ReadLine(std::string& line) {
+    while (true) {
+        size_t end = readBuffer.find('\n');
+        if (end != std::string::npos) {
+            line = readBuffer.substr(0, end);
+            readBuffer.erase(0, end + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            return true;
+        }
+
+        pollfd descriptor = {channel, POLLIN, 0};
+        if (poll(&descriptor, 1, REPLY_TIMEOUT_MS) <= 0) return false;
+
+        char chunk[512];
+        ssize_t read = recv(channel, chunk, sizeof(chunk), 0);
+        if (read <= 0) return false;
+        readBuffer.append(chunk, static_cast<size_t>(read));
+    }
+}
+
+bool ProcessRecipeGenerator::Generate(const Item& first, const Item& second, GeneratedItem& result) {
+    if (failed) return false;
+    if (channel < 0 && !Start()) {
+        failed = true;
+        return false;
+    }
+
+    std::string request = std::string(first.name) + "\t" + std::string(second.name) + "\n";
+    size_t sent = 0;
+    while (sent < request.size()) {
+        // MSG_NOSIGNAL: a dead child must not take the game down with SIGPIPE
+        ssize_t written = send(channel, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            failed = true;
+            Stop();
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+
+    std::string reply;
+    if (!ReadLine(reply)) {
+        failed = true;
+        Stop();
+        return false;
+    }
+
+    size_t tab = reply.find('\t');
+    result.name = reply.substr(0, tab);
+    result.emoji = tab == std::string::npos ? std::string() : reply.substr(tab + 1);
+    if (result.emoji.empty()) result.emoji = "🔹";
+    return !result.name.empty();
+}
+
+#else
+
+bool ProcessRecipeGenerator::Start() {
+    return false;
+}
+
+void ProcessRecipeGenerator::Stop() {
+}
+
+bool ProcessRecipeGenerator::ReadLine(std::string&) {
+    return false;
+}
+
+bool ProcessRecipeGenerator::Generate(const Item&, const Item&, GeneratedItem&) {
+    return false;
+}
+
+#endif
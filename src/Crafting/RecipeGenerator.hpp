@@ -0,0 +1,58 @@
+#ifndef RECIPE_GENERATOR_HPP
+#define RECIPE_GENERATOR_HPP
+
+#include "Item.hpp"
+#include <string>
+
+// Name and emoji invented for a pair of ingredients with no recipe
+struct GeneratedItem {
+    std::string name;
+    std::string emoji;
+};
+
+// Invents results for unknown combinations. Called from the
+// RecipeGenerationService worker thread only, one pair at a time, with the
+// ingredients in a fixed order (smaller id first).
+class IRecipeGenerator {
+public:
+    virtual ~IRecipeGenerator() = default;
+
+    // False if nothing could be produced (the pair may be retried next session)
+    virtual bool Generate(const Item& first, const Item& second, GeneratedItem& result) = 0;
+};
+
+// Deterministic local generator: the ingredient names seed a hash that
+// picks how to compose the result ("Golem de Pedra", "Fogo Selvagem",
+// "Fogovapor") and its emoji, so a pair always yields the same item.
+class HashRecipeGenerator : public IRecipeGenerator {
+public:
+    bool Generate(const Item& first, const Item& second, GeneratedItem& result) override;
+};
+
+// Delegates to a long-running helper process (a local stand-in for an
+// external model). command is run through /bin/sh; for each pair it gets a
+// line "<first name>\t<second name>\n" on stdin and must answer one line
+// "<name>\t<emoji>\n" on stdout within REPLY_TIMEOUT_MS. Once the process
+// cannot be started, exits or times out, every call fails. POSIX only.
+class ProcessRecipeGenerator : public IRecipeGenerator {
+public:
+    explicit ProcessRecipeGenerator(const std::string& command);
+    ~ProcessRecipeGenerator() override;
+
+    bool Generate(const Item& first, const Item& second, GeneratedItem& result) override;
+
+private:
+    static const int REPLY_TIMEOUT_MS = 10000;
+
+    bool Start();
+    void Stop();
+    bool ReadLine(std::string& line);
+
+    std::string command;
+    int pid;
+    int channel;  // Our end of a socket pair that is the child's stdin and stdout
+    bool failed;
+    std::string readBuffer;  // Bytes read past the last line
+};
+
+#endif // RECIPE_GENERATOR_HPP
@@ -0,0 +1,156 @@
+#include "RecipeTable.hpp"
+#include <algorithm>
+
+namespace {
+    const size_t MIN_CAPACITY = 16;
+
+    // Keep the table at most 3/4 full so probe runs stay short
+    bool OverLoaded(size_t count, size_t capacity) {
+        return count * 4 > capacity * 3;
+    }
+}
+
+RecipeTable::RecipeTable()
+    : keyData(nullptr), resultData(nullptr), capacity(0), count(0), mask(0) {
+}
+
+RecipeTable::RecipeTable(const RecipeTable& other)
+    : keys(other.keys), results(other.results), capacity(other.capacity), count(other.count), mask(other.mask) {
+    // Borrowed arrays stay borrowed; owned ones point at the copies
+    keyData = other.IsAttached() ? other.keyData : keys.data();
+    resultData = other.IsAttached() ? other.resultData : results.data();
+    if (capacity == 0) {
+        keyData = nullptr;
+        resultData = nullptr;
+    }
+}
+
+RecipeTable& RecipeTable::operator=(const RecipeTable& other) {
+    if (this != &other) {
+        RecipeTable copy(other);
+        // Swapping keeps the buffers, so the copy's pointers stay right either way
+        keys.swap(copy.keys);
+        results.swap(copy.results);
+        keyData = copy.keyData;
+        resultData = copy.resultData;
+        capacity = copy.capacity;
+        count = copy.count;
+        mask = copy.mask;
+    }
+    return *this;
+}
+
+uint64_t RecipeTable::MakeKey(int id1, int id2) {
+    // Always use the smaller ID first so (a, b) and (b, a) are one recipe
+    uint32_t lo = static_cast<uint32_t>(std::min(id1, id2));
+    uint32_t hi = static_cast<uint32_t>(std::max(id1, id2));
+    return (static_cast<uint64_t>(lo) << 32) | hi;
+}
+
+size_t RecipeTable::Hash(uint64_t key) {
+    // splitmix64 finalizer: ids are small and sequential, so mix all the bits
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9ull;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EBull;
+    key ^= key >> 31;
+    return static_cast<size_t>(key);
+}
+
+void RecipeTable::Reserve(size_t recipes) {
+    size_t newCapacity = std::max(capacity, MIN_CAPACITY);
+    while (OverLoaded(recipes, newCapacity)) {
+        newCapacity *= 2;
+    }
+    if (newCapacity != capacity) {
+        Rehash(newCapacity);
+    }
+}
+
+void RecipeTable::Insert(int id1, int id2, int resultId) {
+    uint64_t key = MakeKey(id1, id2);
+    if (key == EMPTY_KEY) return;
+
+    if (capacity == 0 || OverLoaded(count + 1, capacity)) {
+        Rehash(std::max(capacity * 2, MIN_CAPACITY));
+    } else if (IsAttached()) {
+        Own();
+    }
+
+    size_t slot = Hash(key) & mask;
+    while (keys[slot] != EMPTY_KEY && keys[slot] != key) {
+        slot = (slot + 1) & mask;
+    }
+    if (keys[slot] == EMPTY_KEY) {
+        keys[slot] = key;
+        count++;
+    }
+    results[slot] = resultId;
+}
+
+int RecipeTable::Find(int id1, int id2) const {
+    if (count == 0) return NO_RESULT;
+
+    uint64_t key = MakeKey(id1, id2);
+    size_t slot = Hash(key) & mask;
+    while (keyData[slot] != EMPTY_KEY) {
+        if (keyData[slot] == key) {
+            return resultData[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    return NO_RESULT;
+}
+
+void RecipeTable::Clear() {
+    if (IsAttached()) {
+        // Drop the borrowed arrays rather than copying them just to empty them
+        *this = RecipeTable();
+        return;
+    }
+    std::fill(keys.begin(), keys.end(), EMPTY_KEY);
+    count = 0;
+}
+
+void RecipeTable::Attach(const uint64_t* borrowedKeys, const int32_t* borrowedResults, size_t slots, size_t recipes) {
+    keys.clear();
+    keys.shrink_to_fit();
+    results.clear();
+    results.shrink_to_fit();
+    keyData = borrowedKeys;
+    resultData = borrowedResults;
+    capacity = slots;
+    count = recipes;
+    mask = slots - 1;
+}
+
+void RecipeTable::Own() {
+    keys.assign(keyData, keyData + capacity);
+    results.assign(resultData, resultData + capacity);
+    keyData = keys.data();
+    resultData = results.data();
+}
+
+void RecipeTable::Rehash(size_t newCapacity) {
+    std::vector<uint64_t> newKeys(newCapacity, EMPTY_KEY);
+    std::vector<int32_t> newResults(newCapacity, NO_RESULT);
+    size_t newMask = newCapacity - 1;
+
+    for (size_t i = 0; i < capacity; i++) {
+        if (keyData[i] == EMPTY_KEY) continue;
+
+        size_t slot = Hash(keyData[i]) & newMask;
+        while (newKeys[slot] != EMPTY_KEY) {
+            slot = (slot + 1) & newMask;
+        }
+        newKeys[slot] = keyData[i];
+        newResults[slot] = resultData[i];
+    }
+
+    keys.swap(newKeys);
+    results.swap(newResults);
+    keyData = keys.data();
+    resultData = results.data();
+    capacity = newCapacity;
+    mask = newMask;
+}
@@ -0,0 +1,68 @@
+#ifndef RECIPE_TABLE_HPP
+#define RECIPE_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Recipe lookup: unordered ingredient id pair -> result id.
+// Open addressing with linear probing over two flat arrays (keys, results);
+// the key packs (min id, max id) into 64 bits, so a lookup hashes one
+// integer and touches one or two cache lines, with no allocation.
+// The arrays can also be borrowed (Attach), e.g. straight from a mapped
+// CompiledDatabase; the first modification copies them.
+class RecipeTable {
+public:
+    static constexpr int NO_RESULT = -1;
+    static constexpr uint64_t EMPTY_KEY = ~uint64_t(0);  // Pair (-1, -1), never a recipe
+
+    RecipeTable();
+    RecipeTable(const RecipeTable& other);
+    RecipeTable& operator=(const RecipeTable& other);
+
+    static uint64_t MakeKey(int id1, int id2);
+    // Slot a key starts probing at; part of the compiled database format
+    static size_t Hash(uint64_t key);
+
+    // Grows so that this many recipes fit without rehashing
+    void Reserve(size_t recipes);
+    // Adds or replaces the recipe for the pair
+    void Insert(int id1, int id2, int resultId);
+    // Result id for the pair, or NO_RESULT
+    int Find(int id1, int id2) const;
+    void Clear();
+
+    // Calls f(smaller id, larger id, result id) for every recipe, in slot order
+    template <typename F>
+    void ForEach(F&& f) const {
+        for (size_t i = 0; i < capacity; i++) {
+            if (keyData[i] == EMPTY_KEY) continue;
+            f(static_cast<int32_t>(keyData[i] >> 32), static_cast<int32_t>(keyData[i] & 0xFFFFFFFFu), resultData[i]);
+        }
+    }
+
+    // Uses capacity slots of keys/results in place (capacity a power of two,
+    // laid out as KeyData/ResultData); the memory must outlive the table or
+    // the next modification
+    void Attach(const uint64_t* keys, const int32_t* results, size_t capacity, size_t count);
+    bool IsAttached() const { return keyData != nullptr && keyData != keys.data(); }
+
+    const uint64_t* KeyData() const { return keyData; }
+    const int32_t* ResultData() const { return resultData; }
+    size_t Size() const { return count; }
+    size_t Capacity() const { return capacity; }
+
+private:
+    void Rehash(size_t newCapacity);
+    void Own();  // Copies borrowed arrays so they can be modified
+
+    std::vector<uint64_t> keys;  // Owned storage (empty while attached)
+    std::vector<int32_t> results;
+    const uint64_t* keyData;     // keys.data() or the borrowed arrays
+    const int32_t* resultData;
+    size_t capacity;
+    size_t count;
+    size_t mask;  // Capacity - 1 (capacity is a power of two)
+};
+
+#endif // RECIPE_TABLE_HPP
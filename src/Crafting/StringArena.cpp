@@ -0,0 +1,51 @@
+#include "StringArena.hpp"
+#include <cstring>
+
+StringArena& StringArena::Instance() {
+    static StringArena instance;
+    return instance;
+}
+
+StringArena::StringArena() : blockUsed(0), blockCapacity(0), bytesUsed(0) {
+}
+
+std::string_view StringArena::Intern(std::string_view text) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = strings.find(text);
+    if (it != strings.end()) {
+        return *it;
+    }
+
+    char* copy = Allocate(text.size() + 1);
+    std::memcpy(copy, text.data(), text.size());
+    copy[text.size()] = '\0';
+
+    std::string_view interned(copy, text.size());
+    strings.insert(interned);
+    return interned;
+}
+
+char* StringArena::Allocate(size_t bytes) {
+    if (blocks.empty() || blockUsed + bytes > blockCapacity) {
+        // Oversized strings get a block of their own
+        blockCapacity = bytes > BLOCK_SIZE ? bytes : BLOCK_SIZE;
+        blocks.push_back(std::unique_ptr<char[]>(new char[blockCapacity]));
+        blockUsed = 0;
+    }
+
+    char* memory = blocks.back().get() + blockUsed;
+    blockUsed += bytes;
+    bytesUsed += bytes;
+    return memory;
+}
+
+size_t StringArena::GetStringCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return strings.size();
+}
+
+size_t StringArena::GetBytesUsed() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytesUsed;
+}
@@ -0,0 +1,43 @@
+#ifndef STRING_ARENA_HPP
+#define STRING_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Interned strings for item names and emoji.
+// Each distinct string is stored once, packed back to back in large blocks
+// that are never freed or moved, so the returned views stay valid for the
+// rest of the program and can be copied around freely (Item holds them).
+// Intern may be called from any thread.
+class StringArena {
+public:
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    static StringArena& Instance();
+
+    // View of the interned copy of text (null-terminated in the arena)
+    std::string_view Intern(std::string_view text);
+
+    size_t GetStringCount() const;
+    size_t GetBytesUsed() const;
+
+private:
+    StringArena();
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    char* Allocate(size_t bytes);
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t blockUsed;      // Bytes used in blocks.back()
+    size_t blockCapacity;  // Size of blocks.back()
+    size_t bytesUsed;
+    std::unordered_set<std::string_view> strings;  // Views into the blocks
+};
+
+#endif // STRING_ARENA_HPP
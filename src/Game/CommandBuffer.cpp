@@ -0,0 +1,122 @@
+#include "CommandBuffer.hpp"
+#include "Game.hpp"
+#include "../Actor/Actor.hpp"
+#include "../Actor/Player.hpp"
+#include "../AI/PathfindingService.hpp"
+#include "../Component/HealthComponent.hpp"
+#include "../Component/MovementComponent.hpp"
+#include "../Component/AttackComponent.hpp"
+
+namespace
+{
+    thread_local CommandBuffer* tCurrentBuffer = nullptr;
+}
+
+CommandBuffer* CommandBuffer::Current()
+{
+    return tCurrentBuffer;
+}
+
+CommandBuffer::Scope::Scope(CommandBuffer* buffer)
+    : mPrevious(tCurrentBuffer)
+{
+    tCurrentBuffer = buffer;
+}
+
+CommandBuffer::Scope::~Scope()
+{
+    tCurrentBuffer = mPrevious;
+}
+
+void CommandBuffer::AddActor(std::unique_ptr<Actor> actor)
+{
+    mCommands.push_back({CommandType::AddActor, nullptr, Vector2::Zero, 0.0f, mNewActors.size()});
+    mNewActors.emplace_back(std::move(actor));
+}
+
+void CommandBuffer::DestroyActor(Actor* actor)
+{
+    mCommands.push_back({CommandType::DestroyActor, actor, Vector2::Zero, 0.0f, 0});
+}
+
+void CommandBuffer::ApplyImpulse(MovementComponent* movement, const Vector2& impulse)
+{
+    mCommands.push_back({CommandType::ApplyImpulse, movement, impulse, 0.0f, 0});
+}
+
+void CommandBuffer::TakeDamage(HealthComponent* health, float damage)
+{
+    mCommands.push_back({CommandType::TakeDamage, health, Vector2::Zero, damage, 0});
+}
+
+void CommandBuffer::PerformAttack(AttackComponent* attack)
+{
+    mCommands.push_back({CommandType::PerformAttack, attack, Vector2::Zero, 0.0f, 0});
+}
+
+void CommandBuffer::PickupItem(Player* player, const Item& item, int quantity)
+{
+    mCommands.push_back({CommandType::PickupItem, player, Vector2::Zero, static_cast<float>(quantity), mItems.size()});
+    mItems.push_back(item);
+}
+
+void CommandBuffer::RequestPath(PathfindingService* pathfinding, const Vector2& start, const Vector2& goal,
+                                uint32_t* ticket)
+{
+    for (PathRequest& request : mPathRequests)
+    {
+        if (request.ticket == ticket)
+        {
+            request.ticket = nullptr;
+        }
+    }
+
+    mCommands.push_back({CommandType::RequestPath, pathfinding, start, 0.0f, mPathRequests.size()});
+    mPathRequests.push_back({goal, ticket});
+}
+
+void CommandBuffer::Execute(Game* game)
+{
+    // Targets stay alive until the end of the step (removal is deferred), so
+    // the raw pointers recorded during the batch are still valid here
+    for (Command& command : mCommands)
+    {
+        switch (command.type)
+        {
+            case CommandType::AddActor:
+                game->AddActor(std::move(mNewActors[command.payload]));
+                break;
+            case CommandType::DestroyActor:
+                game->QueueDestroy(static_cast<Actor*>(command.target));
+                break;
+            case CommandType::ApplyImpulse:
+                static_cast<MovementComponent*>(command.target)->ApplyImpulse(command.vector);
+                break;
+            case CommandType::TakeDamage:
+                static_cast<HealthComponent*>(command.target)->TakeDamage(command.value);
+                break;
+            case CommandType::PerformAttack:
+                static_cast<AttackComponent*>(command.target)->PerformAttack();
+                break;
+            case CommandType::PickupItem:
+                static_cast<Player*>(command.target)->PickupItem(mItems[command.payload], static_cast<int>(command.value));
+                break;
+            case CommandType::RequestPath:
+                // Skipped if the requester dropped it (ClearPath) or asked again since
+                if (uint32_t* ticket = mPathRequests[command.payload].ticket)
+                {
+                    if (*ticket == PathfindingService::DEFERRED_TICKET)
+                    {
+                        *ticket = static_cast<PathfindingService*>(command.target)->RequestPath(
+                            command.vector, mPathRequests[command.payload].goal);
+                    }
+                }
+                break;
+        }
+    }
+
+    mCommands.clear();
+    mNewActors.clear();
+    mItems.clear();
+    mPathRequests.clear();
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include "../MathUtils.h"
+#include "../Crafting/Item.hpp"
+
+class Game;
+class Actor;
+class Player;
+class HealthComponent;
+class MovementComponent;
+class AttackComponent;
+class PathfindingService;
+
+// Records cross-actor mutations made while actors update in parallel.
+// During a parallel batch the mutating calls (AddActor, SetState(Destroy),
+// ApplyImpulse, TakeDamage, attacks, item pickups, path requests) check Current() and, if a
+// buffer is bound to the thread, record themselves instead of running.
+// Game replays the buffers on the main thread in batch order, so the outcome
+// does not depend on how batches were spread over threads.
+class CommandBuffer
+{
+public:
+    // Buffer bound to the calling thread (null outside a parallel batch)
+    static CommandBuffer* Current();
+
+    // Binds a buffer to the calling thread for the lifetime of the scope
+    class Scope
+    {
+    public:
+        explicit Scope(CommandBuffer* buffer);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        CommandBuffer* mPrevious;
+    };
+
+    void AddActor(std::unique_ptr<Actor> actor);
+    void DestroyActor(Actor* actor);
+    void ApplyImpulse(MovementComponent* movement, const Vector2& impulse);
+    void TakeDamage(HealthComponent* health, float damage);
+    void PerformAttack(AttackComponent* attack);
+    void PickupItem(Player* player, const Item& item, int quantity);
+    // Supersedes an earlier request recorded for the same ticket
+    void RequestPath(PathfindingService* pathfinding, const Vector2& start, const Vector2& goal, uint32_t* ticket);
+
+    bool IsEmpty() const { return mCommands.empty(); }
+
+    // Replays the commands in recording order and clears the buffer (main thread)
+    void Execute(Game* game);
+
+private:
+    enum class CommandType
+    {
+        AddActor,
+        DestroyActor,
+        ApplyImpulse,
+        TakeDamage,
+        PerformAttack,
+        PickupItem,
+        RequestPath
+    };
+
+    struct Command
+    {
+        CommandType type;
+        void* target;     // Actor or component the command applies to
+        Vector2 vector;
+        float value;
+        size_t payload;   // Index into mNewActors / mItems / mPathRequests
+    };
+
+    struct PathRequest
+    {
+        Vector2 goal;
+        uint32_t* ticket;  // Null once superseded
+    };
+
+    std::vector<Command> mCommands;
+    std::vector<std::unique_ptr<Actor>> mNewActors;
+    std::vector<Item> mItems;
+    std::vector<PathRequest> mPathRequests;
+};
@@ -14,22 +14,33 @@
 #include "../Actor/NPC/Concrete/TestAggressivePatrolNPC.hpp"
 #include "../Actor/NPC/Concrete/CatNPC.hpp"
 #include "../Map/TileMap.hpp"
+#include "../AI/PathfindingService.hpp"
 #include "../Core/Renderer/Renderer.hpp"
 #include "../Core/TextRenderer/TextRenderer.hpp"
 #include "../Core/RectRenderer/RectRenderer.hpp"
 #include "../Core/Texture/SpriteRenderer.hpp"
 #include "../Core/RenderUtils.hpp"
+#include "../Core/Profiler/Profiler.hpp"
+#include "../Core/Jobs/JobSystem.hpp"
 #include "../Crafting/Crafting.hpp"
 #include "Inventory.hpp"
 #include "ItemGenerator.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
+#include <random>
+#include <thread>
+#include <sys/resource.h>
 #include <nlohmann/json.hpp>
 #include "../Actor/NPC/Concrete/GenericNPC.hpp"
 #include "../Component/MovementComponent.hpp"
+#include "../Component/AnimationComponent.hpp"
 
 Game::Game(SDL_Window* window, SDL_GLContext glContext)
-    : mWindow(window)
+    : mWorkerCount(-1)
+    , mWindow(window)
     , mGLContext(glContext)
     , mRenderer(nullptr)
     , mTextRenderer(nullptr)
@@ -37,13 +48,21 @@ Game::Game(SDL_Window* window, SDL_GLContext glContext)
     , mSpriteRenderer(nullptr)
     , mCrafting(nullptr)
     , mTileMap(nullptr)
-    , mTicksCount(0)
+    , mHotReload(true)
+    , mSimulationRate(DEFAULT_SIMULATION_RATE)
+    , mFixedDeltaTime(1.0f / DEFAULT_SIMULATION_RATE)
+    , mAccumulator(0.0)
+    , mRenderAlpha(0.0f)
+    , mMaxFrameRate(DEFAULT_MAX_FRAME_RATE)
+    , mLastFrameCounter(0)
     , mIsRunning(true)
     , mUpdatingActors(false)
-    , mPlayer(nullptr)
-    , mInteractingNPC(nullptr)
+    , mPlayer()
+    , mInteractingNPC()
+    , mIndicatedNPC()
     , mMousePos(Vector2::Zero)
     , mCamera(std::make_unique<Camera>(static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT)))
+    , mRenderCameraPosition(Vector2::Zero)
     ,mAudio(nullptr)
 {
 }
@@ -54,47 +73,78 @@ bool Game::Initialize()
 {
     // SDL and OpenGL context must be initialized before calling this!
     // Remove SDL_Init, SDL_GL_SetAttribute, SDL_CreateWindow, SDL_GL_CreateContext
-    mRenderer = std::make_unique<Renderer>();
-    if (!mRenderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT))
+    if (!IsHeadless())
     {
-        SDL_Log("Failed to initialize renderer");
-        return false;
-    }
+        mRenderer = std::make_unique<Renderer>();
+        if (!mRenderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT))
+        {
+            SDL_Log("Failed to initialize renderer");
+            return false;
+        }
 
-    // Initialize text renderer
-    mTextRenderer = std::make_unique<TextRenderer>();
-    if (!mTextRenderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT))
-    {
-        SDL_Log("Warning: Failed to initialize text renderer");
-    }
+        // Initialize text renderer
+        mTextRenderer = std::make_unique<TextRenderer>();
+        if (!mTextRenderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT))
+        {
+            SDL_Log("Warning: Failed to initialize text renderer");
+        }
 
-    // Initialize rect renderer
-    mRectRenderer = std::make_unique<RectRenderer>();
-    if (!mRectRenderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT))
-    {
-        SDL_Log("Warning: Failed to initialize rect renderer");
-    }
+        // Initialize rect renderer
+        mRectRenderer = std::make_unique<RectRenderer>();
+        if (!mRectRenderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT))
+        {
+            SDL_Log("Warning: Failed to initialize rect renderer");
+        }
 
-    // Initialize sprite renderer
-    mSpriteRenderer = std::make_unique<SpriteRenderer>();
-    if (!mSpriteRenderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT))
-    {
-        SDL_Log("Warning: Failed to initialize sprite renderer");
+        // Initialize sprite renderer
+        mSpriteRenderer = std::make_unique<SpriteRenderer>();
+        if (!mSpriteRenderer->Initialize(WINDOW_WIDTH, WINDOW_HEIGHT))
+        {
+            SDL_Log("Warning: Failed to initialize sprite renderer");
+        }
     }
 
 
+    // Worker threads for the parallel part of the actor update
+    mJobs = std::make_unique<JobSystem>(mWorkerCount);
+
     // Initialize crafting system
     mCrafting = std::make_unique<Crafting>();
 
-    // Load items and recipes from JSON
-    if (!mCrafting->LoadItemsFromJson("assets/items.json"))
+    // Map the compiled database; the JSON stays the source of truth, so parse
+    // it instead when the database is missing or older than the JSON
+    if (!mCrafting->LoadCompiled("assets/items.db", "assets/items.json", "assets/recipes.json"))
+    {
+        SDL_Log("Compiled item database missing or stale, loading JSON");
+
+        if (!mCrafting->LoadItemsFromJson("assets/items.json"))
+        {
+            SDL_Log("Warning: Failed to load items");
+        }
+
+        if (!mCrafting->LoadRecipesFromJson("assets/recipes.json"))
+        {
+            SDL_Log("Warning: Failed to load recipes");
+        }
+    }
+
+    // Pairs without a recipe get one invented (and remembered across sessions)
+    std::unique_ptr<IRecipeGenerator> generator;
+    if (mRecipeGeneratorCommand.empty())
     {
-        SDL_Log("Warning: Failed to load items");
+        generator = std::make_unique<HashRecipeGenerator>();
     }
+    else
+    {
+        generator = std::make_unique<ProcessRecipeGenerator>(mRecipeGeneratorCommand);
+    }
+    mRecipeGenerator = std::make_unique<RecipeGenerationService>(*mCrafting, std::move(generator),
+                                                                 "generated_recipes.jsonl");
 
-    if (!mCrafting->LoadRecipesFromJson("assets/recipes.json"))
+    // Balancing edits to the JSON show up in the running game
+    if (mHotReload)
     {
-        SDL_Log("Warning: Failed to load recipes");
+        mCraftingReloader = std::make_unique<CraftingReloader>("assets/items.json", "assets/recipes.json");
     }
 
     // Create tile map
@@ -106,11 +156,15 @@ bool Game::Initialize()
     {
         SDL_Log("Warning: Failed to load custom map, using procedural generation");
     }
+    mPathfinding = std::make_unique<PathfindingService>(mTileMap.get());
 
-    mAudio = new AudioSystem();
+    if (!IsHeadless())
+    {
+        mAudio = new AudioSystem();
 
-    if (mAudio) {
-        mAudio->PlaySound("background.ogg", true, 50);
+        if (mAudio) {
+            mAudio->PlaySound("background.ogg", true, 50);
+        }
     }
 
     // Spawn items from map using ItemGenerator
@@ -118,17 +172,16 @@ bool Game::Initialize()
     itemGenerator.GenerateItemsFromMap(mTileMap.get());
 
     // Create player
-    auto player = std::make_unique<Player>(this);
-    mPlayer = player.get(); // Safe: player ownership transferred to mActors, pointer valid for game lifetime
-    AddActor(std::move(player));
+    mPlayer = AddActor(std::make_unique<Player>(this));
+    Player* player = GetPlayer();
 
     // Update player movement bounds to match map size
-    if (mPlayer && mTileMap)
+    if (player && mTileMap)
     {
         float mapWidth = static_cast<float>(mTileMap->GetWidth() * mTileMap->GetTileSize());
         float mapHeight = static_cast<float>(mTileMap->GetHeight() * mTileMap->GetTileSize());
 
-        auto* moveComp = mPlayer->GetComponent<MovementComponent>();
+        auto* moveComp = player->GetComponent<MovementComponent>();
         if (moveComp)
         {
             // Keep a small margin from the absolute edge
@@ -137,7 +190,7 @@ bool Game::Initialize()
     }
 
     // Give player some starting items for testing trades
-    if (mPlayer && mPlayer->GetInventory() && mCrafting)
+    if (player && player->GetInventory() && mCrafting)
     {
         // Add some basic elements that the shopkeeper wants
         const Item* water = mCrafting->FindItemById(1);  // Water
@@ -145,19 +198,20 @@ bool Game::Initialize()
         const Item* earth = mCrafting->FindItemById(3);  // Earth
 
         if (water)
-            mPlayer->GetInventory()->AddItem(*water, 5);  // 5 water
+            player->GetInventory()->AddItem(*water, 5);  // 5 water
         if (fire)
-            mPlayer->GetInventory()->AddItem(*fire, 5);   // 5 fire
+            player->GetInventory()->AddItem(*fire, 5);   // 5 fire
         if (earth)
-            mPlayer->GetInventory()->AddItem(*earth, 3);  // 3 earth
+            player->GetInventory()->AddItem(*earth, 3);  // 3 earth
 
                     // SDL_Log("Added starting items to player inventory");
     }
 
     // Create test shopkeeper NPC (dialog NPC with trading)
     auto testShopkeeperNPC = std::make_unique<TestShopkeeperNPC>(this);
-    RegisterNPC(testShopkeeperNPC.get());
+    DialogNPC* shopkeeper = testShopkeeperNPC.get();
     AddActor(std::move(testShopkeeperNPC));
+    RegisterNPC(shopkeeper);
 
     // Create test passive patrol NPC (patrols in a loop)
     auto testPassivePatrolNPC = std::make_unique<TestPassivePatrolNPC>(this);
@@ -169,26 +223,199 @@ bool Game::Initialize()
 
     // Create cat NPC (friendly dialog NPC with simple animation)
     auto catNPC = std::make_unique<CatNPC>(this);
-    RegisterNPC(catNPC.get());
+    DialogNPC* cat = catNPC.get();
     AddActor(std::move(catNPC));
+    RegisterNPC(cat);
 
     // Load NPCs from JSON
     LoadNPCsFromJson("assets/npcs.json");
 
     // Set different text color for variety
-    mTextRenderer->SetTextColor(1.0f, 1.0f, 1.0f); // White
-    mTicksCount = SDL_GetTicks();
+    if (mTextRenderer)
+    {
+        mTextRenderer->SetTextColor(1.0f, 1.0f, 1.0f); // White
+    }
+    mLastFrameCounter = SDL_GetPerformanceCounter();
+
+    // Index the initial actors so the first frame's input can query them
+    mSpatialGrid.Sync(mActors);
 
     return true;
 }
 
+void Game::SetSimulationRate(int hz)
+{
+    mSimulationRate = std::max(1, hz);
+    mFixedDeltaTime = 1.0f / static_cast<float>(mSimulationRate);
+}
+
 void Game::RunLoop()
 {
+    // Longest frame we try to catch up on; anything beyond that (debugger, window drag)
+    // is dropped instead of spiralling into ever more simulation steps
+    const double MAX_FRAME_TIME = 0.25;
+    const int MAX_STEPS_PER_FRAME = 8;
+
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    mLastFrameCounter = SDL_GetPerformanceCounter();
+
+    Profiler& profiler = Profiler::Instance();
+
     while (mIsRunning)
     {
-        ProcessInput();
-        UpdateGame();
-        GenerateOutput();
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        double frameTime = static_cast<double>(frameStart - mLastFrameCounter) / frequency;
+        mLastFrameCounter = frameStart;
+
+        profiler.BeginFrame();
+
+        mAccumulator += std::min(frameTime, MAX_FRAME_TIME);
+
+        {
+            PROFILE_SCOPE("ProcessInput");
+            ProcessInput();
+        }
+
+        // Advance the simulation in fixed steps, independent of the render rate
+        int steps = 0;
+        while (mAccumulator >= mFixedDeltaTime && steps < MAX_STEPS_PER_FRAME)
+        {
+            PROFILE_SCOPE("UpdateGame");
+            UpdateGame();
+            mAccumulator -= mFixedDeltaTime;
+            steps++;
+        }
+
+        // Still behind after the step cap: drop the backlog rather than stall rendering
+        if (steps == MAX_STEPS_PER_FRAME)
+        {
+            mAccumulator = std::fmod(mAccumulator, static_cast<double>(mFixedDeltaTime));
+        }
+
+        mRenderAlpha = static_cast<float>(mAccumulator / mFixedDeltaTime);
+
+        {
+            PROFILE_SCOPE("GenerateOutput");
+            GenerateOutput();
+        }
+        {
+            PROFILE_SCOPE("FramePacing");
+            WaitForNextFrame(frameStart);
+        }
+
+        profiler.EndFrame();
+    }
+}
+
+void Game::RunHeadless(int ticks)
+{
+    if (ticks <= 0) return;
+
+    std::vector<double> tickTimes;
+    tickTimes.reserve(ticks);
+
+    Profiler& profiler = Profiler::Instance();
+
+    // The player may die or quit mid-run; keep stepping so every run measures the same work
+    auto runStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < ticks; i++)
+    {
+        auto tickStart = std::chrono::steady_clock::now();
+        profiler.BeginFrame();
+        {
+            PROFILE_SCOPE("UpdateGame");
+            UpdateGame();
+        }
+        profiler.EndFrame();
+        auto tickEnd = std::chrono::steady_clock::now();
+        tickTimes.push_back(std::chrono::duration<double, std::milli>(tickEnd - tickStart).count());
+    }
+    double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+
+    std::sort(tickTimes.begin(), tickTimes.end());
+    auto percentile = [&tickTimes](double p) {
+        size_t index = static_cast<size_t>(p * static_cast<double>(tickTimes.size() - 1) + 0.5);
+        return tickTimes[std::min(index, tickTimes.size() - 1)];
+    };
+
+    // ru_maxrss is reported in kilobytes on Linux and in bytes on macOS
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    double peakRssMb = static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+    double peakRssMb = static_cast<double>(usage.ru_maxrss) / 1024.0;
+#endif
+
+    std::printf("[headless] ticks=%d actors=%zu sim_rate=%dHz workers=%d wall=%.3fs\n",
+                ticks, mActors.Size(), mSimulationRate, mJobs->GetWorkerCount(), totalSeconds);
+    std::printf("[headless] ticks/sec=%.1f\n", static_cast<double>(ticks) / totalSeconds);
+    std::printf("[headless] tick p50=%.3fms p99=%.3fms max=%.3fms\n",
+                percentile(0.50), percentile(0.99), tickTimes.back());
+    std::printf("[headless] peak_rss=%.1fMB\n", peakRssMb);
+}
+
+void Game::SpawnStressActors(int itemCount, int npcCount, unsigned int seed)
+{
+    if (!mTileMap) return;
+
+    std::mt19937 rng(seed);
+    float tileSize = static_cast<float>(mTileMap->GetTileSize());
+    std::uniform_real_distribution<float> xDist(tileSize, mTileMap->GetWidth() * tileSize - tileSize);
+    std::uniform_real_distribution<float> yDist(tileSize, mTileMap->GetHeight() * tileSize - tileSize);
+
+    // Pick a random spot that is not inside a collision tile (gives up after a few tries)
+    auto randomWalkablePosition = [&]() {
+        Vector2 pos(xDist(rng), yDist(rng));
+        for (int attempt = 0; attempt < 32 && mTileMap->CheckCollision(pos, 16.0f); attempt++)
+        {
+            pos = Vector2(xDist(rng), yDist(rng));
+        }
+        return pos;
+    };
+
+    // A pointer, so the item list is not copied (a ?: between an lvalue and a temporary would)
+    const std::vector<Item>* items = mCrafting ? &mCrafting->GetAllItems() : nullptr;
+    for (int i = 0; i < itemCount && items && !items->empty(); i++)
+    {
+        auto itemActor = std::make_unique<ItemActor>(this, (*items)[i % items->size()]);
+        itemActor->SetPosition(randomWalkablePosition());
+        AddActor(std::move(itemActor));
+    }
+
+    for (int i = 0; i < npcCount; i++)
+    {
+        auto npc = std::make_unique<TestAggressivePatrolNPC>(this);
+        Vector2 pos = randomWalkablePosition();
+        npc->SetPosition(pos);
+        npc->SetAnchorPosition(pos);
+        AddActor(std::move(npc));
+    }
+}
+
+void Game::WaitForNextFrame(Uint64 frameStart)
+{
+    if (mMaxFrameRate <= 0) return;
+
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 frameTicks = frequency / static_cast<Uint64>(mMaxFrameRate);
+    const Uint64 target = frameStart + frameTicks;
+
+    // Sleep in whole milliseconds while we are comfortably early, leaving a
+    // ~2ms margin for the OS scheduler, then yield the remainder away
+    const Uint64 margin = frequency / 500;
+    Uint64 now = SDL_GetPerformanceCounter();
+    while (now + margin < target)
+    {
+        Uint32 sleepMs = static_cast<Uint32>(((target - now - margin) * 1000) / frequency);
+        SDL_Delay(std::max<Uint32>(1, sleepMs));
+        now = SDL_GetPerformanceCounter();
+    }
+
+    while (now < target)
+    {
+        std::this_thread::yield();
+        now = SDL_GetPerformanceCounter();
     }
 }
 
@@ -202,6 +429,11 @@ void Game::ProcessInput()
             case SDL_QUIT:
                 Quit();
                 break;
+            case SDL_MOUSEMOTION:
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+                HandleMouseEvent(event);
+                break;
             default:
                 // Ignore other events
                 break;
@@ -211,11 +443,35 @@ void Game::ProcessInput()
     // Process keyboard state for player movement
     const Uint8* keyState = SDL_GetKeyboardState(nullptr);
 
+    // Profiler: F3 toggles the overlay, F4 dumps the recorded frames
+    static bool profilerToggleKeyPressed = false;
+    static bool profilerDumpKeyPressed = false;
+    Profiler& profiler = Profiler::Instance();
+
+    if (keyState[SDL_SCANCODE_F3] && !profilerToggleKeyPressed)
+    {
+        profiler.ToggleOverlay();
+    }
+    profilerToggleKeyPressed = keyState[SDL_SCANCODE_F3];
+
+    if (keyState[SDL_SCANCODE_F4] && !profilerDumpKeyPressed && profiler.GetFrameCount() > 0)
+    {
+        std::string base = "profile_" + std::to_string(profiler.GetFrame(0)->index);
+        if (profiler.ExportCsv(base + ".csv") && profiler.ExportChromeTrace(base + ".json"))
+        {
+            SDL_Log("Profiler: wrote %s.csv and %s.json", base.c_str(), base.c_str());
+        }
+    }
+    profilerDumpKeyPressed = keyState[SDL_SCANCODE_F4];
+
+    Player* player = GetPlayer();
+    DialogNPC* interactingNPC = GetInteractingNPC();
+
     // Check for NPC interaction
-    if (mInteractingNPC && mInteractingNPC->IsInteracting())
+    if (interactingNPC && interactingNPC->IsInteracting())
     {
         // If interacting with an NPC, pass input to the NPC
-        mInteractingNPC->HandleInteractionInput(keyState);
+        interactingNPC->HandleInteractionInput(keyState);
     }
     else
     {
@@ -224,21 +480,52 @@ void Game::ProcessInput()
 
         // Check for nearby NPCs and show interaction indicator
         DialogNPC* nearbyNPC = nullptr;
-        if (mPlayer)
+        if (player)
         {
-            for (DialogNPC* npc : mNPCs)
+            // Forget NPCs that have been destroyed since they registered
+            mNPCs.erase(
+                std::remove_if(mNPCs.begin(), mNPCs.end(),
+                    [this](ActorHandle handle) {
+                        return !mActors.Contains(handle);
+                    }),
+                mNPCs.end()
+            );
+
+            // Closest registered dialog NPC in reach, from the spatial grid
+            Vector2 playerPos = player->GetPosition();
+            float nearestDistSq = 0.0f;
+            mNearbyActors.clear();
+            mSpatialGrid.QueryRadius(playerPos, DialogNPC::INTERACTION_RANGE, ActorKind::DialogNPC, mNearbyActors);
+
+            for (Actor* actor : mNearbyActors)
             {
-                if (npc->CanInteract(mPlayer->GetPosition()))
+                DialogNPC* npc = static_cast<DialogNPC*>(actor);
+                if (!npc->CanInteract(playerPos) ||
+                    std::find(mNPCs.begin(), mNPCs.end(), npc->GetHandle()) == mNPCs.end())
                 {
-                    nearbyNPC = npc;
-                    npc->ShowInteractionIndicator(mPlayer->GetPosition());
-                    break;
+                    continue;
                 }
-                else
+
+                float distSq = (npc->GetPosition() - playerPos).LengthSq();
+                if (!nearbyNPC || distSq < nearestDistSq)
                 {
-                    npc->HideInteractionIndicator();
+                    nearbyNPC = npc;
+                    nearestDistSq = distSq;
                 }
             }
+
+            // Only the NPC in reach shows its indicator
+            DialogNPC* indicatedNPC = static_cast<DialogNPC*>(mActors.Get(mIndicatedNPC));
+            if (indicatedNPC && indicatedNPC != nearbyNPC)
+            {
+                indicatedNPC->HideInteractionIndicator();
+            }
+            mIndicatedNPC.Reset();
+            if (nearbyNPC)
+            {
+                nearbyNPC->ShowInteractionIndicator(playerPos);
+                mIndicatedNPC = nearbyNPC->GetHandle();
+            }
         }
 
         // Check for SPACE key press to interact with nearby NPCs
@@ -250,13 +537,13 @@ void Game::ProcessInput()
             if (nearbyNPC)
             {
                 nearbyNPC->StartInteraction();
-                mInteractingNPC = nearbyNPC;
+                mInteractingNPC = nearbyNPC->GetHandle();
                 startedInteraction = true;
 
                 // Stop player movement when starting interaction
-                if (mPlayer)
+                if (player)
                 {
-                    mPlayer->StopMovement();
+                    player->StopMovement();
                 }
             }
         }
@@ -266,76 +553,226 @@ void Game::ProcessInput()
         }
 
         // Process player input only when not interacting (and didn't just start interaction this frame)
-        if (mPlayer && !startedInteraction)
+        if (player && !startedInteraction)
         {
-            mPlayer->ProcessInput(keyState);
+            player->ProcessInput(keyState);
         }
     }
 }
 
 void Game::UpdateGame()
 {
-    // Wait until 16ms have passed (frame limiting)
-    while (!SDL_TICKS_PASSED(SDL_GetTicks(), mTicksCount + 16))
+    // Every simulation step advances by exactly the same amount
+    const float deltaTime = mFixedDeltaTime;
+
+    // Keep the last simulation state around for render interpolation
+    for (auto& actor : mActors)
     {
-        SDL_Delay(1);
+        actor->SaveTransform();
     }
 
-    float deltaTime = static_cast<float>(SDL_GetTicks() - mTicksCount) / 1000.0f;
-    if (deltaTime > 0.05f)
+    // Bring proximity queries up to date with last step's movement
     {
-        deltaTime = 0.05f;
+        PROFILE_SCOPE("SpatialGrid");
+        mSpatialGrid.Sync(mActors);
     }
 
-    mTicksCount = SDL_GetTicks();
+    // One flow field toward the player serves all chasers
+    {
+        PROFILE_SCOPE("FlowField");
+        Player* player = GetPlayer();
+        if (player && mTileMap)
+        {
+            mPlayerFlowField.Update(*mTileMap, player->GetPosition());
+        }
+        else
+        {
+            mPlayerFlowField.Clear();
+        }
+    }
+
+    // Every NPC's sight of the player in one batch (rays only for NPCs or a player that changed tile)
+    {
+        PROFILE_SCOPE("LineOfSight");
+        Player* player = GetPlayer();
+        if (player && mTileMap)
+        {
+            mPlayerSight.SetTarget(*mTileMap, player->GetPosition());
+
+            mNearbyActors.clear();
+            mSpatialGrid.QueryRadius(player->GetPosition(), mPlayerSight.GetMaxRange(), ActorKind::NPC, mNearbyActors);
+            for (Actor* actor : mNearbyActors)
+            {
+                mPlayerSight.Resolve(actor->GetPosition());
+            }
+        }
+        else
+        {
+            mPlayerSight.Clear();
+        }
+    }
+
+    // Items and recipes reloaded from disk since last step
+    {
+        PROFILE_SCOPE("CraftingReload");
+        ApplyCraftingReload();
+    }
+
+    // Combinations whose generated recipe arrived since last step
+    {
+        PROFILE_SCOPE("RecipeGenerator");
+        ApplyGeneratedRecipes();
+    }
 
     // Check if game is paused (interacting with NPC)
-    bool isPaused = mInteractingNPC && mInteractingNPC->IsInteracting();
+    DialogNPC* interactingNPC = GetInteractingNPC();
+    bool isPaused = interactingNPC && interactingNPC->IsInteracting();
 
     // Update all actors
     mUpdatingActors = true;
 
-    for (auto& actor : mActors)
     {
-        // When paused, only update the interacting NPC (for dialog UI)
+        PROFILE_SCOPE("Actors");
         if (isPaused)
         {
-            if (actor.get() == mInteractingNPC)
+            // When paused, only update the interacting NPC (for dialog UI)
+            PROFILE_ACTOR(interactingNPC, ActorPhase::Update);
+            interactingNPC->Update(deltaTime);
+
+            if (auto* animation = interactingNPC->GetComponent<AnimationComponent>())
             {
-                actor->Update(deltaTime);
+                animation->Update(deltaTime);
+            }
+            if (auto* movement = interactingNPC->GetComponent<MovementComponent>())
+            {
+                movement->Update(deltaTime);
             }
         }
         else
         {
-            actor->Update(deltaTime);
+            UpdateActors(deltaTime);
+        }
+    }
+
+    if (!isPaused)
+    {
+        // Answer this step's path requests (NPCs pick them up next step)
+        {
+            PROFILE_SCOPE("Pathfinding");
+            mPathfinding->Update();
         }
+
+        UpdateComponentSystems(deltaTime);
     }
 
     mUpdatingActors = false;
 
-    // Move pending actors to mActors
+    // Move pending actors to mActors (unless they died before ever being added)
     for (auto& pending : mPendingActors)
     {
-        mActors.emplace_back(std::move(pending));
+        if (pending->GetState() != ActorState::Destroy)
+        {
+            mActors.Insert(std::move(pending));
+        }
     }
     mPendingActors.clear();
 
     // Remove dead actors
-    mActors.erase(
-        std::remove_if(mActors.begin(), mActors.end(),
-            [](const std::unique_ptr<Actor>& actor) {
-                return actor->GetState() == ActorState::Destroy;
-            }),
-        mActors.end()
-    );
+    // (indexed loop: a destructor may queue further actors)
+    for (size_t i = 0; i < mDestroyQueue.size(); i++)
+    {
+        mSpatialGrid.Remove(mDestroyQueue[i]);
+        mActors.Remove(mDestroyQueue[i]);
+    }
+    mDestroyQueue.clear();
 
     // Update camera position to follow player
-    if (mPlayer && mTileMap)
+    Player* player = GetPlayer();
+    if (player && mTileMap)
     {
         int mapWidth = mTileMap->GetWidth() * mTileMap->GetTileSize();
         int mapHeight = mTileMap->GetHeight() * mTileMap->GetTileSize();
 
-        mCamera->Update(deltaTime, mPlayer->GetPosition(), mapWidth, mapHeight);
+        mCamera->Update(deltaTime, player->GetPosition(), mapWidth, mapHeight);
+    }
+}
+
+void Game::UpdateActors(float deltaTime)
+{
+    // Serial pass first (player, dialog NPCs, anything that mutates other actors
+    // directly), so the parallel batches read a settled player state
+    mParallelActors.clear();
+    {
+        PROFILE_SCOPE("Serial");
+        for (auto& actor : mActors)
+        {
+            if (actor->CanUpdateInParallel())
+            {
+                mParallelActors.push_back(actor.get());
+                continue;
+            }
+
+            PROFILE_ACTOR(actor.get(), ActorPhase::Update);
+            actor->Update(deltaTime);
+        }
+    }
+
+    int actorCount = static_cast<int>(mParallelActors.size());
+    int batchCount = (actorCount + ACTOR_BATCH_SIZE - 1) / ACTOR_BATCH_SIZE;
+    if (static_cast<int>(mBatchCommands.size()) < batchCount)
+    {
+        mBatchCommands.resize(batchCount);
+    }
+
+    // Per-actor timings are skipped here: the profiler only records the main thread
+    {
+        PROFILE_SCOPE("Parallel");
+        mJobs->ParallelFor(batchCount, [this, deltaTime, actorCount](int batch) {
+            CommandBuffer::Scope scope(&mBatchCommands[batch]);
+
+            int end = std::min(actorCount, (batch + 1) * ACTOR_BATCH_SIZE);
+            for (int i = batch * ACTOR_BATCH_SIZE; i < end; i++)
+            {
+                mParallelActors[i]->Update(deltaTime);
+            }
+        });
+    }
+
+    // Sync point: replay deferred mutations in batch order
+    {
+        PROFILE_SCOPE("ApplyCommands");
+        for (int batch = 0; batch < batchCount; batch++)
+        {
+            mBatchCommands[batch].Execute(this);
+        }
+    }
+}
+
+void Game::UpdateComponentSystems(float deltaTime)
+{
+    // Every entry is independent, so the pools are split into fixed chunks
+    // and stepped in parallel
+    auto chunkCount = [](size_t size) {
+        return static_cast<int>((size + SYSTEM_CHUNK_SIZE - 1) / SYSTEM_CHUNK_SIZE);
+    };
+
+    {
+        PROFILE_SCOPE("MovementSystem");
+        size_t count = mMovementPool.Size();
+        const TileMap* tileMap = mTileMap.get();
+        mJobs->ParallelFor(chunkCount(count), [this, deltaTime, count, tileMap](int chunk) {
+            size_t begin = static_cast<size_t>(chunk) * SYSTEM_CHUNK_SIZE;
+            mMovementPool.Update(deltaTime, begin, std::min(count, begin + SYSTEM_CHUNK_SIZE), tileMap);
+        });
+    }
+
+    {
+        PROFILE_SCOPE("AnimationSystem");
+        size_t count = mAnimationPool.Size();
+        mJobs->ParallelFor(chunkCount(count), [this, deltaTime, count](int chunk) {
+            size_t begin = static_cast<size_t>(chunk) * SYSTEM_CHUNK_SIZE;
+            mAnimationPool.Update(deltaTime, begin, std::min(count, begin + SYSTEM_CHUNK_SIZE));
+        });
     }
 }
 
@@ -346,68 +783,95 @@ void Game::GenerateOutput()
     // Use common render utility for screen clearing
     RenderUtils::ClearScreen(0.2f, 0.5f, 0.3f, 1.0f); // Green-ish background
 
+    // Blend the camera between the last two simulation steps
+    mRenderCameraPosition = mCamera->GetRenderPosition(mRenderAlpha);
+
     // Update sprite renderer camera
     if (mSpriteRenderer)
     {
-        mSpriteRenderer->SetCameraPosition(mCamera->GetPosition());
+        mSpriteRenderer->SetCameraPosition(mRenderCameraPosition);
     }
 
     // Draw tilemap first
     if (mTileMap)
     {
+        PROFILE_SCOPE("TileMap");
         mTileMap->Draw(mSpriteRenderer.get());
     }
 
     // Render all actors on top
-    for (auto& actor : mActors)
     {
-        if (actor->GetState() == ActorState::Active)
+        PROFILE_SCOPE("DrawActors");
+        for (auto& actor : mActors)
         {
-            // For TextRenderer, we might need to adjust position manually if it doesn't use SpriteRenderer
-            // But TextRenderer usually renders UI or world text.
-            // If it's world text, it needs camera offset.
-            // Let's assume TextRenderer handles UI (screen space) for now, or check if it needs update.
-            // The current TextRenderer implementation likely uses screen coordinates.
-            // If actors draw sprites via SpriteComponent, they use SpriteRenderer which now has camera.
-            // If they draw text via TextRenderer, we might need to offset.
+            if (actor->GetState() == ActorState::Active)
+            {
+                PROFILE_ACTOR(actor.get(), ActorPhase::Draw);
+
+                // For TextRenderer, we might need to adjust position manually if it doesn't use SpriteRenderer
+                // But TextRenderer usually renders UI or world text.
+                // If it's world text, it needs camera offset.
+                // Let's assume TextRenderer handles UI (screen space) for now, or check if it needs update.
+                // The current TextRenderer implementation likely uses screen coordinates.
+                // If actors draw sprites via SpriteComponent, they use SpriteRenderer which now has camera.
+                // If they draw text via TextRenderer, we might need to offset.
+
+                actor->OnDraw(mTextRenderer.get());
+            }
+        }
+    }
 
-            actor->OnDraw(mTextRenderer.get());
+    // Dialog boxes go above every actor: actor order changes as actors are removed
+    for (ActorHandle handle : mNPCs)
+    {
+        if (auto* npc = static_cast<DialogNPC*>(mActors.Get(handle)))
+        {
+            npc->DrawDialog(mTextRenderer.get(), mRectRenderer.get());
         }
     }
 
     // Render Player UI on top of everything
-    if (mPlayer && mPlayer->GetInventoryUI())
+    Player* player = GetPlayer();
+    if (player && player->GetInventoryUI())
     {
-        mPlayer->GetInventoryUI()->Draw(mTextRenderer.get(), mRectRenderer.get());
+        player->GetInventoryUI()->Draw(mTextRenderer.get(), mRectRenderer.get());
     }
 
+    // Profiler overlay sits above the game UI
+    Profiler::Instance().DrawOverlay(mTextRenderer.get(), mRectRenderer.get());
+
     mRenderer->EndFrame();
 
     SDL_GL_SwapWindow(mWindow);
 }
 
-void Game::AddActor(std::unique_ptr<Actor> actor)
+ActorHandle Game::AddActor(std::unique_ptr<Actor> actor)
 {
-    if (mUpdatingActors)
+    // New actors start without interpolation history
+    actor->SaveTransform();
+
+    // Spawned from a parallel update: added at the sync point
+    if (CommandBuffer* commands = CommandBuffer::Current())
     {
-        mPendingActors.emplace_back(std::move(actor));
+        commands->AddActor(std::move(actor));
+        return ActorHandle();
     }
-    else
+
+    if (mUpdatingActors)
     {
-        mActors.emplace_back(std::move(actor));
+        mPendingActors.emplace_back(std::move(actor));
+        return ActorHandle();
     }
+
+    return mActors.Insert(std::move(actor));
 }
 
 void Game::RemoveActor(Actor* actor)
 {
-    auto it = std::find_if(mActors.begin(), mActors.end(),
-        [actor](const std::unique_ptr<Actor>& a) {
-            return a.get() == actor;
-        });
-
-    if (it != mActors.end())
+    mSpatialGrid.Remove(actor->GetHandle());
+    if (mActors.Remove(actor->GetHandle()))
     {
-        mActors.erase(it);
+        return;
     }
 
     auto pendingIt = std::find_if(mPendingActors.begin(), mPendingActors.end(),
@@ -421,12 +885,42 @@ void Game::RemoveActor(Actor* actor)
     }
 }
 
+void Game::QueueDestroy(Actor* actor)
+{
+    if (CommandBuffer* commands = CommandBuffer::Current())
+    {
+        commands->DestroyActor(actor);
+        return;
+    }
+
+    // Pending actors have no handle yet; they are dropped when the pending list is flushed
+    if (actor->GetHandle().IsValid())
+    {
+        mDestroyQueue.push_back(actor->GetHandle());
+    }
+}
+
+Player* Game::GetPlayer()
+{
+    return static_cast<Player*>(mActors.Get(mPlayer));
+}
+
+DialogNPC* Game::GetInteractingNPC()
+{
+    return static_cast<DialogNPC*>(mActors.Get(mInteractingNPC));
+}
+
 void Game::Shutdown()
 {
     // Clear actors (smart pointers will automatically clean up)
     mIsRunning = false;
-    mActors.clear();
+    mJobs.reset();
+    mCraftPlanner.SetJobSystem(nullptr);
+    mSpatialGrid.Clear();
+    mActors.Clear();
     mPendingActors.clear();
+    mDestroyQueue.clear();
+    mPathfinding.reset();
 
     if (mTextRenderer)
     {
@@ -439,6 +933,11 @@ void Game::Shutdown()
         mRectRenderer.reset();
     }
 
+    // Before crafting: the generator registers its results there
+    mCraftingReloader.reset();
+    mRecipeGenerator.reset();
+    mPendingCombines.clear();
+
     if (mCrafting)
     {
         mCrafting.reset();
@@ -457,23 +956,32 @@ void Game::Shutdown()
         mGLContext = nullptr;
     }
 
-    SDL_DestroyWindow(mWindow);
+    if (mWindow)
+    {
+        SDL_DestroyWindow(mWindow);
+        mWindow = nullptr;
+    }
     SDL_Quit();
 }
 
 void Game::RegisterNPC(DialogNPC* npc)
 {
-    mNPCs.push_back(npc);
+    if (!npc->GetHandle().IsValid())
+    {
+        SDL_Log("Warning: RegisterNPC called before the NPC was added");
+        return;
+    }
+    mNPCs.push_back(npc->GetHandle());
 }
 
 void Game::UnregisterNPC(DialogNPC* npc)
 {
-    auto it = std::find(mNPCs.begin(), mNPCs.end(), npc);
+    auto it = std::find(mNPCs.begin(), mNPCs.end(), npc->GetHandle());
     if (it != mNPCs.end())
     {
-        if (mInteractingNPC == npc)
+        if (mInteractingNPC == npc->GetHandle())
         {
-            mInteractingNPC = nullptr;
+            mInteractingNPC.Reset();
         }
         mNPCs.erase(it);
     }
@@ -485,7 +993,19 @@ void Game::CombineItems(ItemActor* item1, ItemActor* item2)
         return;
 
     // Try to combine the items
-    auto result = mCrafting->combine_items(item1->GetItem(), item2->GetItem());
+    const Item* result = mCrafting->combine_items(item1->GetItem(), item2->GetItem());
+
+    if (!result && mRecipeGenerator)
+    {
+        // Unknown pair: have one invented and finish once it arrives
+        const Item& first = item1->GetItem();
+        const Item& second = item2->GetItem();
+        if (mRecipeGenerator->Request(first, second) || mRecipeGenerator->IsPending(first.id, second.id))
+        {
+            mPendingCombines.emplace_back(item1->GetHandle(), item2->GetHandle());
+        }
+        return;
+    }
 
     if (result)
     {
@@ -510,6 +1030,162 @@ void Game::CombineItems(ItemActor* item1, ItemActor* item2)
     }
 }
 
+CraftSuggestions* Game::GetCraftSuggestions()
+{
+    if (!mCrafting)
+        return nullptr;
+
+    // Rebuilt only when items or recipes changed (e.g. a generated recipe arrived)
+    mCraftSuggestions.Sync(*mCrafting);
+    return &mCraftSuggestions;
+}
+
+CraftPlanner* Game::GetCraftPlanner()
+{
+    if (!mCrafting)
+        return nullptr;
+
+    // Plans are searched from the main thread, so the bucket expansion can use the workers
+    mCraftPlanner.SetJobSystem(mJobs.get());
+    mCraftPlanner.Sync(*mCrafting);
+    return &mCraftPlanner;
+}
+
+// Item actor behind actor, or null if it is gone or on its way out
+static ItemActor* AsLiveItem(Actor* actor)
+{
+    if (!actor || !(actor->GetKind() & ActorKind::Item) || actor->GetState() == ActorState::Destroy)
+        return nullptr;
+    return static_cast<ItemActor*>(actor);
+}
+
+void Game::HandleMouseEvent(const SDL_Event& event)
+{
+    // Items are hit-tested within this distance of the cursor (they are drawn
+    // from their position rightwards, as wide as their label)
+    const float ITEM_PICK_RADIUS = 256.0f;
+
+    if (event.type == SDL_MOUSEMOTION)
+        mMousePos = Vector2(static_cast<float>(event.motion.x), static_cast<float>(event.motion.y));
+    else
+        mMousePos = Vector2(static_cast<float>(event.button.x), static_cast<float>(event.button.y));
+
+    // The open inventory takes the mouse
+    Player* player = GetPlayer();
+    InventoryUI* inventoryUI = player ? player->GetInventoryUI() : nullptr;
+    if (inventoryUI && inventoryUI->IsVisible())
+    {
+        if (event.type == SDL_MOUSEMOTION)
+            inventoryUI->HandleMouseMove(mMousePos);
+        else if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT)
+            inventoryUI->HandleMouseClick(mMousePos);
+        return;
+    }
+
+    ItemActor* dragged = AsLiveItem(GetActor(mDraggedItem));
+    if (event.type == SDL_MOUSEMOTION)
+    {
+        if (dragged)
+            dragged->OnMouseMove(mMousePos);
+        return;
+    }
+    if (event.button.button != SDL_BUTTON_LEFT)
+        return;
+
+    if (event.type == SDL_MOUSEBUTTONDOWN)
+    {
+        if (dragged)
+            return;
+
+        mNearbyActors.clear();
+        mSpatialGrid.QueryRadius(mMousePos + mRenderCameraPosition, ITEM_PICK_RADIUS, ActorKind::Item, mNearbyActors);
+        for (Actor* actor : mNearbyActors)
+        {
+            ItemActor* item = AsLiveItem(actor);
+            if (!item || item->IsBeingPickedUp())
+                continue;
+
+            item->OnMouseDown(mMousePos);
+            if (item->IsDragging())
+            {
+                mDraggedItem = item->GetHandle();
+                break;
+            }
+        }
+        return;
+    }
+
+    // Button released: drop the item, onto another one if they overlap
+    mDraggedItem.Reset();
+    if (!dragged || !dragged->IsDragging())
+        return;
+    dragged->OnMouseUp(mMousePos);
+
+    mNearbyActors.clear();
+    mSpatialGrid.QueryRadius(dragged->GetPosition(), ITEM_PICK_RADIUS, ActorKind::Item, mNearbyActors);
+    for (Actor* actor : mNearbyActors)
+    {
+        ItemActor* other = AsLiveItem(actor);
+        if (other && other != dragged && !other->IsBeingPickedUp() && dragged->Intersects(other))
+        {
+            CombineItems(dragged, other);
+            break;
+        }
+    }
+}
+
+void Game::ApplyGeneratedRecipes()
+{
+    if (!mRecipeGenerator)
+        return;
+
+    mGeneratedRecipes.clear();
+    mRecipeGenerator->Poll(mGeneratedRecipes);
+    if (mGeneratedRecipes.empty())
+        return;
+
+    // Retry the waiting combinations whose pair is settled; if generation
+    // failed there is still no recipe and the items just stay apart
+    size_t kept = 0;
+    for (size_t i = 0; i < mPendingCombines.size(); i++)
+    {
+        const auto combine = mPendingCombines[i];
+        ItemActor* item1 = AsLiveItem(GetActor(combine.first));
+        ItemActor* item2 = AsLiveItem(GetActor(combine.second));
+        if (!item1 || !item2 || !item1->Intersects(item2))
+            continue;  // Picked up, dragged apart or used in another combination meanwhile
+
+        int id1 = item1->GetItem().id;
+        int id2 = item2->GetItem().id;
+        if (mRecipeGenerator->IsPending(id1, id2))
+            mPendingCombines[kept++] = combine;
+        else if (mCrafting->FindRecipe(id1, id2) != RecipeTable::NO_RESULT)
+            CombineItems(item1, item2);
+    }
+    mPendingCombines.resize(kept);
+}
+
+void Game::ApplyCraftingReload()
+{
+    if (!mCraftingReloader)
+        return;
+
+    std::unique_ptr<Crafting> reloaded = mCraftingReloader->TakeReloaded();
+    if (!reloaded)
+        return;
+
+    // Between steps nothing holds a pointer into the old tables (actors and
+    // inventories keep Item handles, which outlive any Crafting), so the old
+    // one can go as soon as it is replaced
+    if (mRecipeGenerator)
+    {
+        mRecipeGenerator->Rebind(*reloaded);
+    }
+    mCrafting = std::move(reloaded);
+
+    SDL_Log("Reloaded %zu items and %zu recipes", mCrafting->GetAllItems().size(), mCrafting->GetRecipeCount());
+}
+
 void Game::LoadNPCsFromJson(const std::string& filePath)
 {
     std::ifstream file(filePath);
@@ -529,8 +1205,9 @@ void Game::LoadNPCsFromJson(const std::string& filePath)
             for (const auto& npcData : j["npcs"])
             {
                 auto npc = std::make_unique<GenericNPC>(this, npcData);
-                RegisterNPC(npc.get());
+                DialogNPC* dialogNPC = npc.get();
                 AddActor(std::move(npc));
+                RegisterNPC(dialogNPC);
             }
             // SDL_Log("Loaded NPCs from %s", filePath.c_str());
         }
@@ -8,16 +8,28 @@
 #include <memory>
 #include "../MathUtils.h"
 #include "../Actor/Actor.hpp"
+#include "../Actor/ActorSlotMap.hpp"
+#include "../Component/ComponentPools.hpp"
 #include "../Core/Renderer/Renderer.hpp"
 #include "../Core/TextRenderer/TextRenderer.hpp"
 #include "../Core/RectRenderer/RectRenderer.hpp"
 #include "../Core/Texture/SpriteRenderer.hpp"
 #include "../Crafting/Crafting.hpp"
+#include "../Crafting/CraftSuggestions.hpp"
+#include "../Crafting/CraftPlanner.hpp"
+#include "../Crafting/RecipeGenerationService.hpp"
+#include "../Crafting/CraftingReloader.hpp"
 #include "../Core/Camera.hpp"
 #include "../AudioSystem/AudioSystem.h"
+#include "CommandBuffer.hpp"
+#include "SpatialGrid.hpp"
+#include "../AI/FlowField.hpp"
+#include "../AI/LineOfSight.hpp"
 
 // Forward declarations
+class JobSystem;
 class TileMap;
+class PathfindingService;
 class Player;
 class DialogNPC;
 
@@ -32,9 +44,23 @@ public:
     void Shutdown();
     void Quit() { mIsRunning = false; }
 
+    // Headless mode (constructed without a window): no renderers or audio,
+    // simulation only. RunHeadless steps the game as fast as possible and
+    // prints tick throughput, latency percentiles and peak memory.
+    bool IsHeadless() const { return mWindow == nullptr; }
+    void RunHeadless(int ticks);
+    // Scatter extra items/NPCs over walkable tiles (for scaling measurements)
+    void SpawnStressActors(int itemCount, int npcCount, unsigned int seed = 1234);
+
     // Actor functions
-    void AddActor(std::unique_ptr<Actor> actor);
+    // Returns the new actor's handle; actors added mid-update are pending until
+    // the end of the step and get an invalid handle here
+    ActorHandle AddActor(std::unique_ptr<Actor> actor);
     void RemoveActor(Actor* actor);
+    // Null if the actor has been removed
+    Actor* GetActor(ActorHandle handle) const { return mActors.Get(handle); }
+    // Called by Actor::SetState(Destroy); the actor is removed after the current step
+    void QueueDestroy(Actor* actor);
 
     // Get text renderer for measurements
     TextRenderer* GetTextRenderer() { return mTextRenderer.get(); }
@@ -48,26 +74,72 @@ public:
 
     // Get crafting system
     Crafting* GetCrafting() { return mCrafting.get(); }
+    // Craftable pairs among held items (for the inventory and quest hints);
+    // null without a crafting system
+    CraftSuggestions* GetCraftSuggestions();
+    // Short (near-cheapest) combination plans toward an item (for NPC hints);
+    // null without a crafting system
+    CraftPlanner* GetCraftPlanner();
 
     // Get player
-    Player* GetPlayer() { return mPlayer; }
+    Player* GetPlayer();
 
     // Get tilemap
     TileMap* GetTileMap() { return mTileMap.get(); }
 
+    // Shared A* over the tilemap collision (answered during the step's sync point)
+    PathfindingService* GetPathfinding() { return mPathfinding.get(); }
+    // Directions toward the player, shared by every chasing NPC (rebuilt when
+    // the player changes tile)
+    const FlowField& GetPlayerFlowField() const { return mPlayerFlowField; }
+    // Line of sight to the player from NPC tiles (resolved for every NPC
+    // near the player at the start of the step)
+    const LineOfSight& GetPlayerSight() const { return mPlayerSight; }
+
+    // Component pools (SoA storage behind Movement/Animation/Sprite components)
+    MovementPool& GetMovementPool() { return mMovementPool; }
+    AnimationPool& GetAnimationPool() { return mAnimationPool; }
+    SpritePool& GetSpritePool() { return mSpritePool; }
+
+    // Proximity queries over the actors (positions as of the start of the step)
+    const SpatialGrid& GetSpatialGrid() const { return mSpatialGrid; }
+
     // Get all actors (for collision/interaction checks)
-    const std::vector<std::unique_ptr<Actor>>& GetActors() const { return mActors; }
+    const std::vector<std::unique_ptr<Actor>>& GetActors() const { return mActors.GetDense(); }
 
-    // NPC management
+    // NPC management (the NPC must already have been added)
     void RegisterNPC(DialogNPC* npc);
     void UnregisterNPC(DialogNPC* npc);
-    DialogNPC* GetInteractingNPC() { return mInteractingNPC; }
+    DialogNPC* GetInteractingNPC();
 
     // Mouse state
     const Vector2& GetMousePosition() const { return mMousePos; }
 
-    // Camera
+    // Camera as of the current simulation step (gameplay reads this one)
     const Vector2& GetCameraPosition() const { return mCamera->GetPosition(); }
+    // Camera interpolated for the frame being rendered (drawing and mouse picking)
+    const Vector2& GetRenderCameraPosition() const { return mRenderCameraPosition; }
+
+    // Fixed-step simulation
+    void SetSimulationRate(int hz);
+    int GetSimulationRate() const { return mSimulationRate; }
+    float GetFixedDeltaTime() const { return mFixedDeltaTime; }
+    // Blend factor [0, 1) between the previous and current simulation state
+    float GetRenderAlpha() const { return mRenderAlpha; }
+
+    // Frame pacing (0 = uncapped)
+    void SetMaxFrameRate(int fps) { mMaxFrameRate = fps; }
+
+    // Threads used for parallel actor updates besides the main thread
+    // (-1 = one per core). Must be set before Initialize.
+    void SetWorkerCount(int workers) { mWorkerCount = workers; }
+
+    // Helper process that invents unknown recipes (see ProcessRecipeGenerator);
+    // empty uses the built-in HashRecipeGenerator. Must be set before Initialize.
+    void SetRecipeGeneratorCommand(const std::string& command) { mRecipeGeneratorCommand = command; }
+    // Reload items.json/recipes.json when they change on disk (default on).
+    // Must be set before Initialize.
+    void SetHotReload(bool enabled) { mHotReload = enabled; }
 
     // Get renderer
     Renderer* GetRenderer() { return mRenderer.get(); }
@@ -75,15 +147,55 @@ public:
     static const int WINDOW_WIDTH = 1200;  // 30 tiles × 40px = 1200px
     static const int WINDOW_HEIGHT = 800;  // 20 tiles × 40px = 800px
 
+    static const int DEFAULT_SIMULATION_RATE = 60;  // Simulation steps per second
+    static const int DEFAULT_MAX_FRAME_RATE = 144;  // Render frames per second
+
+    // Parallel-safe actors are updated in fixed-size batches, so batching (and
+    // the order command buffers are applied in) is the same for any thread count
+    static const int ACTOR_BATCH_SIZE = 64;
+    // Pool entries per job for the component systems
+    static const size_t SYSTEM_CHUNK_SIZE = 1024;
+
 private:
     void ProcessInput();
+    // Left button drags item actors; dropping one onto another combines them
+    void HandleMouseEvent(const SDL_Event& event);
     void UpdateGame();
+    void UpdateActors(float deltaTime);
+    void UpdateComponentSystems(float deltaTime);
     void GenerateOutput();
     void CombineItems(class ItemActor* item1, class ItemActor* item2);
+    // Finishes combinations that were waiting on the recipe generator
+    void ApplyGeneratedRecipes();
+    void ApplyCraftingReload();
+    void WaitForNextFrame(Uint64 frameStart);
+
+    // Pooled component data (declared before the actors, which hold handles into them)
+    MovementPool mMovementPool;
+    AnimationPool mAnimationPool;
+    SpritePool mSpritePool;
+
+    // Declared before the actors too: NPCs cancel their path tickets on destruction
+    std::unique_ptr<PathfindingService> mPathfinding;
 
     // All the actors in the game
-    std::vector<std::unique_ptr<Actor>> mActors;
+    ActorSlotMap mActors;
     std::vector<std::unique_ptr<Actor>> mPendingActors;
+    std::vector<ActorHandle> mDestroyQueue;
+
+    // Actors bucketed by position, re-synced at the start of every step
+    SpatialGrid mSpatialGrid;
+    std::vector<Actor*> mNearbyActors;
+
+    // Chase directions toward the player, refreshed at the start of every step
+    FlowField mPlayerFlowField;
+    LineOfSight mPlayerSight;
+
+    // Parallel actor update
+    std::unique_ptr<JobSystem> mJobs;
+    int mWorkerCount;
+    std::vector<Actor*> mParallelActors;
+    std::vector<CommandBuffer> mBatchCommands;
 
     // SDL stuff
     SDL_Window* mWindow;
@@ -95,25 +207,45 @@ private:
     std::unique_ptr<Crafting> mCrafting;
     std::unique_ptr<TileMap> mTileMap;
 
-    // Track elapsed time since game start
-    Uint32 mTicksCount;
+    // Recipes for unknown pairs, invented off the main thread; the item
+    // actors of each combination wait in mPendingCombines until it arrives
+    std::unique_ptr<RecipeGenerationService> mRecipeGenerator;
+    std::string mRecipeGeneratorCommand;
+    // Rebuilds crafting off the main thread when the JSON changes; swapped in between steps
+    std::unique_ptr<CraftingReloader> mCraftingReloader;
+    bool mHotReload;
+    std::vector<std::pair<ActorHandle, ActorHandle>> mPendingCombines;
+    std::vector<RecipeGenerationService::Result> mGeneratedRecipes;
+    CraftSuggestions mCraftSuggestions;
+    CraftPlanner mCraftPlanner;
+
+    // Fixed-step timing
+    int mSimulationRate;
+    float mFixedDeltaTime;
+    double mAccumulator;
+    float mRenderAlpha;
+    int mMaxFrameRate;
+    Uint64 mLastFrameCounter;
 
     // Track if we're updating actors right now
     bool mIsRunning;
     bool mUpdatingActors;
 
     // Game objects
-    Player* mPlayer;
+    ActorHandle mPlayer;
 
     // NPC tracking
-    std::vector<DialogNPC*> mNPCs;
-    DialogNPC* mInteractingNPC;
+    std::vector<ActorHandle> mNPCs;
+    ActorHandle mInteractingNPC;
+    ActorHandle mIndicatedNPC;
 
     // Mouse state
     Vector2 mMousePos;
+    ActorHandle mDraggedItem;
 
     // Camera
     std::unique_ptr<Camera> mCamera;
+    Vector2 mRenderCameraPosition;
 
     AudioSystem* mAudio;
 
@@ -1,10 +1,11 @@
 #include "Inventory.hpp"
-#include <algorithm>
 
 Inventory::Inventory(int maxSlots)
-    : mMaxSlots(maxSlots)
+    : mUsedSlots(0)
+    , mMaxSlots(maxSlots)
 {
     mSlots.reserve(maxSlots);
+    mSlotIndex.reserve(maxSlots);
 }
 
 Inventory::~Inventory()
@@ -32,8 +33,22 @@ bool Inventory::AddItem(const Item& item, int quantity)
             return false;  // Inventory full
         }
         
-        // Create new slot
-        mSlots.emplace_back(item, quantity);
+        // Reuse an emptied slot before growing, so the grid stays compact
+        int slotIndex;
+        if (!mFreeSlots.empty())
+        {
+            slotIndex = mFreeSlots.back();
+            mFreeSlots.pop_back();
+            mSlots[slotIndex] = InventorySlot(item, quantity);
+        }
+        else
+        {
+            slotIndex = static_cast<int>(mSlots.size());
+            mSlots.emplace_back(item, quantity);
+        }
+
+        mSlotIndex[item.id] = slotIndex;
+        ++mUsedSlots;
         return true;
     }
 }
@@ -53,26 +68,28 @@ bool Inventory::RemoveItem(int itemId, int quantity)
 
 bool Inventory::RemoveItemAt(int slotIndex, int quantity)
 {
-    if (slotIndex < 0 || slotIndex >= static_cast<int>(mSlots.size()))
+    InventorySlot* slot = GetSlot(slotIndex);
+    if (!slot)
     {
-        return false;  // Invalid slot
+        return false;  // Invalid or empty slot
     }
 
     if (quantity <= 0) return false;
 
-    InventorySlot& slot = mSlots[slotIndex];
-    
-    if (slot.quantity < quantity)
+    if (slot->quantity < quantity)
     {
         return false;  // Not enough items
     }
 
-    slot.quantity -= quantity;
+    slot->quantity -= quantity;
 
-    // Remove slot if quantity reaches zero
-    if (slot.quantity <= 0)
+    // Empty the slot in place if quantity reaches zero; later slots keep their index
+    if (slot->quantity <= 0)
     {
-        mSlots.erase(mSlots.begin() + slotIndex);
+        slot->quantity = 0;
+        mSlotIndex.erase(slot->item.id);
+        mFreeSlots.push_back(slotIndex);
+        --mUsedSlots;
     }
 
     return true;
@@ -95,7 +112,7 @@ int Inventory::GetItemQuantity(int itemId) const
 
 const InventorySlot* Inventory::GetSlot(int index) const
 {
-    if (index < 0 || index >= static_cast<int>(mSlots.size()))
+    if (index < 0 || index >= static_cast<int>(mSlots.size()) || mSlots[index].IsEmpty())
     {
         return nullptr;
     }
@@ -104,7 +121,7 @@ const InventorySlot* Inventory::GetSlot(int index) const
 
 InventorySlot* Inventory::GetSlot(int index)
 {
-    if (index < 0 || index >= static_cast<int>(mSlots.size()))
+    if (index < 0 || index >= static_cast<int>(mSlots.size()) || mSlots[index].IsEmpty())
     {
         return nullptr;
     }
@@ -119,21 +136,22 @@ int Inventory::FindItemSlot(int itemId) const
 void Inventory::Clear()
 {
     mSlots.clear();
+    mSlotIndex.clear();
+    mFreeSlots.clear();
+    mUsedSlots = 0;
 }
 
 bool Inventory::IsFull() const
 {
-    return static_cast<int>(mSlots.size()) >= mMaxSlots;
+    return mUsedSlots >= mMaxSlots;
 }
 
 int Inventory::FindSlotIndex(int itemId) const
 {
-    for (size_t i = 0; i < mSlots.size(); ++i)
+    auto it = mSlotIndex.find(itemId);
+    if (it == mSlotIndex.end())
     {
-        if (mSlots[i].item.id == itemId)
-        {
-            return static_cast<int>(i);
-        }
+        return -1;  // Not found
     }
-    return -1;  // Not found
+    return it->second;
 }
@@ -1,19 +1,26 @@
 #pragma once
 #include "../Crafting/Item.hpp"
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <memory>
 
 // Represents a single slot in the inventory with an item and quantity
 struct InventorySlot
 {
     Item item;
-    int quantity;
+    int quantity;  // 0 once the slot has been emptied
 
     InventorySlot(const Item& item, int quantity = 1)
         : item(item), quantity(quantity) {}
+
+    bool IsEmpty() const { return quantity <= 0; }
 };
 
+// Slots keep their index for as long as they hold an item: removing one
+// leaves an empty slot in place (reused by the next new item) instead of
+// shifting the rest, so slot indices stay valid. Slots never outnumber
+// mMaxSlots and are reserved up front, so GetSlot pointers stay valid too.
+// An id -> slot index makes every lookup by item id O(1).
 class Inventory
 {
 public:
@@ -35,15 +42,20 @@ public:
     // Inventory management
     void Clear();
     bool IsFull() const;
-    int GetUsedSlots() const { return mSlots.size(); }
+    int GetUsedSlots() const { return mUsedSlots; }
     int GetMaxSlots() const { return mMaxSlots; }
+    // Slot indices in use so far, filled or empty (GetSlot range)
+    int GetSlotCount() const { return static_cast<int>(mSlots.size()); }
     
-    // Get all slots (for UI rendering)
+    // Get all slots (for UI rendering); skip the empty ones
     const std::vector<InventorySlot>& GetAllSlots() const { return mSlots; }
 
 private:
-    std::vector<InventorySlot> mSlots;  // Dynamic list of filled slots
-    int mMaxSlots;                       // Maximum number of slots
+    std::vector<InventorySlot> mSlots;            // Filled and emptied slots, by index
+    std::unordered_map<int, int> mSlotIndex;      // Item id -> index of its slot
+    std::vector<int> mFreeSlots;                  // Emptied slots, reused last-in first-out
+    int mUsedSlots;                               // Filled slots
+    int mMaxSlots;                                // Maximum number of slots
     
     // Helper to find an existing slot for an item
     int FindSlotIndex(int itemId) const;
@@ -45,19 +45,14 @@ void ItemGenerator::GenerateItemsFromMap(TileMap* tileMap) {
             }
 
             int count = 0;
-            for (int y = 0; y < layer.height; y++) {
-                for (int x = 0; x < layer.width; x++) {
-                    int index = y * layer.width + x;
-                    if (index < layer.data.size() && layer.data[index] != 0) {
-                        // Spawn item
-                        auto itemActor = std::make_unique<ItemActor>(mGame, *itemDef);
-                        Vector2 pos(x * tileSize + tileSize / 2.0f, y * tileSize + tileSize / 2.0f);
-                        itemActor->SetPosition(pos);
-                        mGame->AddActor(std::move(itemActor));
-                        count++;
-                    }
-                }
-            }
+            layer.ForEachTile([&](int x, int y, uint32_t) {
+                // Spawn item
+                auto itemActor = std::make_unique<ItemActor>(mGame, *itemDef);
+                Vector2 pos(x * tileSize + tileSize / 2.0f, y * tileSize + tileSize / 2.0f);
+                itemActor->SetPosition(pos);
+                mGame->AddActor(std::move(itemActor));
+                count++;
+            });
             // std::cout << "ItemGenerator: Spawned " << count << " items of type '" << itemName << "' from layer '" << layer.name << "'" << std::endl;
         }
     }
@@ -0,0 +1,192 @@
+#include "SpatialGrid.hpp"
+#include "../Actor/Actor.hpp"
+#include "../Actor/ActorSlotMap.hpp"
+#include <cmath>
+
+namespace
+{
+    // ActorKind::All also matches actors without any kind flags
+    bool KindMatches(uint32_t kinds, uint32_t kindMask)
+    {
+        return (kinds & kindMask) != 0 || kindMask == ActorKind::All;
+    }
+}
+
+SpatialGrid::SpatialGrid(float cellSize, uint32_t bucketCount)
+    : mCellSize(cellSize)
+    , mInvCellSize(1.0f / cellSize)
+    , mBucketMask(0)
+    , mCount(0)
+{
+    // Round the bucket count up to a power of two so hashing is a mask
+    uint32_t buckets = 1;
+    while (buckets < bucketCount)
+    {
+        buckets <<= 1;
+    }
+    mBucketMask = buckets - 1;
+    mBuckets.resize(buckets);
+}
+
+int32_t SpatialGrid::CellCoord(float value) const
+{
+    return static_cast<int32_t>(std::floor(value * mInvCellSize));
+}
+
+uint32_t SpatialGrid::BucketOf(int32_t cellX, int32_t cellY) const
+{
+    // Large primes spread neighbouring cells over different buckets
+    uint32_t hash = (static_cast<uint32_t>(cellX) * 73856093u) ^ (static_cast<uint32_t>(cellY) * 19349663u);
+    return hash & mBucketMask;
+}
+
+void SpatialGrid::Insert(Actor* actor, uint32_t slot, int32_t cellX, int32_t cellY)
+{
+    uint32_t bucket = BucketOf(cellX, cellY);
+    std::vector<Entry>& entries = mBuckets[bucket];
+
+    Location& location = mLocations[slot];
+    location.handle = actor->GetHandle();
+    location.bucket = bucket;
+    location.index = static_cast<uint32_t>(entries.size());
+
+    entries.push_back({actor, actor->GetPosition(), actor->GetKindMask(), cellX, cellY, slot});
+    mCount++;
+}
+
+void SpatialGrid::Erase(Location& location)
+{
+    std::vector<Entry>& entries = mBuckets[location.bucket];
+    if (location.index + 1 != entries.size())
+    {
+        entries[location.index] = entries.back();
+        mLocations[entries[location.index].slot].index = location.index;
+    }
+    entries.pop_back();
+    location.handle.Reset();
+    mCount--;
+}
+
+void SpatialGrid::Sync(const ActorSlotMap& actors)
+{
+    for (const auto& actor : actors)
+    {
+        ActorHandle handle = actor->GetHandle();
+        uint32_t slot = handle.GetIndex();
+        if (slot >= mLocations.size())
+        {
+            mLocations.resize(slot + 1);
+        }
+
+        const Vector2& position = actor->GetPosition();
+        int32_t cellX = CellCoord(position.x);
+        int32_t cellY = CellCoord(position.y);
+
+        Location& location = mLocations[slot];
+        if (location.handle != handle)
+        {
+            // New actor (or a reused slot whose old actor was never removed)
+            if (location.handle.IsValid())
+            {
+                Erase(location);
+            }
+            Insert(actor.get(), slot, cellX, cellY);
+            continue;
+        }
+
+        Entry& entry = mBuckets[location.bucket][location.index];
+        if (entry.cellX != cellX || entry.cellY != cellY)
+        {
+            Erase(location);
+            Insert(actor.get(), slot, cellX, cellY);
+        }
+        else
+        {
+            entry.position = position;
+        }
+    }
+}
+
+void SpatialGrid::Remove(ActorHandle handle)
+{
+    uint32_t slot = handle.GetIndex();
+    if (handle.IsValid() && slot < mLocations.size() && mLocations[slot].handle == handle)
+    {
+        Erase(mLocations[slot]);
+    }
+}
+
+void SpatialGrid::Clear()
+{
+    for (auto& entries : mBuckets)
+    {
+        entries.clear();
+    }
+    mLocations.clear();
+    mCount = 0;
+}
+
+template <typename Visitor>
+void SpatialGrid::ForEachInCells(const Vector2& min, const Vector2& max, Visitor&& visit) const
+{
+    int32_t minX = CellCoord(min.x);
+    int32_t minY = CellCoord(min.y);
+    int32_t maxX = CellCoord(max.x);
+    int32_t maxY = CellCoord(max.y);
+
+    auto inRange = [&](const Entry& entry) {
+        return entry.cellX >= minX && entry.cellX <= maxX &&
+               entry.cellY >= minY && entry.cellY <= maxY;
+    };
+
+    // A range covering more cells than there are buckets would visit buckets
+    // repeatedly; walk every bucket once instead
+    uint64_t cellCount = static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxY - minY + 1);
+    if (cellCount > mBuckets.size())
+    {
+        for (const auto& entries : mBuckets)
+        {
+            for (const Entry& entry : entries)
+            {
+                if (inRange(entry)) visit(entry);
+            }
+        }
+        return;
+    }
+
+    for (int32_t cellY = minY; cellY <= maxY; cellY++)
+    {
+        for (int32_t cellX = minX; cellX <= maxX; cellX++)
+        {
+            // Buckets are shared between cells; only take this cell's entries
+            for (const Entry& entry : mBuckets[BucketOf(cellX, cellY)])
+            {
+                if (entry.cellX == cellX && entry.cellY == cellY) visit(entry);
+            }
+        }
+    }
+}
+
+void SpatialGrid::QueryRadius(const Vector2& center, float radius, uint32_t kindMask, std::vector<Actor*>& out) const
+{
+    Vector2 extent(radius, radius);
+    float radiusSq = radius * radius;
+
+    ForEachInCells(center - extent, center + extent, [&](const Entry& entry) {
+        if (KindMatches(entry.kinds, kindMask) && (entry.position - center).LengthSq() <= radiusSq)
+        {
+            out.push_back(entry.actor);
+        }
+    });
+}
+
+void SpatialGrid::QueryBox(const Vector2& min, const Vector2& max, uint32_t kindMask, std::vector<Actor*>& out) const
+{
+    ForEachInCells(min, max, [&](const Entry& entry) {
+        const Vector2& p = entry.position;
+        if (KindMatches(entry.kinds, kindMask) && p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y)
+        {
+            out.push_back(entry.actor);
+        }
+    });
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "../MathUtils.h"
+#include "../Actor/ActorHandle.hpp"
+
+class Actor;
+class ActorSlotMap;
+
+// Uniform-grid spatial hash for actor proximity queries.
+// Each actor sits in the cell containing its position; cells are hashed into a
+// fixed, power-of-two number of buckets, so the world needs no known extent.
+// Game re-syncs the grid once per simulation step (before the actor update),
+// which only moves the actors that changed cell. Queries see positions as of
+// that sync and are read-only, so they are safe from parallel actor updates.
+class SpatialGrid
+{
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 128.0f;
+    static constexpr uint32_t DEFAULT_BUCKET_COUNT = 4096;
+
+    explicit SpatialGrid(float cellSize = DEFAULT_CELL_SIZE, uint32_t bucketCount = DEFAULT_BUCKET_COUNT);
+
+    // Inserts new actors and re-buckets the ones that changed cell
+    void Sync(const ActorSlotMap& actors);
+    // Drops an actor (call before it is destroyed; stale handles are ignored)
+    void Remove(ActorHandle handle);
+    void Clear();
+
+    // Append actors whose kind mask intersects kindMask (ActorKind::All matches any)
+    void QueryRadius(const Vector2& center, float radius, uint32_t kindMask, std::vector<Actor*>& out) const;
+    void QueryBox(const Vector2& min, const Vector2& max, uint32_t kindMask, std::vector<Actor*>& out) const;
+
+    size_t Size() const { return mCount; }
+    float GetCellSize() const { return mCellSize; }
+
+private:
+    struct Entry
+    {
+        Actor* actor;
+        Vector2 position;
+        uint32_t kinds;
+        int32_t cellX;
+        int32_t cellY;
+        uint32_t slot;       // Handle index, for patching the location on swap-remove
+    };
+
+    struct Location
+    {
+        ActorHandle handle;  // Invalid while the slot is not in the grid
+        uint32_t bucket;
+        uint32_t index;      // Position inside the bucket
+    };
+
+    int32_t CellCoord(float value) const;
+    uint32_t BucketOf(int32_t cellX, int32_t cellY) const;
+    void Insert(Actor* actor, uint32_t slot, int32_t cellX, int32_t cellY);
+    void Erase(Location& location);
+
+    // Calls visit(entry) for every entry in the cells overlapping [min, max]
+    template <typename Visitor>
+    void ForEachInCells(const Vector2& min, const Vector2& max, Visitor&& visit) const;
+
+    float mCellSize;
+    float mInvCellSize;
+    uint32_t mBucketMask;
+    size_t mCount;
+
+    std::vector<std::vector<Entry>> mBuckets;
+    std::vector<Location> mLocations;  // By handle index
+};
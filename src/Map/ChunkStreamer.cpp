@@ -0,0 +1,338 @@
+#include "ChunkStreamer.hpp"
+#include "../Core/Texture/Texture.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    const size_t DEFAULT_TILE_BUDGET = 64u * 1024u * 1024u;
+    const size_t DEFAULT_TEXTURE_BUDGET = 256u * 1024u * 1024u;
+}
+
+std::vector<uint32_t> DecodeTiledBase64(const std::string& text)
+{
+    static const auto table = [] {
+        std::vector<int> t(256, -1);
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; i++)
+        {
+            t[static_cast<unsigned char>(alphabet[i])] = i;
+        }
+        return t;
+    }();
+
+    std::vector<uint8_t> bytes;
+    bytes.reserve(text.size() * 3 / 4);
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (char c : text)
+    {
+        int value = table[static_cast<unsigned char>(c)];
+        if (value < 0) continue;  // Padding, newlines
+
+        buffer = (buffer << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            bytes.push_back(static_cast<uint8_t>((buffer >> bits) & 0xFF));
+        }
+    }
+
+    std::vector<uint32_t> gids(bytes.size() / 4);
+    for (size_t i = 0; i < gids.size(); i++)
+    {
+        gids[i] = static_cast<uint32_t>(bytes[i * 4]) |
+                  (static_cast<uint32_t>(bytes[i * 4 + 1]) << 8) |
+                  (static_cast<uint32_t>(bytes[i * 4 + 2]) << 16) |
+                  (static_cast<uint32_t>(bytes[i * 4 + 3]) << 24);
+    }
+    return gids;
+}
+
+bool PackedTiles::Pack(const uint32_t* source, int rectWidth, int rectHeight, size_t stride)
+{
+    width = rectWidth;
+    height = rectHeight;
+    palette.clear();
+    indices.clear();
+    gids.clear();
+
+    // Palette in first-seen order, found through a small open-addressing
+    // table (twice the palette's capacity, so probes stay short)
+    const uint32_t SLOTS = 512;
+    uint32_t slotGid[SLOTS];
+    int16_t slotEntry[SLOTS];
+    std::fill(slotEntry, slotEntry + SLOTS, static_cast<int16_t>(-1));
+
+    bool empty = true;
+    indices.reserve(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; y++)
+    {
+        const uint32_t* row = source + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < width; x++)
+        {
+            uint32_t gid = row[x];
+            empty = empty && gid == 0;
+
+            uint32_t slot = (gid * 2654435761u) >> 23;
+            while (slotEntry[slot] >= 0 && slotGid[slot] != gid)
+            {
+                slot = (slot + 1) & (SLOTS - 1);
+            }
+            if (slotEntry[slot] < 0)
+            {
+                if (palette.size() == 256)
+                {
+                    // Too varied for byte indices: keep the gids as they are
+                    palette.clear();
+                    indices.clear();
+                    indices.shrink_to_fit();
+                    gids.reserve(static_cast<size_t>(width) * height);
+                    for (int copyY = 0; copyY < height; copyY++)
+                    {
+                        const uint32_t* copyRow = source + static_cast<size_t>(copyY) * stride;
+                        gids.insert(gids.end(), copyRow, copyRow + width);
+                    }
+                    return true;
+                }
+                slotGid[slot] = gid;
+                slotEntry[slot] = static_cast<int16_t>(palette.size());
+                palette.push_back(gid);
+            }
+            indices.push_back(static_cast<uint8_t>(slotEntry[slot]));
+        }
+    }
+
+    if (empty)
+    {
+        width = height = 0;
+        palette.clear();
+        indices.clear();
+        return false;
+    }
+    palette.shrink_to_fit();
+    return true;
+}
+
+ChunkStreamer::ChunkStreamer(int chunksX, int chunksY, int layerCount)
+    : mChunksX(std::max(chunksX, 0))
+    , mChunksY(std::max(chunksY, 0))
+    , mLayerCount(layerCount)
+    , mChunks(static_cast<size_t>(mChunksX) * mChunksY)
+    , mTileBudget(DEFAULT_TILE_BUDGET)
+    , mTextureBudget(DEFAULT_TEXTURE_BUDGET)
+    , mTileBytes(0)
+    , mTextureBytes(0)
+    , mStopping(false)
+{
+}
+
+ChunkStreamer::~ChunkStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWake.notify_all();
+    if (mLoader.joinable())
+    {
+        mLoader.join();
+    }
+}
+
+void ChunkStreamer::AddPiece(int chunkX, int chunkY, ChunkPiece piece)
+{
+    if (Chunk* chunk = GetChunk(chunkX, chunkY))
+    {
+        chunk->pieces.push_back(std::move(piece));
+    }
+}
+
+ChunkStreamer::Chunk* ChunkStreamer::GetChunk(int chunkX, int chunkY)
+{
+    if (chunkX < 0 || chunkX >= mChunksX || chunkY < 0 || chunkY >= mChunksY) return nullptr;
+
+    return &mChunks[static_cast<size_t>(chunkY) * mChunksX + chunkX];
+}
+
+void ChunkStreamer::Request(int minX, int minY, int maxX, int maxY, uint64_t frame)
+{
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, mChunksX - 1);
+    maxY = std::min(maxY, mChunksY - 1);
+
+    // Chunks in range that still need decoding, nearest to the center first
+    std::vector<std::pair<int, int>> wanted;  // (distance, index)
+    int centerX = (minX + maxX) / 2;
+    int centerY = (minY + maxY) / 2;
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            int index = y * mChunksX + x;
+            Chunk& chunk = mChunks[index];
+            chunk.requestFrame = frame;
+            chunk.lastUsedFrame = frame;
+            if (!chunk.pieces.empty() && !chunk.tiles && !chunk.queued && NeedsTiles(x, y))
+            {
+                wanted.emplace_back(std::abs(x - centerX) + std::abs(y - centerY), index);
+            }
+        }
+    }
+    std::sort(wanted.begin(), wanted.end());
+
+    std::vector<std::pair<int, std::unique_ptr<ChunkTiles>>> done;
+    bool hasWork;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // Queued chunks the camera has moved away from are not worth decoding
+        std::deque<int> pending;
+        for (int index : mPending)
+        {
+            if (mChunks[index].requestFrame == frame)
+            {
+                pending.push_back(index);
+            }
+            else
+            {
+                mChunks[index].queued = false;
+            }
+        }
+        for (const auto& entry : wanted)
+        {
+            mChunks[entry.second].queued = true;
+            pending.push_back(entry.second);
+        }
+        mPending.swap(pending);
+        hasWork = !mPending.empty();
+        done.swap(mDone);
+    }
+
+    if (hasWork)
+    {
+        // Started on first use so maps that are never drawn (headless) cost no thread
+        if (!mLoader.joinable())
+        {
+            mLoader = std::thread(&ChunkStreamer::LoaderLoop, this);
+        }
+        mWake.notify_one();
+    }
+
+    for (auto& entry : done)
+    {
+        Chunk& chunk = mChunks[entry.first];
+        chunk.queued = false;
+        mTileBytes += static_cast<size_t>(mLayerCount) * CHUNK_SIZE * CHUNK_SIZE * sizeof(uint32_t);
+        chunk.tiles = std::move(entry.second);
+    }
+}
+
+bool ChunkStreamer::NeedsTiles(int chunkX, int chunkY)
+{
+    // Baked chunks only need their tiles again while a neighbour still has to
+    // be baked (tiles hanging over the border are drawn into both)
+    for (int y = chunkY - 1; y <= chunkY + 1; y++)
+    {
+        for (int x = chunkX - 1; x <= chunkX + 1; x++)
+        {
+            Chunk* chunk = GetChunk(x, y);
+            if (chunk && !chunk->pieces.empty() && !chunk->texture) return true;
+        }
+    }
+    return false;
+}
+
+void ChunkStreamer::SetTexture(Chunk& chunk, std::unique_ptr<Texture> texture)
+{
+    mTextureBytes -= TextureBytes(chunk.texture.get());
+    chunk.texture = std::move(texture);
+    mTextureBytes += TextureBytes(chunk.texture.get());
+}
+
+size_t ChunkStreamer::TextureBytes(const Texture* texture)
+{
+    if (!texture) return 0;
+
+    return static_cast<size_t>(texture->GetWidth()) * texture->GetHeight() * 4;
+}
+
+void ChunkStreamer::Trim(uint64_t frame)
+{
+    if (mTileBytes <= mTileBudget && mTextureBytes <= mTextureBudget) return;
+
+    // Least recently used first; chunks in use this frame are never evicted
+    std::vector<std::pair<uint64_t, int>> candidates;
+    for (size_t i = 0; i < mChunks.size(); i++)
+    {
+        const Chunk& chunk = mChunks[i];
+        if ((chunk.tiles || chunk.texture) && chunk.lastUsedFrame != frame)
+        {
+            candidates.emplace_back(chunk.lastUsedFrame, static_cast<int>(i));
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    size_t chunkTileBytes = static_cast<size_t>(mLayerCount) * CHUNK_SIZE * CHUNK_SIZE * sizeof(uint32_t);
+    for (const auto& candidate : candidates)
+    {
+        if (mTileBytes <= mTileBudget && mTextureBytes <= mTextureBudget) break;
+
+        Chunk& chunk = mChunks[candidate.second];
+        if (mTileBytes > mTileBudget && chunk.tiles)
+        {
+            chunk.tiles.reset();
+            mTileBytes -= chunkTileBytes;
+        }
+        if (mTextureBytes > mTextureBudget && chunk.texture)
+        {
+            SetTexture(chunk, nullptr);
+        }
+    }
+}
+
+void ChunkStreamer::LoaderLoop()
+{
+    while (true)
+    {
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [this] { return mStopping || !mPending.empty(); });
+            if (mStopping) return;
+
+            index = mPending.front();
+            mPending.pop_front();
+        }
+
+        // Pieces never change after loading, so decoding needs no lock
+        std::unique_ptr<ChunkTiles> tiles = Decode(mChunks[index]);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mDone.emplace_back(index, std::move(tiles));
+    }
+}
+
+std::unique_ptr<ChunkTiles> ChunkStreamer::Decode(const Chunk& chunk) const
+{
+    auto tiles = std::make_unique<ChunkTiles>();
+    tiles->layers.assign(mLayerCount, std::vector<uint32_t>(CHUNK_SIZE * CHUNK_SIZE, 0));
+
+    for (const ChunkPiece& piece : chunk.pieces)
+    {
+        if (piece.layer < 0 || piece.layer >= mLayerCount) continue;
+
+        std::vector<uint32_t>& layer = tiles->layers[piece.layer];
+        for (int y = 0; y < piece.tiles.height; y++)
+        {
+            for (int x = 0; x < piece.tiles.width; x++)
+            {
+                layer[(piece.offsetY + y) * CHUNK_SIZE + piece.offsetX + x] = piece.tiles.At(x, y);
+            }
+        }
+    }
+
+    return tiles;
+}
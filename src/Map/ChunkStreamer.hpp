@@ -0,0 +1,131 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class Texture;
+
+// Decodes Tiled's uncompressed base64 tile data (little-endian uint32 gids)
+std::vector<uint32_t> DecodeTiledBase64(const std::string& text);
+
+// A rectangle of tile gids kept compact: the distinct gids in a palette and
+// one byte per tile, or the gids themselves when there are more than 256
+// distinct ones. A chunk of a map repeats few gids, so this is usually a
+// quarter of the raw size.
+struct PackedTiles
+{
+    int width = 0;
+    int height = 0;
+    std::vector<uint32_t> palette;
+    std::vector<uint8_t> indices;
+    std::vector<uint32_t> gids;  // Instead of palette/indices when those would not fit
+
+    // Packs the width x height rectangle starting at source, rows stride
+    // apart; false (and left empty) if every tile is 0
+    bool Pack(const uint32_t* source, int width, int height, size_t stride);
+
+    uint32_t At(int x, int y) const
+    {
+        size_t index = static_cast<size_t>(y) * width + x;
+        return gids.empty() ? palette[indices[index]] : gids[index];
+    }
+};
+
+// A rectangle of one visual layer's tiles that lands inside a chunk, packed
+// at load time; expanded to plain gids when the chunk is streamed in
+struct ChunkPiece
+{
+    int layer;               // Index into the visual layers
+    int offsetX;             // Placement inside the chunk, in tiles
+    int offsetY;
+    PackedTiles tiles;
+};
+
+// Decoded gids of every visual layer of one chunk (CHUNK_SIZE^2 each, 0 = empty)
+struct ChunkTiles
+{
+    std::vector<std::vector<uint32_t>> layers;
+};
+
+// Streams the map's visual layers in fixed-size chunks.
+// Chunk sources are registered at load; the render thread asks for the chunks
+// around the camera every frame, a background thread decodes them, and the
+// render thread bakes decoded chunks into textures. Decoded tiles and baked
+// textures are each kept under a byte budget by evicting the least recently
+// used chunks, so memory stays bounded however large the map is.
+class ChunkStreamer
+{
+public:
+    static const int CHUNK_SIZE = 32;  // Tiles per chunk side
+
+    struct Chunk
+    {
+        std::vector<ChunkPiece> pieces;
+        std::unique_ptr<ChunkTiles> tiles;   // Decoded, or null
+        std::unique_ptr<Texture> texture;    // Baked, or null
+        bool queued = false;                 // Waiting for / being decoded
+        uint64_t requestFrame = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    ChunkStreamer(int chunksX, int chunksY, int layerCount);
+    ~ChunkStreamer();
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // Load time: adds a source rectangle to chunk (x, y)
+    void AddPiece(int chunkX, int chunkY, ChunkPiece piece);
+
+    // Render thread, once per frame: queues the chunks in the inclusive range
+    // (nearest to the center first), drops queued chunks that left it and
+    // picks up finished decodes
+    void Request(int minX, int minY, int maxX, int maxY, uint64_t frame);
+    // Render thread: evicts least recently used tiles/textures over budget
+    void Trim(uint64_t frame);
+
+    // Null outside the map
+    Chunk* GetChunk(int chunkX, int chunkY);
+
+    int GetChunksX() const { return mChunksX; }
+    int GetChunksY() const { return mChunksY; }
+
+    // Byte budgets for decoded tiles and baked textures
+    void SetTileBudget(size_t bytes) { mTileBudget = bytes; }
+    void SetTextureBudget(size_t bytes) { mTextureBudget = bytes; }
+    // Call after baking or dropping a chunk's texture
+    void SetTexture(Chunk& chunk, std::unique_ptr<Texture> texture);
+
+    size_t GetTileBytes() const { return mTileBytes; }
+    size_t GetTextureBytes() const { return mTextureBytes; }
+
+private:
+    void LoaderLoop();
+    bool NeedsTiles(int chunkX, int chunkY);
+    std::unique_ptr<ChunkTiles> Decode(const Chunk& chunk) const;
+    static size_t TextureBytes(const Texture* texture);
+
+    int mChunksX;
+    int mChunksY;
+    int mLayerCount;
+    std::vector<Chunk> mChunks;  // Row-major; pieces are immutable once loading starts
+
+    size_t mTileBudget;
+    size_t mTextureBudget;
+    size_t mTileBytes;
+    size_t mTextureBytes;
+
+    // Background decoding
+    std::thread mLoader;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::deque<int> mPending;                                        // Chunk indices, nearest first
+    std::vector<std::pair<int, std::unique_ptr<ChunkTiles>>> mDone;  // Finished decodes
+    bool mStopping;
+};
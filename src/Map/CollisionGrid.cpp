@@ -0,0 +1,271 @@
+#include "CollisionGrid.hpp"
+#include "TileMap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    // floor() for the tile coordinate without the libm call
+    inline int FloorToInt(float value)
+    {
+        int truncated = static_cast<int>(value);
+        return truncated - (value < static_cast<float>(truncated) ? 1 : 0);
+    }
+
+    inline int CeilToInt(float value)
+    {
+        int truncated = static_cast<int>(value);
+        return truncated + (value > static_cast<float>(truncated) ? 1 : 0);
+    }
+}
+
+CollisionGrid::CollisionGrid()
+    : mWidth(0)
+    , mHeight(0)
+    , mWordsPerRow(0)
+{
+}
+
+void CollisionGrid::Reset(int width, int height)
+{
+    mWidth = width > 0 ? width : 0;
+    mHeight = height > 0 ? height : 0;
+    mWordsPerRow = (mWidth + 63) / 64;
+    mBits.assign(static_cast<size_t>(mWordsPerRow) * mHeight, 0);
+}
+
+void CollisionGrid::Build(const MapData& mapData)
+{
+    Reset(mapData.mapWidth, mapData.mapHeight);
+
+    for (const auto& layer : mapData.layers)
+    {
+        if (layer.name != "collision") continue;
+
+        // Tiles outside the grid are ignored by SetSolid
+        layer.ForEachTile([this](int x, int y, uint32_t) {
+            SetSolid(x, y, true);
+        });
+    }
+}
+
+void CollisionGrid::SetSolid(int x, int y, bool solid)
+{
+    if (x < 0 || x >= mWidth || y < 0 || y >= mHeight) return;
+
+    uint64_t& word = mBits[static_cast<size_t>(y) * mWordsPerRow + (x >> 6)];
+    uint64_t bit = uint64_t(1) << (x & 63);
+    word = solid ? (word | bit) : (word & ~bit);
+}
+
+bool CollisionGrid::IsSolid(int x, int y) const
+{
+    if (x < 0 || x >= mWidth || y < 0 || y >= mHeight) return true;
+
+    return (mBits[static_cast<size_t>(y) * mWordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+}
+
+bool CollisionGrid::AnySolid(int x0, int y0, int x1, int y1) const
+{
+    // Touching the outside of the map counts as a hit
+    if (x0 < 0 || y0 < 0 || x1 >= mWidth || y1 >= mHeight) return true;
+    if (x0 > x1 || y0 > y1) return false;
+
+    int firstWord = x0 >> 6;
+    int lastWord = x1 >> 6;
+    uint64_t firstMask = ~uint64_t(0) << (x0 & 63);
+    uint64_t lastMask = ~uint64_t(0) >> (63 - (x1 & 63));
+
+    uint64_t hits = 0;
+    const uint64_t* row = mBits.data() + static_cast<size_t>(y0) * mWordsPerRow;
+    for (int y = y0; y <= y1; y++, row += mWordsPerRow)
+    {
+        if (firstWord == lastWord)
+        {
+            hits |= row[firstWord] & firstMask & lastMask;
+        }
+        else
+        {
+            hits |= row[firstWord] & firstMask;
+            for (int w = firstWord + 1; w < lastWord; w++)
+            {
+                hits |= row[w];
+            }
+            hits |= row[lastWord] & lastMask;
+        }
+    }
+    return hits != 0;
+}
+
+bool CollisionGrid::OverlapsBox(const Vector2& min, const Vector2& max, float tileSize) const
+{
+    float invTileSize = 1.0f / tileSize;
+    return AnySolid(FloorToInt(min.x * invTileSize), FloorToInt(min.y * invTileSize),
+                    FloorToInt(max.x * invTileSize), FloorToInt(max.y * invTileSize));
+}
+
+bool CollisionGrid::SweepBox(const Vector2& min, const Vector2& max, const Vector2& delta, float tileSize, SweepHit& hit) const
+{
+    // Work in tile units; the box covers tiles [floor(min), ceil(max) - 1]
+    float invTileSize = 1.0f / tileSize;
+    float minX = min.x * invTileSize;
+    float minY = min.y * invTileSize;
+    float maxX = max.x * invTileSize;
+    float maxY = max.y * invTileSize;
+    float dx = delta.x * invTileSize;
+    float dy = delta.y * invTileSize;
+
+    const float never = 2.0f;  // Any time past the end of the motion
+    int stepX = (dx > 0.0f) - (dx < 0.0f);
+    int stepY = (dy > 0.0f) - (dy < 0.0f);
+
+    // Time at which the leading edge enters the next column/row, and the time
+    // it takes to cross one more
+    int column = 0;
+    float nextX = never;
+    float stepTimeX = never;
+    if (stepX > 0)
+    {
+        column = CeilToInt(maxX) - 1;
+        nextX = (static_cast<float>(column + 1) - maxX) / dx;
+        stepTimeX = 1.0f / dx;
+    }
+    else if (stepX < 0)
+    {
+        column = FloorToInt(minX);
+        nextX = (minX - static_cast<float>(column)) / -dx;
+        stepTimeX = 1.0f / -dx;
+    }
+
+    int row = 0;
+    float nextY = never;
+    float stepTimeY = never;
+    if (stepY > 0)
+    {
+        row = CeilToInt(maxY) - 1;
+        nextY = (static_cast<float>(row + 1) - maxY) / dy;
+        stepTimeY = 1.0f / dy;
+    }
+    else if (stepY < 0)
+    {
+        row = FloorToInt(minY);
+        nextY = (minY - static_cast<float>(row)) / -dy;
+        stepTimeY = 1.0f / -dy;
+    }
+
+    // Each event brings one new column or row under the box; only that
+    // strip, at the box's position at that moment, needs testing
+    while (nextX <= 1.0f || nextY <= 1.0f)
+    {
+        if (nextX == nextY)
+        {
+            // A column and a row at the same instant: the box enters the new
+            // column, the new row and, through its leading corner, the
+            // diagonal tile between them, which neither strip covers
+            float t = nextX;
+            column += stepX;
+            row += stepY;
+            int rowLo = FloorToInt(minY + dy * t);
+            int rowHi = CeilToInt(maxY + dy * t) - 1;
+            int columnLo = FloorToInt(minX + dx * t);
+            int columnHi = CeilToInt(maxX + dx * t) - 1;
+            bool hitX = AnySolid(column, rowLo, column, rowHi);
+            bool hitY = AnySolid(columnLo, row, columnHi, row);
+            if (hitX || hitY || IsSolid(column, row))
+            {
+                // Corner only: block the axis with the larger motion, so the
+                // mover slides along the other one
+                if (!hitX && !hitY)
+                {
+                    hitX = std::abs(dx) >= std::abs(dy);
+                }
+                hit.time = t;
+                hit.normal = hitX ? Vector2(static_cast<float>(-stepX), 0.0f)
+                                  : Vector2(0.0f, static_cast<float>(-stepY));
+                return true;
+            }
+            nextX += stepTimeX;
+            nextY += stepTimeY;
+        }
+        else if (nextX < nextY)
+        {
+            float t = nextX;
+            column += stepX;
+            int rowLo = FloorToInt(minY + dy * t);
+            int rowHi = CeilToInt(maxY + dy * t) - 1;
+            if (AnySolid(column, rowLo, column, rowHi))
+            {
+                hit.time = t;
+                hit.normal = Vector2(static_cast<float>(-stepX), 0.0f);
+                return true;
+            }
+            nextX += stepTimeX;
+        }
+        else
+        {
+            float t = nextY;
+            row += stepY;
+            int columnLo = FloorToInt(minX + dx * t);
+            int columnHi = CeilToInt(maxX + dx * t) - 1;
+            if (AnySolid(columnLo, row, columnHi, row))
+            {
+                hit.time = t;
+                hit.normal = Vector2(0.0f, static_cast<float>(-stepY));
+                return true;
+            }
+            nextY += stepTimeY;
+        }
+    }
+
+    return false;
+}
+
+bool CollisionGrid::IsLineClear(int x0, int y0, int x1, int y1) const
+{
+    // Same row or column: only the span between the ends matters
+    if (y0 == y1)
+    {
+        return std::abs(x1 - x0) <= 1 || !AnySolid(std::min(x0, x1) + 1, y0, std::max(x0, x1) - 1, y0);
+    }
+    if (x0 == x1)
+    {
+        return std::abs(y1 - y0) <= 1 || !AnySolid(x0, std::min(y0, y1) + 1, x0, std::max(y0, y1) - 1);
+    }
+
+    const int nx = std::abs(x1 - x0);
+    const int ny = std::abs(y1 - y0);
+    const int sx = x1 > x0 ? 1 : -1;
+    const int sy = y1 > y0 ? 1 : -1;
+
+    int x = x0;
+    int y = y0;
+    for (int ix = 0, iy = 0; ix < nx || iy < ny;)
+    {
+        // Sign tells whether the line crosses the next vertical or horizontal tile edge first
+        int64_t decision = static_cast<int64_t>(1 + 2 * ix) * ny - static_cast<int64_t>(1 + 2 * iy) * nx;
+        if (decision == 0)
+        {
+            if (IsSolid(x + sx, y) || IsSolid(x, y + sy)) return false;
+
+            x += sx;
+            y += sy;
+            ix++;
+            iy++;
+        }
+        else if (decision < 0)
+        {
+            x += sx;
+            ix++;
+        }
+        else
+        {
+            y += sy;
+            iy++;
+        }
+
+        if ((x != x1 || y != y1) && IsSolid(x, y)) return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "../MathUtils.h"
+
+struct MapData;
+
+// First contact of a swept box
+struct SweepHit
+{
+    float time;      // Fraction of the motion travelled before contact [0, 1]
+    Vector2 normal;  // Axis-aligned, pointing out of the solid tile
+};
+
+// Solid/free state of every tile packed into a bitset (1 bit per tile).
+// Each row starts on a fresh 64-bit word, so an AABB test is a couple of
+// masked word loads per covered row instead of a lookup per tile.
+// Tiles outside the grid count as solid.
+class CollisionGrid
+{
+public:
+    CollisionGrid();
+
+    // Clears the grid to width x height free tiles
+    void Reset(int width, int height);
+    // Compiles the "collision" layers of a Tiled map (any non-empty tile is solid)
+    void Build(const MapData& mapData);
+
+    void SetSolid(int x, int y, bool solid);
+    bool IsSolid(int x, int y) const;
+
+    // True if any tile in the inclusive tile range [x0, x1] x [y0, y1] is solid
+    bool AnySolid(int x0, int y0, int x1, int y1) const;
+    // Same for a world-space box (pixels)
+    bool OverlapsBox(const Vector2& min, const Vector2& max, float tileSize) const;
+
+    // Moves the world-space box [min, max) by delta and reports the first solid
+    // tile its leading edges enter. Walks the crossed tile boundaries in time
+    // order (DDA), so the cost follows the tiles crossed, not the speed.
+    // Tiles the box already overlaps at the start are ignored, so an actor
+    // embedded in a wall can still move out of it. Crossing a row and a
+    // column at once also tests the diagonal tile, so corners do not leak.
+    bool SweepBox(const Vector2& min, const Vector2& max, const Vector2& delta, float tileSize, SweepHit& hit) const;
+
+    // True if the line between the centers of tiles (x0, y0) and (x1, y1)
+    // crosses no solid tile (the end tiles themselves are not tested). Walks
+    // every tile the line touches; passing exactly through a corner needs
+    // both tiles beside it open. Straight lines are one masked span scan.
+    bool IsLineClear(int x0, int y0, int x1, int y1) const;
+
+    int GetWidth() const { return mWidth; }
+    int GetHeight() const { return mHeight; }
+
+private:
+    int mWidth;
+    int mHeight;
+    int mWordsPerRow;
+    std::vector<uint64_t> mBits;
+};
@@ -9,9 +9,110 @@
 #include <SDL.h>
 #include <algorithm>
 #include <cctype>
+#include <climits>
+#include <cmath>
 #include <glm/glm.hpp>
 using json = nlohmann::json;
 
+namespace
+{
+    const uint32_t TILED_FLIP_FLAGS = 0xE0000000;  // Horizontal, vertical, diagonal
+
+    // A rectangle of one tile layer as stored in the JSON (the whole layer,
+    // or one chunk of an infinite map); x/y in Tiled's tile coordinates.
+    // The gids stay in the JSON until the block is cut into chunks.
+    struct TileBlock
+    {
+        int x;
+        int y;
+        int width;
+        int height;
+        const json* data;  // CSV array or base64 string, owned by the parsed document
+    };
+
+    struct TileLayer
+    {
+        std::string name;
+        std::vector<TileBlock> blocks;
+    };
+
+    TileBlock ReadTileBlock(const json& source, int x, int y)
+    {
+        TileBlock block;
+        block.x = x;
+        block.y = y;
+        block.width = source.value("width", 0);
+        block.height = source.value("height", 0);
+        block.data = &source.at("data");
+        return block;
+    }
+
+    // Decodes a block's gids (done once per block, just before cutting it up);
+    // padded with empty tiles if the data is short
+    std::vector<uint32_t> ReadGids(const TileBlock& block)
+    {
+        std::vector<uint32_t> gids;
+        if (block.data->is_string())
+        {
+            gids = DecodeTiledBase64(block.data->get_ref<const std::string&>());
+        }
+        else
+        {
+            gids.reserve(block.data->size());
+            for (const auto& gid : *block.data)
+            {
+                gids.push_back(gid.get<uint32_t>());
+            }
+        }
+        gids.resize(static_cast<size_t>(std::max(block.width, 0)) * std::max(block.height, 0), 0);
+        return gids;
+    }
+
+    // Layers the game reads, not draws
+    bool IsGameplayLayer(const std::string& name)
+    {
+        return name == "collision" || name.find("gerador_") == 0;
+    }
+
+    int FloorDiv(int value, int divisor)
+    {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+
+    // Calls f(chunkX, chunkY, x0, y0, x1, y1) for the part of the rectangle
+    // at map tile (x, y) inside each chunk it overlaps ([x0, x1) x [y0, y1))
+    template <typename F>
+    void ForEachChunkRect(int x, int y, int width, int height, F&& f)
+    {
+        const int chunkSize = ChunkStreamer::CHUNK_SIZE;
+        if (width <= 0 || height <= 0) return;
+
+        for (int chunkY = FloorDiv(y, chunkSize); chunkY <= FloorDiv(y + height - 1, chunkSize); chunkY++)
+        {
+            for (int chunkX = FloorDiv(x, chunkSize); chunkX <= FloorDiv(x + width - 1, chunkSize); chunkX++)
+            {
+                f(chunkX, chunkY,
+                  std::max(x, chunkX * chunkSize), std::max(y, chunkY * chunkSize),
+                  std::min(x + width, (chunkX + 1) * chunkSize), std::min(y + height, (chunkY + 1) * chunkSize));
+            }
+        }
+    }
+}
+
+void Layer::AddTiles(int x, int y, int rectWidth, int rectHeight, const std::vector<uint32_t>& gids)
+{
+    ForEachChunkRect(x, y, rectWidth, rectHeight, [&](int, int, int x0, int y0, int x1, int y1) {
+        LayerPiece piece;
+        piece.x = x0;
+        piece.y = y0;
+        const uint32_t* source = gids.data() + static_cast<size_t>(y0 - y) * rectWidth + (x0 - x);
+        if (piece.tiles.Pack(source, x1 - x0, y1 - y0, static_cast<size_t>(rectWidth)))
+        {
+            pieces.push_back(std::move(piece));
+        }
+    });
+}
+
 TileMap::TileMap(int width, int height, int tileSize)
     : mWidth(width)
     , mHeight(height)
@@ -91,6 +192,16 @@ void TileMap::GenerateMap()
             }
         }
     }
+
+    mCollision.Reset(mWidth, mHeight);
+    for (int y = 0; y < mHeight; y++)
+    {
+        for (int x = 0; x < mWidth; x++)
+        {
+            mCollision.SetSolid(x, y, !mTiles[y][x].walkable);
+        }
+    }
+    mCollisionVersion++;
 }
 
 bool TileMap::LoadFromJSON(const std::string& jsonPath)
@@ -113,20 +224,6 @@ bool TileMap::LoadFromJSON(const std::string& jsonPath)
         mMapData->tileWidth = j["tilewidth"];
         mMapData->tileHeight = j["tileheight"];
         
-        // Update TileMap dimensions to match loaded map
-        mWidth = mMapData->mapWidth;
-        mHeight = mMapData->mapHeight;
-        
-        // Resize mTiles to avoid crashes in IsWalkable
-        mTiles.resize(mHeight);
-        for (auto& row : mTiles) {
-            row.resize(mWidth);
-            // Initialize with default
-            for (auto& tile : row) {
-                tile = CreateTile(TileType::Floor);
-            }
-        }
-        
         // Load tilesets
         for (const auto& tsJson : j["tilesets"])
         {
@@ -187,26 +284,138 @@ bool TileMap::LoadFromJSON(const std::string& jsonPath)
             mMapData->tilesets.push_back(std::move(ts));
         }
         
-        // Load layers
+        // Tile layers come as one block (finite maps) or as a list of Tiled
+        // chunks (infinite maps); collect the blocks first to find the bounds
+        std::vector<TileLayer> tileLayers;
         for (const auto& layerJson : j["layers"])
         {
-            Layer layer;
+            if (layerJson.value("type", "") != "tilelayer") continue;
+
+            TileLayer layer;
             layer.name = layerJson["name"];
-            layer.width = layerJson["width"];
-            layer.height = layerJson["height"];
-            
-            std::string typeStr = layerJson["type"];
-            if (typeStr == "tilelayer" && layerJson.contains("data"))
+
+            // Compressed data would need zlib/zstd, which the game does not link
+            std::string compression = layerJson.value("compression", "");
+            if (!compression.empty())
             {
-                for (int gid : layerJson["data"])
+                std::cerr << "Skipping layer '" << layer.name << "': " << compression
+                          << " compression is not supported, save it uncompressed" << std::endl;
+                continue;
+            }
+
+            if (layerJson.contains("chunks"))
+            {
+                for (const auto& chunkJson : layerJson["chunks"])
                 {
-                    layer.data.push_back(gid);
+                    layer.blocks.push_back(ReadTileBlock(chunkJson, chunkJson["x"], chunkJson["y"]));
                 }
             }
-            
-            mMapData->layers.push_back(layer);
+            else if (layerJson.contains("data"))
+            {
+                layer.blocks.push_back(ReadTileBlock(layerJson, 0, 0));
+            }
+
+            tileLayers.push_back(std::move(layer));
         }
+
+        // Infinite maps may start at negative tiles: shift them so the world
+        // starts at (0, 0) like a finite map
+        mMapData->infinite = j.value("infinite", false);
+        if (mMapData->infinite)
+        {
+            int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+            for (const auto& layer : tileLayers)
+            {
+                for (const auto& block : layer.blocks)
+                {
+                    minX = std::min(minX, block.x);
+                    minY = std::min(minY, block.y);
+                    maxX = std::max(maxX, block.x + block.width);
+                    maxY = std::max(maxY, block.y + block.height);
+                }
+            }
+            if (minX > maxX)
+            {
+                minX = minY = maxX = maxY = 0;
+            }
+            mMapData->originX = minX;
+            mMapData->originY = minY;
+            mMapData->mapWidth = maxX - minX;
+            mMapData->mapHeight = maxY - minY;
+        }
+
+        // Update TileMap dimensions to match loaded map
+        mWidth = mMapData->mapWidth;
+        mHeight = mMapData->mapHeight;
         
+        // Tiled maps have no procedural tiles: walkability comes from the
+        // collision grid, and every tile reads as Floor
+        mTiles.clear();
+
+        // Every block is decoded once and cut into packed per-chunk pieces; the
+        // JSON is dropped after loading. Visual layers go to the streamer,
+        // which expands a chunk's pieces when it comes into view; gameplay
+        // layers (collision, item spawners) keep theirs in MapData.
+        const int chunkSize = ChunkStreamer::CHUNK_SIZE;
+        int visualLayerCount = 0;
+        for (const auto& layer : tileLayers)
+        {
+            if (!IsGameplayLayer(layer.name)) visualLayerCount++;
+        }
+        mChunks = std::make_unique<ChunkStreamer>((mWidth + chunkSize - 1) / chunkSize,
+                                                  (mHeight + chunkSize - 1) / chunkSize,
+                                                  visualLayerCount);
+
+        int visualLayer = 0;
+        for (const auto& tileLayer : tileLayers)
+        {
+            bool gameplay = IsGameplayLayer(tileLayer.name);
+            Layer layer;
+            layer.name = tileLayer.name;
+            layer.width = mWidth;
+            layer.height = mHeight;
+
+            for (const auto& block : tileLayer.blocks)
+            {
+                int blockX = block.x - mMapData->originX;
+                int blockY = block.y - mMapData->originY;
+                std::vector<uint32_t> gids = ReadGids(block);
+
+                if (gameplay)
+                {
+                    layer.AddTiles(blockX, blockY, block.width, block.height, gids);
+                    continue;
+                }
+
+                // One piece per chunk the block overlaps, skipped if it is all empty
+                ForEachChunkRect(blockX, blockY, block.width, block.height,
+                    [&](int chunkX, int chunkY, int x0, int y0, int x1, int y1) {
+                        ChunkPiece piece;
+                        piece.layer = visualLayer;
+                        piece.offsetX = x0 - chunkX * chunkSize;
+                        piece.offsetY = y0 - chunkY * chunkSize;
+                        const uint32_t* source = gids.data() + static_cast<size_t>(y0 - blockY) * block.width + (x0 - blockX);
+                        if (piece.tiles.Pack(source, x1 - x0, y1 - y0, static_cast<size_t>(block.width)))
+                        {
+                            mChunks->AddPiece(chunkX, chunkY, std::move(piece));
+                        }
+                    });
+            }
+
+            if (gameplay)
+            {
+                mMapData->layers.push_back(std::move(layer));
+            }
+            else
+            {
+                visualLayer++;
+            }
+        }
+
+        // Compile the collision layers once instead of scanning them per query
+        mCollision.Build(*mMapData);
+        mCollisionVersion++;
+
         // std::cout << "Successfully loaded tilemap: " << jsonPath << std::endl;
         // std::cout << "  Map size: " << mMapData->mapWidth << "x" << mMapData->mapHeight << std::endl;
         // std::cout << "  Tilesets: " << mMapData->tilesets.size() << std::endl;
@@ -226,49 +435,85 @@ void TileMap::Draw(SpriteRenderer* spriteRenderer)
     if (!spriteRenderer) return;
     
     // If we have loaded map data from Tiled, draw that instead
-    if (mMapData && !mMapData->layers.empty() && !mMapData->tilesets.empty())
+    if (mChunks && !mMapData->tilesets.empty())
     {
-        if (!mCachedMapTexture)
-        {
-            CacheMap(spriteRenderer);
-        }
+        mDrawFrame++;
+
+        // Chunks under the camera, plus a margin so walking into a new chunk
+        // finds it already decoded
+        const int chunkSize = ChunkStreamer::CHUNK_SIZE;
+        const float chunkPixels = static_cast<float>(chunkSize * mTileSize);
+        Vector2 camera = spriteRenderer->GetCameraPosition();
+        int minX = static_cast<int>(std::floor(camera.x / chunkPixels));
+        int minY = static_cast<int>(std::floor(camera.y / chunkPixels));
+        int maxX = static_cast<int>(std::floor((camera.x + spriteRenderer->GetWindowWidth()) / chunkPixels));
+        int maxY = static_cast<int>(std::floor((camera.y + spriteRenderer->GetWindowHeight()) / chunkPixels));
+        mChunks->Request(minX - 1, minY - 1, maxX + 1, maxY + 1, mDrawFrame);
 
-        if (mCachedMapTexture)
+        int bakes = 0;
+        for (int chunkY = minY; chunkY <= maxY; chunkY++)
         {
-            // Draw the cached map texture
-            // Note: We need to flip vertically because rendering to FBO results in inverted Y axis
-            // relative to our top-left origin coordinate system when drawn as a texture
-            spriteRenderer->DrawSprite(
-                mCachedMapTexture.get(),
-                Vector2(0, 0),
-                Vector2(mCachedMapTexture->GetWidth(), mCachedMapTexture->GetHeight()),
-                Vector2(0.0f, 0.0f),
-                Vector2(1.0f, 1.0f),
-                0.0f,
-                Vector3(1.0f, 1.0f, 1.0f),
-                false,
-                true // Flip vertical
-            );
+            for (int chunkX = minX; chunkX <= maxX; chunkX++)
+            {
+                ChunkStreamer::Chunk* chunk = mChunks->GetChunk(chunkX, chunkY);
+                if (!chunk || chunk->pieces.empty()) continue;
+
+                // Tall tiles (trees) hang over their chunk, so a bake waits for
+                // the neighbours' tiles too; only a few bakes per frame
+                if (!chunk->texture && chunk->tiles && bakes < MAX_CHUNK_BAKES_PER_FRAME &&
+                    NeighboursDecoded(chunkX, chunkY))
+                {
+                    BakeChunk(spriteRenderer, chunkX, chunkY);
+                    bakes++;
+                }
+
+                if (chunk->texture)
+                {
+                    // Note: We need to flip vertically because rendering to FBO results in inverted Y axis
+                    // relative to our top-left origin coordinate system when drawn as a texture
+                    spriteRenderer->DrawSprite(
+                        chunk->texture.get(),
+                        Vector2(chunkX * chunkPixels, chunkY * chunkPixels),
+                        Vector2(chunk->texture->GetWidth(), chunk->texture->GetHeight()),
+                        Vector2(0.0f, 0.0f),
+                        Vector2(1.0f, 1.0f),
+                        0.0f,
+                        Vector3(1.0f, 1.0f, 1.0f),
+                        false,
+                        true // Flip vertical
+                    );
+                }
+            }
         }
+
+        mChunks->Trim(mDrawFrame);
         return;
     }
     
     // Otherwise, do not draw procedural tilemap (no textures)
 }
 
-void TileMap::CacheMap(SpriteRenderer* spriteRenderer)
+bool TileMap::NeighboursDecoded(int chunkX, int chunkY)
 {
-    if (!mMapData) return;
-
-    int width = mMapData->mapWidth * mTileSize;
-    int height = mMapData->mapHeight * mTileSize;
-    
-    // Create texture if needed
-    if (!mCachedMapTexture)
+    for (int y = chunkY - 1; y <= chunkY + 1; y++)
     {
-        mCachedMapTexture = std::make_unique<Texture>();
-        mCachedMapTexture->CreateForRendering(width, height, GL_RGBA);
+        for (int x = chunkX - 1; x <= chunkX + 1; x++)
+        {
+            ChunkStreamer::Chunk* chunk = mChunks->GetChunk(x, y);
+            if (chunk && !chunk->pieces.empty() && !chunk->tiles) return false;
+        }
     }
+    return true;
+}
+
+void TileMap::BakeChunk(SpriteRenderer* spriteRenderer, int chunkX, int chunkY)
+{
+    const int chunkSize = ChunkStreamer::CHUNK_SIZE;
+    int width = chunkSize * mTileSize;
+    int height = chunkSize * mTileSize;
+
+    auto texture = std::make_unique<Texture>();
+    texture->CreateForRendering(width, height, GL_RGBA);
     
     // Create FBO if needed
     if (mMapFBO == 0)
@@ -285,10 +530,11 @@ void TileMap::CacheMap(SpriteRenderer* spriteRenderer)
     
     float prevWidth = spriteRenderer->GetWindowWidth();
     float prevHeight = spriteRenderer->GetWindowHeight();
+    Vector2 prevCamera = spriteRenderer->GetCameraPosition();
     
     // Setup FBO
     glBindFramebuffer(GL_FRAMEBUFFER, mMapFBO);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mCachedMapTexture->GetTextureID(), 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->GetTextureID(), 0);
     
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
     {
@@ -302,153 +548,167 @@ void TileMap::CacheMap(SpriteRenderer* spriteRenderer)
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f); // Transparent background
     glClear(GL_COLOR_BUFFER_BIT);
     
-    // Set projection to match map size
+    // Set projection to the chunk, with the chunk's top-left as the origin
     spriteRenderer->SetProjection(width, height);
+    spriteRenderer->SetCameraPosition(Vector2(chunkX * width, chunkY * height));
     
-    static bool debugPrinted = false;
-    if (!debugPrinted)
+    // Layer by layer, in row order over the chunk and its neighbours: the
+    // chunk's own tiles, plus neighbouring tiles that are bigger than a map
+    // tile or offset and so reach into this chunk. Same order as drawing the
+    // whole map at once, so overlaps match.
+    for (int layer = 0; layer < static_cast<int>(mChunks->GetChunk(chunkX, chunkY)->tiles->layers.size()); layer++)
     {
-        // std::cout << "Caching Tiled map to texture (" << width << "x" << height << ")" << std::endl;
-        debugPrinted = true;
-    }
-    
-    // Draw each layer
-    for (const auto& layer : mMapData->layers)
-    {
-        if (layer.data.empty()) continue;
-        
-        // Skip special layers
-        if (layer.name == "collision" || layer.name.find("gerador_") == 0)
-            continue;
-        
-        // Draw each tile in the layer
-        for (int y = 0; y < layer.height; y++)
+        for (int y = -chunkSize; y < 2 * chunkSize; y++)
         {
-            for (int x = 0; x < layer.width; x++)
+            for (int x = -chunkSize; x < 2 * chunkSize; x++)
             {
-                int index = y * layer.width + x;
-                if (index >= layer.data.size()) continue;
-                
-                int gid = layer.data[index];
+                bool inside = x >= 0 && x < chunkSize && y >= 0 && y < chunkSize;
+                int neighbourX = chunkX + (x < 0 ? -1 : (x >= chunkSize ? 1 : 0));
+                int neighbourY = chunkY + (y < 0 ? -1 : (y >= chunkSize ? 1 : 0));
+                ChunkStreamer::Chunk* neighbour = mChunks->GetChunk(neighbourX, neighbourY);
+                if (!neighbour || !neighbour->tiles) continue;
+
+                int localX = x - (neighbourX - chunkX) * chunkSize;
+                int localY = y - (neighbourY - chunkY) * chunkSize;
+                uint32_t gid = neighbour->tiles->layers[layer][localY * chunkSize + localX];
                 if (gid == 0) continue; // 0 = empty tile
-                
-                // Extract flip flags from GID (Tiled format)
-                const unsigned FLIPPED_HORIZONTALLY_FLAG = 0x80000000;
-                const unsigned FLIPPED_VERTICALLY_FLAG   = 0x40000000;
-                const unsigned FLIPPED_DIAGONALLY_FLAG   = 0x20000000;
-                
-                bool flippedHorizontally = (gid & FLIPPED_HORIZONTALLY_FLAG);
-                bool flippedVertically = (gid & FLIPPED_VERTICALLY_FLAG);
-                bool flippedDiagonally = (gid & FLIPPED_DIAGONALLY_FLAG);
-                
-                // Clear the flags to get the actual tile ID
-                gid &= ~(FLIPPED_HORIZONTALLY_FLAG | FLIPPED_VERTICALLY_FLAG | FLIPPED_DIAGONALLY_FLAG);
-                
-                // Find the tileset that contains this GID
-                TilesetInfo* tileset = nullptr;
-                for (auto& ts : mMapData->tilesets)
-                {
-                    if (gid >= ts.firstGid && gid < ts.firstGid + ts.tileCount)
-                    {
-                        tileset = &ts;
-                        break;
-                    }
-                }
-                
-                if (!tileset || !tileset->texture) continue;
-                
-                // Calculate local tile ID within the tileset
-                int localId = gid - tileset->firstGid;
-                
-                // Calculate source position in the tileset (in pixels)
-                int tileCol = localId % tileset->columns;
-                int tileRow = localId / tileset->columns;
-                
-                float srcX = tileCol * tileset->tileWidth;
-                float srcY = tileRow * tileset->tileHeight;
-                
-                // Get texture dimensions to normalize coordinates
-                int texWidth = tileset->texture->GetWidth();
-                int texHeight = tileset->texture->GetHeight();
-                
-                // Normalize to 0.0-1.0 range for shader
-                float normalizedSrcX = srcX / static_cast<float>(texWidth);
-                float normalizedSrcY = srcY / static_cast<float>(texHeight);
-                float normalizedWidth = tileset->tileWidth / static_cast<float>(texWidth);
-                float normalizedHeight = tileset->tileHeight / static_cast<float>(texHeight);
-                
-                // Calculate destination position on screen
-                // In Tiled: (x, y) is the grid cell position, with (0,0) at top-left
-                float destX = x * mTileSize;
-                float destY = y * mTileSize;
-                
-                // Calculate display size based on the tileset's tile size
-                float scaleFactorX = static_cast<float>(tileset->tileWidth) / static_cast<float>(mMapData->tileWidth);
-                float scaleFactorY = static_cast<float>(tileset->tileHeight) / static_cast<float>(mMapData->tileHeight);
-                
-                // Display size in screen pixels
-                float displayWidth = mTileSize * scaleFactorX;
-                float displayHeight = mTileSize * scaleFactorY;
-                
-                // Offset scale for converting Tiled pixels to display pixels
-                float offsetScale = mTileSize / 16.0f;
-                
-                // Apply offsets from Tiled editor
-                destX += tileset->offsetX * offsetScale;
-                destY -= tileset->offsetY * offsetScale;
-                
-                // Handle Tiled's flip flags
-                float rotation = 0.0f;
-                bool flipH = flippedHorizontally;
-                bool flipV = flippedVertically;
-                
-                if (flippedDiagonally)
-                {
-                    rotation = glm::radians(90.0f);
-                    if (flippedHorizontally && flippedVertically)
-                    {
-                        rotation = glm::radians(270.0f);
-                        flipH = false;
-                    }
-                    else if (flippedVertically)
-                    {
-                        rotation = glm::radians(270.0f);
-                        flipH = false;
-                        flipV = false;
-                    }
-                    else if (flippedHorizontally)
-                    {
-                        flipH = false;
-                        flipV = false;
-                    }
-                }
-                else if (flippedHorizontally && flippedVertically)
-                {
-                    rotation = glm::radians(180.0f);
-                    flipH = false;
-                    flipV = false;
-                }
-                
-                // Draw the tile
-                spriteRenderer->DrawSprite(
-                    tileset->texture.get(),
-                    Vector2(destX, destY),
-                    Vector2(displayWidth, displayHeight),
-                    Vector2(normalizedSrcX, normalizedSrcY),
-                    Vector2(normalizedWidth, normalizedHeight),
-                    rotation,
-                    Vector3(1.0f, 1.0f, 1.0f),
-                    flipH,
-                    flipV
-                );
+                if (!inside && !Overhangs(gid)) continue;
+
+                DrawTile(spriteRenderer, gid,
+                         static_cast<float>((chunkX * chunkSize + x) * mTileSize),
+                         static_cast<float>((chunkY * chunkSize + y) * mTileSize));
             }
         }
     }
     
     // Restore state
+    spriteRenderer->SetCameraPosition(prevCamera);
     spriteRenderer->SetProjection(prevWidth, prevHeight);
     glBindFramebuffer(GL_FRAMEBUFFER, prevFBO);
     glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+
+    mChunks->SetTexture(*mChunks->GetChunk(chunkX, chunkY), std::move(texture));
+}
+
+const TilesetInfo* TileMap::FindTileset(uint32_t gid) const
+{
+    gid &= ~TILED_FLIP_FLAGS;
+    for (const auto& ts : mMapData->tilesets)
+    {
+        if (gid >= static_cast<uint32_t>(ts.firstGid) && gid < static_cast<uint32_t>(ts.firstGid + ts.tileCount))
+        {
+            return &ts;
+        }
+    }
+    return nullptr;
+}
+
+bool TileMap::Overhangs(uint32_t gid) const
+{
+    const TilesetInfo* tileset = FindTileset(gid);
+    if (!tileset) return false;
+
+    return tileset->tileWidth > mMapData->tileWidth || tileset->tileHeight > mMapData->tileHeight ||
+           tileset->offsetX != 0 || tileset->offsetY != 0;
+}
+
+void TileMap::DrawTile(SpriteRenderer* spriteRenderer, uint32_t gid, float destX, float destY)
+{
+    // Extract flip flags from GID (Tiled format)
+    const unsigned FLIPPED_HORIZONTALLY_FLAG = 0x80000000;
+    const unsigned FLIPPED_VERTICALLY_FLAG   = 0x40000000;
+    const unsigned FLIPPED_DIAGONALLY_FLAG   = 0x20000000;
+    
+    bool flippedHorizontally = (gid & FLIPPED_HORIZONTALLY_FLAG);
+    bool flippedVertically = (gid & FLIPPED_VERTICALLY_FLAG);
+    bool flippedDiagonally = (gid & FLIPPED_DIAGONALLY_FLAG);
+    
+    // Clear the flags to get the actual tile ID
+    gid &= ~(FLIPPED_HORIZONTALLY_FLAG | FLIPPED_VERTICALLY_FLAG | FLIPPED_DIAGONALLY_FLAG);
+    
+    // Find the tileset that contains this GID
+    const TilesetInfo* tileset = FindTileset(gid);
+    if (!tileset || !tileset->texture) return;
+    
+    // Calculate local tile ID within the tileset
+    int localId = gid - tileset->firstGid;
+    
+    // Calculate source position in the tileset (in pixels)
+    int tileCol = localId % tileset->columns;
+    int tileRow = localId / tileset->columns;
+    
+    float srcX = tileCol * tileset->tileWidth;
+    float srcY = tileRow * tileset->tileHeight;
+    
+    // Get texture dimensions to normalize coordinates
+    int texWidth = tileset->texture->GetWidth();
+    int texHeight = tileset->texture->GetHeight();
+    
+    // Normalize to 0.0-1.0 range for shader
+    float normalizedSrcX = srcX / static_cast<float>(texWidth);
+    float normalizedSrcY = srcY / static_cast<float>(texHeight);
+    float normalizedWidth = tileset->tileWidth / static_cast<float>(texWidth);
+    float normalizedHeight = tileset->tileHeight / static_cast<float>(texHeight);
+    
+    // Calculate display size based on the tileset's tile size
+    float scaleFactorX = static_cast<float>(tileset->tileWidth) / static_cast<float>(mMapData->tileWidth);
+    float scaleFactorY = static_cast<float>(tileset->tileHeight) / static_cast<float>(mMapData->tileHeight);
+    
+    // Display size in screen pixels
+    float displayWidth = mTileSize * scaleFactorX;
+    float displayHeight = mTileSize * scaleFactorY;
+    
+    // Offset scale for converting Tiled pixels to display pixels
+    float offsetScale = mTileSize / 16.0f;
+    
+    // Apply offsets from Tiled editor
+    destX += tileset->offsetX * offsetScale;
+    destY -= tileset->offsetY * offsetScale;
+    
+    // Handle Tiled's flip flags
+    float rotation = 0.0f;
+    bool flipH = flippedHorizontally;
+    bool flipV = flippedVertically;
+    
+    if (flippedDiagonally)
+    {
+        rotation = glm::radians(90.0f);
+        if (flippedHorizontally && flippedVertically)
+        {
+            rotation = glm::radians(270.0f);
+            flipH = false;
+        }
+        else if (flippedVertically)
+        {
+            rotation = glm::radians(270.0f);
+            flipH = false;
+            flipV = false;
+        }
+        else if (flippedHorizontally)
+        {
+            flipH = false;
+            flipV = false;
+        }
+    }
+    else if (flippedHorizontally && flippedVertically)
+    {
+        rotation = glm::radians(180.0f);
+        flipH = false;
+        flipV = false;
+    }
+    
+    // Draw the tile
+    spriteRenderer->DrawSprite(
+        tileset->texture.get(),
+        Vector2(destX, destY),
+        Vector2(displayWidth, displayHeight),
+        Vector2(normalizedSrcX, normalizedSrcY),
+        Vector2(normalizedWidth, normalizedHeight),
+        rotation,
+        Vector3(1.0f, 1.0f, 1.0f),
+        flipH,
+        flipV
+    );
 }
 
 bool TileMap::IsWalkable(const Vector2& position) const
@@ -459,7 +719,7 @@ bool TileMap::IsWalkable(const Vector2& position) const
     if (tileX < 0 || tileX >= mWidth || tileY < 0 || tileY >= mHeight)
         return false;
 
-    return mTiles[tileY][tileX].walkable;
+    return !mCollision.IsSolid(tileX, tileY);
 }
 
 TileType TileMap::GetTileAt(const Vector2& position) const
@@ -467,7 +727,7 @@ TileType TileMap::GetTileAt(const Vector2& position) const
     int tileX = static_cast<int>(position.x) / mTileSize;
     int tileY = static_cast<int>(position.y) / mTileSize;
     
-    if (tileX < 0 || tileX >= mWidth || tileY < 0 || tileY >= mHeight)
+    if (tileX < 0 || tileX >= mWidth || tileY < 0 || tileY >= mHeight || mTiles.empty())
         return TileType::Floor;
     
     return mTiles[tileY][tileX].type;
@@ -476,50 +736,23 @@ TileType TileMap::GetTileAt(const Vector2& position) const
 
 bool TileMap::CheckCollision(const Vector2& position, float radius) const
 {
+    // Every tile under the box around the position (outside the map counts
+    // as solid): the same box the movement sweep collides
+    Vector2 min(position.x - radius, position.y - radius);
+    Vector2 max(position.x + radius, position.y + radius);
+    return mCollision.OverlapsBox(min, max, static_cast<float>(mTileSize));
+}
 
-    // If we have Tiled map data, check against collision tiles
-    if (mMapData && !mMapData->layers.empty())
-    {
-        // Check all four corners of the player's bounding box
-        Vector2 corners[4] = {
-            Vector2(position.x - radius, position.y - radius), // Top-left
-            Vector2(position.x + radius, position.y - radius), // Top-right
-            Vector2(position.x - radius, position.y + radius), // Bottom-left
-            Vector2(position.x + radius, position.y + radius)  // Bottom-right
-        };
-        
+void TileMap::SetCollision(int tileX, int tileY, bool solid)
+{
+    if (tileX < 0 || tileX >= mCollision.GetWidth() || tileY < 0 || tileY >= mCollision.GetHeight()) return;
+    if (mCollision.IsSolid(tileX, tileY) == solid) return;
 
-        for (const auto& corner : corners)
-        {
-            int tileX = static_cast<int>(corner.x) / mTileSize;
-            int tileY = static_cast<int>(corner.y) / mTileSize;
-            
-            // Out of bounds = collision
-            if (tileX < 0 || tileX >= mMapData->mapWidth || tileY < 0 || tileY >= mMapData->mapHeight)
-                return true;
-            
-            // Check each layer for collision tiles
-            for (const auto& layer : mMapData->layers)
-            {
-                if (layer.data.empty()) continue;
-                
-                int index = tileY * layer.width + tileX;
-                if (index < 0 || index >= layer.data.size()) continue;
-                
-                int gid = layer.data[index];
-                if (gid == 0) continue; // Empty tile
-                
-                // Special check for collision layer
-                if (layer.name == "collision")
-                {
-                    return true;
-                }
-            }
-        }
-        
-        return false; // No collision
-    }
-    
-    // Fallback to simple tile checking
-    return !IsWalkable(position);
+    mCollision.SetSolid(tileX, tileY, solid);
+    mCollisionVersion++;
+}
+
+bool TileMap::SweepBox(const Vector2& position, const Vector2& halfSize, const Vector2& delta, SweepHit& hit) const
+{
+    return mCollision.SweepBox(position - halfSize, position + halfSize, delta, static_cast<float>(mTileSize), hit);
 }
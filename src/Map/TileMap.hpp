@@ -5,6 +5,8 @@
 #include "../MathUtils.h"
 #include "../Core/Texture/Texture.hpp"
 #include "TiledParser.hpp"
+#include "CollisionGrid.hpp"
+#include "ChunkStreamer.hpp"
 
 enum class TileType
 {
@@ -22,12 +24,40 @@ struct Tile
     int gid;  // Global tile ID from tileset (for advanced tilesets)
 };
 
-// For Tiled JSON format support
+// For Tiled JSON format support. Tiles are kept in packed rectangles of at
+// most a chunk, only where the layer has any, so a sparse layer over a huge
+// map stays small.
+struct LayerPiece {
+    int x;  // Map tile of the rectangle's top-left corner
+    int y;
+    PackedTiles tiles;
+};
+
 struct Layer {
     std::string name;
     int width;
     int height;
-    std::vector<int> data;  // GIDs for tiles
+    std::vector<LayerPiece> pieces;
+
+    // Adds the width x height gids placed at map tile (x, y), cut at chunk borders
+    void AddTiles(int x, int y, int width, int height, const std::vector<uint32_t>& gids);
+
+    // Calls f(x, y, gid) for every non-empty tile
+    template <typename F>
+    void ForEachTile(F&& f) const
+    {
+        for (const LayerPiece& piece : pieces)
+        {
+            for (int y = 0; y < piece.tiles.height; y++)
+            {
+                for (int x = 0; x < piece.tiles.width; x++)
+                {
+                    uint32_t gid = piece.tiles.At(x, y);
+                    if (gid != 0) f(piece.x + x, piece.y + y, gid);
+                }
+            }
+        }
+    }
 };
 
 struct MapData {
@@ -35,8 +65,11 @@ struct MapData {
     int mapHeight;
     int tileWidth;
     int tileHeight;
+    bool infinite = false;
+    int originX = 0;  // Tiled tile coordinate of the map's (0, 0) (infinite maps)
+    int originY = 0;
     std::vector<TilesetInfo> tilesets;
-    std::vector<Layer> layers;
+    std::vector<Layer> layers;  // Gameplay layers only (collision, gerador_*); visual ones are streamed
 };
 
 class TileMap
@@ -57,6 +90,8 @@ public:
     // Collision checking
     bool IsWalkable(const Vector2& position) const;
     bool CheckCollision(const Vector2& position, float radius) const;
+    // Continuous test for a box centered on position moving by delta
+    bool SweepBox(const Vector2& position, const Vector2& halfSize, const Vector2& delta, SweepHit& hit) const;
     TileType GetTileAt(const Vector2& position) const;
     
     // Getters
@@ -64,6 +99,12 @@ public:
     int GetHeight() const { return mHeight; }
     int GetTileSize() const { return mTileSize; }
     MapData* GetMapData() { return mMapData.get(); }
+    const CollisionGrid& GetCollisionGrid() const { return mCollision; }
+
+    // Changes a tile's collision at runtime (doors, placed blocks)
+    void SetCollision(int tileX, int tileY, bool solid);
+    // Bumped whenever the collision grid changes; lets path caches notice
+    uint32_t GetCollisionVersion() const { return mCollisionVersion; }
     
 private:
     int mWidth;
@@ -73,8 +114,20 @@ private:
     std::unique_ptr<MapData> mMapData;
     Tile CreateTile(TileType type);
 
-    // Cached rendering
-    std::unique_ptr<Texture> mCachedMapTexture;
+    // Solid tiles compiled at load time (collision layers, or unwalkable
+    // procedural tiles); CheckCollision only reads this
+    CollisionGrid mCollision;
+    uint32_t mCollisionVersion = 0;
+
+    // Streamed rendering: visual layers are decoded and baked per chunk
+    // around the camera instead of into one texture the size of the map
+    static const int MAX_CHUNK_BAKES_PER_FRAME = 2;
+    std::unique_ptr<ChunkStreamer> mChunks;
+    uint64_t mDrawFrame = 0;
     GLuint mMapFBO = 0;
-    void CacheMap(class SpriteRenderer* spriteRenderer);
+    bool NeighboursDecoded(int chunkX, int chunkY);
+    void BakeChunk(class SpriteRenderer* spriteRenderer, int chunkX, int chunkY);
+    void DrawTile(class SpriteRenderer* spriteRenderer, uint32_t gid, float destX, float destY);
+    const TilesetInfo* FindTileset(uint32_t gid) const;
+    bool Overhangs(uint32_t gid) const;  // Tile reaches outside its own cell
 };
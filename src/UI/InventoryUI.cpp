@@ -19,6 +19,8 @@ InventoryUI::InventoryUI(Game* game, Inventory* inventory)
     , mSlotColor(0.3f, 0.3f, 0.35f)
     , mSlotHoverColor(0.4f, 0.4f, 0.45f)
     , mSlotSelectedColor(0.5f, 0.6f, 0.7f)
+    , mSlotCraftableColor(0.3f, 0.42f, 0.34f)
+    , mSlotPartnerColor(0.35f, 0.6f, 0.4f)
     , mTextColor(1.0f, 1.0f, 1.0f)
 {
     // Initialize key states
@@ -56,7 +58,41 @@ void InventoryUI::Update(float deltaTime)
 {
     if (!mVisible) return;
 
-    // Update logic here if needed
+    UpdateCraftableSlots();
+}
+
+void InventoryUI::UpdateCraftableSlots()
+{
+    int slotCount = mInventory ? mInventory->GetSlotCount() : 0;
+    mSlotCraftable.assign(slotCount, 0);
+    mSlotPartner.assign(slotCount, 0);
+
+    CraftSuggestions* suggestions = mGame ? mGame->GetCraftSuggestions() : nullptr;
+    if (!suggestions || mInventory->GetUsedSlots() == 0) return;
+
+    mHeldItems.clear();
+    for (const InventorySlot& slot : mInventory->GetAllSlots())
+    {
+        if (slot.IsEmpty()) continue;
+        mHeldItems.push_back(CraftSuggestions::HeldItem{slot.item.id, slot.quantity});
+    }
+    mCraftablePairs.clear();
+    suggestions->FindCraftablePairs(mHeldItems, mCraftablePairs);
+
+    const InventorySlot* selected = mSelectedSlot >= 0 ? mInventory->GetSlot(mSelectedSlot) : nullptr;
+    for (const auto& pair : mCraftablePairs)
+    {
+        int slot1 = mInventory->FindItemSlot(pair.item1Id);
+        int slot2 = mInventory->FindItemSlot(pair.item2Id);
+        if (slot1 >= 0) mSlotCraftable[slot1] = 1;
+        if (slot2 >= 0) mSlotCraftable[slot2] = 1;
+
+        if (selected && slot1 >= 0 && slot2 >= 0)
+        {
+            if (pair.item1Id == selected->item.id) mSlotPartner[slot2] = 1;
+            if (pair.item2Id == selected->item.id) mSlotPartner[slot1] = 1;
+        }
+    }
 }
 
 void InventoryUI::Draw(TextRenderer* textRenderer, RectRenderer* rectRenderer)
@@ -99,7 +135,8 @@ void InventoryUI::HandleMouseClick(const Vector2& mousePos)
 
     int clickedSlot = GetSlotAtPosition(mousePos);
     
-    if (clickedSlot != -1 && clickedSlot < mInventory->GetUsedSlots())
+    // Emptied slots stay in the grid; only filled ones can be selected
+    if (clickedSlot != -1 && mInventory->GetSlot(clickedSlot))
     {
         mSelectedSlot = clickedSlot;
         
@@ -179,6 +216,10 @@ void InventoryUI::DrawInventorySlots(TextRenderer* textRenderer, RectRenderer* r
             slotColor = mSlotSelectedColor;
         else if (i == mHoveredSlot)
             slotColor = mSlotHoverColor;
+        else if (i < static_cast<int>(mSlotPartner.size()) && mSlotPartner[i])
+            slotColor = mSlotPartnerColor;
+        else if (i < static_cast<int>(mSlotCraftable.size()) && mSlotCraftable[i])
+            slotColor = mSlotCraftableColor;
 
         // Draw slot background
         rectRenderer->RenderRect(
@@ -191,7 +232,7 @@ void InventoryUI::DrawInventorySlots(TextRenderer* textRenderer, RectRenderer* r
         );
 
         // Draw item if slot is filled
-        if (i < mInventory->GetUsedSlots())
+        if (mInventory->GetSlot(i))
         {
             DrawItemInSlot(i, slotPos, textRenderer, rectRenderer);
         }
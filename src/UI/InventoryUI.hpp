@@ -1,8 +1,10 @@
 #pragma once
 #include "../Game/Inventory.hpp"
+#include "../Crafting/CraftSuggestions.hpp"
 #include "../MathUtils.h"
 #include <functional>
 #include <memory>
+#include <vector>
 
 // Forward declarations
 class Game;
@@ -62,8 +64,16 @@ private:
     Vector3 mSlotColor;
     Vector3 mSlotHoverColor;
     Vector3 mSlotSelectedColor;
+    Vector3 mSlotCraftableColor;  // Combines with another held item
+    Vector3 mSlotPartnerColor;    // Combines with the selected item
     Vector3 mTextColor;
 
+    // Craftable combinations among the held items, refreshed every update
+    std::vector<CraftSuggestions::HeldItem> mHeldItems;
+    std::vector<CraftSuggestions::Pair> mCraftablePairs;
+    std::vector<char> mSlotCraftable;
+    std::vector<char> mSlotPartner;
+
     // Input state
     bool mKeyPressed[10];
 
@@ -74,6 +84,7 @@ private:
     Vector2 GetSlotPosition(int slotIndex) const;
     int GetSlotAtPosition(const Vector2& mousePos) const;
     void UpdateKeyState(const uint8_t* keyState);
+    void UpdateCraftableSlots();
 
     // Callbacks
     std::function<void(int itemId)> mOnItemSelected;
@@ -5,11 +5,182 @@
 #include "Game/Game.hpp"
 #include "UI/MainMenu.h"
 #include "Core/TextRenderer/TextRenderer.hpp"
+#include "Core/Texture/Texture.hpp"
+#include "Core/Profiler/Profiler.hpp"
+#include "Core/Jobs/JobSystem.hpp"
+#include "Crafting/CraftPlanner.hpp"
 #include <SDL.h>
 #include <GL/glew.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+// Command line options
+struct LaunchOptions
+{
+    bool headless = false;
+    int ticks = 1000;
+    int items = 0;
+    int npcs = 0;
+    int simulationRate = Game::DEFAULT_SIMULATION_RATE;
+    const char* profilePrefix = nullptr;
+    int workers = -1;
+    const char* recipeGenerator = nullptr;
+    int craftPlanTarget = -1;
+    bool hotReload = true;
+};
+
+static void PrintUsage(const char* program)
+{
+    std::printf("Usage: %s [--headless] [--ticks N] [--items N] [--npcs N] [--sim-rate HZ] [--profile PREFIX] [--workers N] [--recipe-generator CMD] [--no-hot-reload] [--craft-plan ID]\n", program);
+    std::printf("  --headless     Run the simulation without a window, GPU or audio\n");
+    std::printf("  --ticks N      Number of simulation ticks to run headless (default 1000)\n");
+    std::printf("  --items N      Spawn N extra item actors on walkable tiles\n");
+    std::printf("  --npcs N       Spawn N extra aggressive patrol NPCs\n");
+    std::printf("  --sim-rate HZ  Fixed simulation rate (default %d)\n", Game::DEFAULT_SIMULATION_RATE);
+    std::printf("  --profile P    Record per-frame zones and write P.csv and P.json on exit\n");
+    std::printf("  --workers N    Worker threads for actor updates (default: one per core)\n");
+    std::printf("  --recipe-generator CMD\n");
+    std::printf("                 Helper process inventing unknown recipes (default: built-in generator)\n");
+    std::printf("  --no-hot-reload\n");
+    std::printf("                 Do not reload items and recipes when their JSON changes\n");
+    std::printf("  --craft-plan ID\n");
+    std::printf("                 Print a short way to make item ID from the base elements and exit\n");
+}
+
+static bool ParseArgs(int argc, char** argv, LaunchOptions& options)
+{
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--headless") == 0)
+            options.headless = true;
+        else if (std::strcmp(arg, "--ticks") == 0 && hasValue)
+            options.ticks = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--items") == 0 && hasValue)
+            options.items = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--npcs") == 0 && hasValue)
+            options.npcs = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--sim-rate") == 0 && hasValue)
+            options.simulationRate = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--profile") == 0 && hasValue)
+            options.profilePrefix = argv[++i];
+        else if (std::strcmp(arg, "--workers") == 0 && hasValue)
+            options.workers = std::atoi(argv[++i]);
+        else if (std::strcmp(arg, "--recipe-generator") == 0 && hasValue)
+            options.recipeGenerator = argv[++i];
+        else if (std::strcmp(arg, "--no-hot-reload") == 0)
+            options.hotReload = false;
+        else if (std::strcmp(arg, "--craft-plan") == 0 && hasValue)
+            options.craftPlanTarget = std::atoi(argv[++i]);
+        else
+            return false;
+    }
+    return true;
+}
+
+// Simulation-only run: no window, GL context, menu or audio
+static int RunHeadless(const LaunchOptions& options)
+{
+    if (SDL_Init(0) != 0) {
+        SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+    Texture::SetHeadless(true);
+
+    Game game(nullptr, nullptr);
+    game.SetSimulationRate(options.simulationRate);
+    game.SetWorkerCount(options.workers);
+    game.SetHotReload(options.hotReload);
+    if (options.recipeGenerator) {
+        game.SetRecipeGeneratorCommand(options.recipeGenerator);
+    }
+    bool success = game.Initialize();
+    if (success) {
+        game.SpawnStressActors(options.items, options.npcs);
+        Profiler::Instance().SetEnabled(options.profilePrefix != nullptr);
+        game.RunHeadless(options.ticks);
+        if (options.profilePrefix) {
+            // Only the last Profiler::MAX_FRAMES ticks are kept
+            std::string prefix = options.profilePrefix;
+            Profiler::Instance().ExportCsv(prefix + ".csv");
+            Profiler::Instance().ExportChromeTrace(prefix + ".json");
+        }
+    }
+    game.Shutdown();
+    return success ? 0 : 1;
+}
+
+// Crafting debug run: plan an item from the items no recipe makes
+static int RunCraftPlan(const LaunchOptions& options)
+{
+    Crafting crafting;
+    if (!crafting.LoadCompiled("assets/items.db", "assets/items.json", "assets/recipes.json")) {
+        if (!crafting.LoadItemsFromJson("assets/items.json") || !crafting.LoadRecipesFromJson("assets/recipes.json")) {
+            std::printf("Failed to load items and recipes\n");
+            return 1;
+        }
+    }
+
+    std::unordered_set<int> made;
+    crafting.GetRecipes().ForEach([&made](int, int, int resultId) { made.insert(resultId); });
+    std::vector<int> heldIds;
+    for (const Item& item : crafting.GetAllItems()) {
+        if (made.count(item.id) == 0) {
+            heldIds.push_back(item.id);
+        }
+    }
+
+    JobSystem jobs(options.workers);
+    CraftPlanner planner;
+    planner.SetJobSystem(&jobs);
+    planner.Sync(crafting);
+
+    const Item* target = crafting.FindItemById(options.craftPlanTarget);
+    if (!target) {
+        std::printf("No item with id %d\n", options.craftPlanTarget);
+        return 1;
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    CraftPlanner::Plan plan;
+    bool found = planner.FindPlan(heldIds, options.craftPlanTarget, plan);
+    double ms = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+    if (!found) {
+        std::printf("%s cannot be made from the %zu base items (%.3f ms)\n", target->displayName().c_str(), heldIds.size(), ms);
+        return 1;
+    }
+    std::printf("%s: %zu steps, depth %d (%zu items searched, %.3f ms)\n", target->displayName().c_str(),
+                plan.steps.size(), plan.depth, planner.GetSettledCount(), ms);
+    for (const CraftPlanner::Step& step : plan.steps) {
+        const Item* item1 = crafting.FindItemById(step.item1Id);
+        const Item* item2 = crafting.FindItemById(step.item2Id);
+        const Item* result = crafting.FindItemById(step.resultId);
+        std::printf("  %s + %s = %s\n", item1->displayName().c_str(), item2->displayName().c_str(), result->displayName().c_str());
+    }
+    // See CraftPlanner.hpp
+    std::printf("(inputs count as reusable, and the plan may be a step longer than the shortest one)\n");
+    return 0;
+}
 
 int main(int argc, char** argv)
 {
+    LaunchOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    if (options.craftPlanTarget >= 0) {
+        return RunCraftPlan(options);
+    }
+    if (options.headless) {
+        return RunHeadless(options);
+    }
+
     // Inicialização SDL e OpenGL
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
@@ -48,6 +219,12 @@ int main(int argc, char** argv)
     // Se o usuário escolher Iniciar Jogo
     if (menu.getSelection() == 0) {
         Game game(window, glContext);
+        game.SetSimulationRate(options.simulationRate);
+        game.SetWorkerCount(options.workers);
+        game.SetHotReload(options.hotReload);
+        if (options.recipeGenerator) {
+            game.SetRecipeGeneratorCommand(options.recipeGenerator);
+        }
         bool success = game.Initialize();
         if (success) {
             game.RunLoop();
@@ -0,0 +1,34 @@
+// ----------------------------------------------------------------
+// Item database compiler: items.json + recipes.json -> binary database
+// that the game maps at startup instead of parsing the JSON
+// ----------------------------------------------------------------
+
+#include "Crafting/Crafting.hpp"
+#include <cstdio>
+
+int main(int argc, char** argv)
+{
+    if (argc != 4)
+    {
+        std::fprintf(stderr, "Usage: %s <items.json> <recipes.json> <output.db>\n", argv[0]);
+        return 2;
+    }
+
+    const char* itemsPath = argv[1];
+    const char* recipesPath = argv[2];
+    const char* outputPath = argv[3];
+
+    Crafting crafting;
+    if (!crafting.LoadItemsFromJson(itemsPath) || !crafting.LoadRecipesFromJson(recipesPath))
+    {
+        return 1;
+    }
+
+    if (!crafting.WriteCompiled(outputPath, itemsPath, recipesPath))
+    {
+        return 1;
+    }
+
+    std::printf("%s: %zu items, %zu recipes\n", outputPath, crafting.GetAllItems().size(), crafting.GetRecipeCount());
+    return 0;
+}